@@ -0,0 +1,146 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbAnimInstance.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Main.h"
+
+FClimbAnimInstanceProxy::FClimbAnimInstanceProxy()
+{
+	InitDefaults();
+}
+
+FClimbAnimInstanceProxy::FClimbAnimInstanceProxy(UAnimInstance* InAnimInstance)
+	: FAnimInstanceProxy(InAnimInstance)
+{
+	InitDefaults();
+}
+
+void FClimbAnimInstanceProxy::InitDefaults()
+{
+	Pose = EClimbAnimPose::ECAP_Ground;
+	MovementStatus = EMovementStatus::EMS_Normal;
+	ClimbStatus = EClimbStatus::ECS_NormalClimb;
+	ClimbBlend = FVector2D(0.f, 0.f);
+	Speed = 0.f;
+	Direction = 0.f;
+	TurnLean = 0.f;
+	bIsWetSlipping = false;
+
+	Character = nullptr;
+	ClimbingComponent = nullptr;
+	Main = nullptr;
+
+	MoveInput = FVector2D(0.f, 0.f);
+	ClimbMoveInput = FVector2D(0.f, 0.f);
+	TurnValue = 0.f;
+	Velocity = FVector(0.f, 0.f, 0.f);
+	ActorRotation = FRotator(0.f, 0.f, 0.f);
+	bIsFalling = false;
+
+	ClimbBlendInterpSpeed = 8.f;
+	TurnLeanInterpSpeed = 4.f;
+}
+
+void FClimbAnimInstanceProxy::Initialize(UAnimInstance* InAnimInstance)
+{
+	FAnimInstanceProxy::Initialize(InAnimInstance);
+
+	Character = Cast<ACharacter>(InAnimInstance->TryGetPawnOwner());
+	ClimbingComponent = Character != nullptr ? Character->FindComponentByClass<UClimbingComponent>() : nullptr;
+	Main = Cast<AMain>(Character);
+
+	if (UClimbAnimInstance* ClimbAnimInstance = Cast<UClimbAnimInstance>(InAnimInstance))
+	{
+		ClimbBlendInterpSpeed = ClimbAnimInstance->ClimbBlendInterpSpeed;
+		TurnLeanInterpSpeed = ClimbAnimInstance->TurnLeanInterpSpeed;
+	}
+}
+
+void FClimbAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	FAnimInstanceProxy::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	// The only part on the game thread : copy, don't compute
+	if (Character == nullptr)
+	{
+		return;
+	}
+
+	Velocity = Character->GetVelocity();
+	ActorRotation = Character->GetActorRotation();
+	bIsFalling = Character->GetCharacterMovement()->IsFalling();
+
+	if (ClimbingComponent != nullptr)
+	{
+		MovementStatus = ClimbingComponent->GetMovementStatus();
+		ClimbStatus = ClimbingComponent->GetClimbStatus();
+		ClimbMoveInput = ClimbingComponent->ClimbMoveInput;
+		ClimbIKTargets = ClimbingComponent->ClimbIKTargets;
+		bIsWetSlipping = ClimbingComponent->IsWetSlipping();
+		MoveInput = ClimbingComponent->DesiredMoveDirection;
+	}
+
+	if (Main != nullptr)
+	{
+		MoveInput = FVector2D(Main->MoveForwardInputValue, Main->MoveRightInputValue);
+		TurnValue = Main->TurnValue;
+	}
+}
+
+void FClimbAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	FAnimInstanceProxy::Update(DeltaSeconds);
+
+	switch (MovementStatus)
+	{
+	case EMovementStatus::EMS_Climbing:
+		Pose = EClimbAnimPose::ECAP_Climbing;
+		break;
+	case EMovementStatus::EMS_Gliding:
+		Pose = EClimbAnimPose::ECAP_Gliding;
+		break;
+	case EMovementStatus::EMS_ClimbUp:
+	case EMovementStatus::EMS_ClimbDown:
+	case EMovementStatus::EMS_WallJumping:
+	case EMovementStatus::EMS_FrontFlip:
+		Pose = EClimbAnimPose::ECAP_Montage;
+		break;
+	default:
+		Pose = bIsFalling ? EClimbAnimPose::ECAP_Falling : EClimbAnimPose::ECAP_Ground;
+		break;
+	}
+
+	Speed = Velocity.Size();
+
+	Direction = 0.f;
+	if (Speed > KINDA_SMALL_NUMBER)
+	{
+		Direction = (Velocity.ToOrientationRotator() - ActorRotation).GetNormalized().Yaw;
+	}
+
+	// Bracing and the wall edges already zero the climbing input
+	const FVector2D TargetClimbBlend = Pose == EClimbAnimPose::ECAP_Climbing ? ClimbMoveInput : FVector2D(0.f, 0.f);
+	ClimbBlend.X = FMath::FInterpTo(ClimbBlend.X, TargetClimbBlend.X, DeltaSeconds, ClimbBlendInterpSpeed);
+	ClimbBlend.Y = FMath::FInterpTo(ClimbBlend.Y, TargetClimbBlend.Y, DeltaSeconds, ClimbBlendInterpSpeed);
+
+	// Only lean while the character turns with the camera
+	const bool bCanLean = (Pose == EClimbAnimPose::ECAP_Ground || Pose == EClimbAnimPose::ECAP_Gliding) && !MoveInput.IsNearlyZero();
+	TurnLean = FMath::FInterpTo(TurnLean, bCanLean ? TurnValue : 0.f, DeltaSeconds, TurnLeanInterpSpeed);
+}
+
+UClimbAnimInstance::UClimbAnimInstance()
+{
+	ClimbBlendInterpSpeed = 8.f;
+	TurnLeanInterpSpeed = 4.f;
+}
+
+FAnimInstanceProxy* UClimbAnimInstance::CreateAnimInstanceProxy()
+{
+	// The proxy lives in this instance so the anim graph can read its members
+	return &Proxy;
+}
+
+void UClimbAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy)
+{
+}
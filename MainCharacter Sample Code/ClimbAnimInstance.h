@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "ClimbingComponent.h"
+#include "ClimbAnimInstance.generated.h"
+
+/** Which blendspace (or montage) the anim graph plays */
+UENUM(BlueprintType)
+enum class EClimbAnimPose : uint8
+{
+	ECAP_Ground UMETA(DisplayName = "Ground"),
+	ECAP_Falling UMETA(DisplayName = "Falling"),
+	ECAP_Climbing UMETA(DisplayName = "Climbing"),
+	ECAP_Gliding UMETA(DisplayName = "Gliding"),
+	ECAP_Montage UMETA(DisplayName = "Montage"),
+	ECAP_MAX UMETA(DisplayName = "DefaultMax")
+};
+
+/**
+ * Copies the character's movement and climbing state once per frame in PreUpdate (game thread),
+ * the pose selection and blendspace inputs are then worked out in Update on an animation worker thread.
+ * The anim graph reads the results straight off the members, no Blueprint logic in the event graph.
+ */
+USTRUCT(BlueprintType)
+struct SECOND_API FClimbAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FClimbAnimInstanceProxy();
+	FClimbAnimInstanceProxy(UAnimInstance* InAnimInstance);
+
+	virtual void Initialize(UAnimInstance* InAnimInstance) override;
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+	virtual void Update(float DeltaSeconds) override;
+
+	/* Anim graph values */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Climb Anim")
+	EClimbAnimPose Pose;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Climb Anim")
+	EMovementStatus MovementStatus;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Climb Anim")
+	EClimbStatus ClimbStatus;
+
+	/** Climb blendspace axes, X up the wall and Y right, smoothed */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Climb Anim")
+	FVector2D ClimbBlend;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Climb Anim")
+	float Speed;
+
+	/** Velocity yaw relative to the actor (-180 to 180) */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Climb Anim")
+	float Direction;
+
+	/** Camera turn rate, smoothed, leans the ground and glide poses */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Climb Anim")
+	float TurnLean;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Climb Anim")
+	FClimbIKTargets ClimbIKTargets;
+
+	/** Sliding down a wet wall */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Climb Anim")
+	bool bIsWetSlipping;
+
+private:
+	UPROPERTY(Transient)
+	class ACharacter* Character;
+
+	UPROPERTY(Transient)
+	class UClimbingComponent* ClimbingComponent;
+
+	/** Null for characters other than AMain, the input then comes from the desired move direction */
+	UPROPERTY(Transient)
+	class AMain* Main;
+
+	/* Game thread snapshot */
+	FVector2D MoveInput;
+	FVector2D ClimbMoveInput;
+	float TurnValue;
+	FVector Velocity;
+	FRotator ActorRotation;
+	bool bIsFalling;
+
+	float ClimbBlendInterpSpeed;
+	float TurnLeanInterpSpeed;
+
+	/** Member defaults of both constructors, they differ only in the base constructor */
+	void InitDefaults();
+};
+
+/**
+ * Native base for the climbing and gliding anim blueprint. Reparent the blueprint to this class
+ * and read the Proxy members, the update then runs on the worker threads.
+ */
+UCLASS(Transient, Blueprintable)
+class SECOND_API UClimbAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+public:
+	UClimbAnimInstance();
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Climb Anim")
+	float ClimbBlendInterpSpeed;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Climb Anim")
+	float TurnLeanInterpSpeed;
+
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
+
+private:
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Climb Anim", meta = (AllowPrivateAccess = "true"))
+	FClimbAnimInstanceProxy Proxy;
+
+	friend struct FClimbAnimInstanceProxy;
+};
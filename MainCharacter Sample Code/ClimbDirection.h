@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Octant of the climbing input (Up = MoveForward, Right = MoveRight) */
+enum class EClimbDirection : uint8
+{
+	U,
+	UR,
+	R,
+	DR,
+	D,
+	DL,
+	L,
+	UL
+};
+
+namespace ClimbDirection
+{
+	/** tan(67.5 deg). |Forward| >= this * |Right| is a vertical octant, |Right| > this * |Forward| a horizontal one */
+	constexpr float SectorTangent = 2.41421356f;
+
+	/** Indexed by Zone * 4 + (Forward < 0) * 2 + (Right < 0). Zone 0 : vertical, 1 : diagonal, 2 : horizontal */
+	constexpr EClimbDirection SectorTable[12] =
+	{
+		EClimbDirection::U,  EClimbDirection::U,  EClimbDirection::D,  EClimbDirection::D,
+		EClimbDirection::UR, EClimbDirection::UL, EClimbDirection::DR, EClimbDirection::DL,
+		EClimbDirection::R,  EClimbDirection::L,  EClimbDirection::R,  EClimbDirection::L
+	};
+
+	/** Branch-free octant classification of the raw input. No input counts as U */
+	FORCEINLINE EClimbDirection Classify(float Forward, float Right)
+	{
+		const float AbsForward = FMath::Abs(Forward);
+		const float AbsRight = FMath::Abs(Right);
+		const int32 bVertical = AbsForward >= SectorTangent * AbsRight;
+		const int32 bHorizontal = AbsRight > SectorTangent * AbsForward;
+		const int32 Zone = (1 - bVertical) * (1 + bHorizontal);
+
+		return SectorTable[Zone * 4 + (int32)(Forward < 0.f) * 2 + (int32)(Right < 0.f)];
+	}
+
+	FORCEINLINE bool IsRight(EClimbDirection Direction)
+	{
+		return Direction == EClimbDirection::R || Direction == EClimbDirection::UR || Direction == EClimbDirection::DR;
+	}
+
+	FORCEINLINE bool IsLeft(EClimbDirection Direction)
+	{
+		return Direction == EClimbDirection::L || Direction == EClimbDirection::UL || Direction == EClimbDirection::DL;
+	}
+
+	/** cos(45 deg) and cos(30 deg), used instead of acos of the dot product */
+	constexpr float CosFortyFive = 0.70710678f;
+	constexpr float CosThirty = 0.86602540f;
+
+	/** Angle between A and B <= acos(CosThreshold), without normalizing either vector */
+	FORCEINLINE bool IsWithinCone(const FVector& A, const FVector& B, float CosThreshold)
+	{
+		const float Dot = FVector::DotProduct(A, B);
+		return Dot > 0.f && Dot * Dot >= CosThreshold * CosThreshold * A.SizeSquared() * B.SizeSquared();
+	}
+}
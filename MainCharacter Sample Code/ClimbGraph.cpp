@@ -0,0 +1,213 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbGraph.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+const uint32 FClimbGraph::Magic = 0x434C4752; // 'CLGR'
+const uint32 FClimbGraph::Version = 2;
+
+FArchive& operator<<(FArchive& Ar, FClimbGraphNode& Node)
+{
+	uint8 Type = (uint8)Node.Type;
+	Ar << Node.Location;
+	Ar << Node.FacingYaw;
+	Ar << Type;
+	Ar << Node.Flags;
+	Node.Type = (EClimbGraphNodeType)Type;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FClimbGraphEdge& Edge)
+{
+	uint8 Type = (uint8)Edge.Type;
+	Ar << Edge.TargetNode;
+	Ar << Edge.StaminaCost;
+	Ar << Edge.Length;
+	Ar << Type;
+	Edge.Type = (EClimbGraphEdgeType)Type;
+	return Ar;
+}
+
+FClimbGraph::FClimbGraph()
+{
+	CellSize = 200.f;
+}
+
+int32 FClimbGraph::FindNearestNode(const FVector& Location, float MaxDistance) const
+{
+	const FIntVector Min = GetCellCoord(Location - FVector(MaxDistance));
+	const FIntVector Max = GetCellCoord(Location + FVector(MaxDistance));
+
+	int32 NearestNode = INDEX_NONE;
+	float NearestDistSquared = FMath::Square(MaxDistance);
+
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				const TArray<int32>* CellNodes = Cells.Find(FIntVector(X, Y, Z));
+				if (!CellNodes)
+				{
+					continue;
+				}
+
+				for (int32 NodeIndex : *CellNodes)
+				{
+					const float DistSquared = FVector::DistSquared(Nodes[NodeIndex].Location, Location);
+					if (DistSquared < NearestDistSquared)
+					{
+						NearestDistSquared = DistSquared;
+						NearestNode = NodeIndex;
+					}
+				}
+			}
+		}
+	}
+
+	return NearestNode;
+}
+
+void FClimbGraph::FindNodesInBox(const FBox& Box, EClimbGraphNodeType Type, TArray<int32>& OutNodes) const
+{
+	const FIntVector Min = GetCellCoord(Box.Min);
+	const FIntVector Max = GetCellCoord(Box.Max);
+
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				const TArray<int32>* CellNodes = Cells.Find(FIntVector(X, Y, Z));
+				if (!CellNodes)
+				{
+					continue;
+				}
+
+				for (int32 NodeIndex : *CellNodes)
+				{
+					if (Nodes[NodeIndex].Type == Type && Box.IsInsideOrOn(Nodes[NodeIndex].Location))
+					{
+						OutNodes.Add(NodeIndex);
+					}
+				}
+			}
+		}
+	}
+}
+
+void FClimbGraph::BuildLookups()
+{
+	Cells.Reset();
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		Cells.FindOrAdd(GetCellCoord(Nodes[NodeIndex].Location)).Add(NodeIndex);
+	}
+
+	// Count the incoming edges first, then fill each node's range
+	ReverseEdgeOffsets.Reset();
+	ReverseEdgeOffsets.SetNumZeroed(Nodes.Num() + 1);
+	for (const FClimbGraphEdge& Edge : Edges)
+	{
+		++ReverseEdgeOffsets[Edge.TargetNode + 1];
+	}
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		ReverseEdgeOffsets[NodeIndex + 1] += ReverseEdgeOffsets[NodeIndex];
+	}
+
+	TArray<int32> FillOffsets = ReverseEdgeOffsets;
+	ReverseEdges.SetNumUninitialized(Edges.Num());
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		for (int32 EdgeIndex = GetFirstEdge(NodeIndex); EdgeIndex < GetLastEdge(NodeIndex); ++EdgeIndex)
+		{
+			FClimbGraphEdge ReverseEdge = Edges[EdgeIndex];
+			ReverseEdge.TargetNode = NodeIndex;
+			ReverseEdges[FillOffsets[Edges[EdgeIndex].TargetNode]++] = ReverseEdge;
+		}
+	}
+}
+
+void FClimbGraph::Reset()
+{
+	Nodes.Reset();
+	EdgeOffsets.Reset();
+	Edges.Reset();
+	ReverseEdgeOffsets.Reset();
+	ReverseEdges.Reset();
+	Cells.Reset();
+}
+
+void FClimbGraph::Serialize(FArchive& Ar)
+{
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	Ar << FileMagic;
+	Ar << FileVersion;
+	if (Ar.IsLoading() && (FileMagic != Magic || FileVersion != Version))
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Ar << CellSize;
+	Ar << Nodes;
+	Ar << EdgeOffsets;
+	Ar << Edges;
+
+	if (Ar.IsLoading() && EdgeOffsets.Num() != Nodes.Num() + 1)
+	{
+		Ar.SetError();
+	}
+}
+
+bool FClimbGraph::SaveToFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Serialize(Writer);
+
+	return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FClimbGraph::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	Serialize(Reader);
+	if (Reader.IsError())
+	{
+		Reset();
+		return false;
+	}
+
+	BuildLookups();
+	return true;
+}
+
+FString FClimbGraph::GetGraphFilePath(const UWorld* World)
+{
+	const FString MapName = UWorld::RemovePIEPrefix(FPackageName::GetShortName(World->GetOutermost()->GetName()));
+	return FPaths::ProjectContentDir() / TEXT("ClimbGraph") / MapName + TEXT(".climbgraph");
+}
+
+FIntVector FClimbGraph::GetCellCoord(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize));
+}
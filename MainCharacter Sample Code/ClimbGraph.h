@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EClimbGraphNodeType : uint8
+{
+	Wall,		// climbable wall patch, a character holding on to it faces the wall
+	Ledge,		// standing point on top of a wall, reached by climbing up
+	MAX
+};
+
+enum class EClimbGraphEdgeType : uint8
+{
+	Climb,		// along the same wall
+	TurnCorner,
+	ClimbUp,
+	ClimbDown,	// grab the wall from the top of the ledge
+	Walk,
+	ClimbDash,
+	WallJump,	// off the wall to the wall behind
+	Glide,		// from a ledge down to a lower node
+	MAX
+};
+
+/** Set on wall patches with ground below, where a climb can be started on foot */
+static const uint8 ClimbGraphNodeFlag_Ground = 1 << 0;
+
+struct FClimbGraphNode
+{
+	/** Character location while holding on to the wall, or standing on the ledge */
+	FVector Location;
+
+	/** Yaw the character faces, quantized to 65536 steps */
+	uint16 FacingYaw;
+
+	EClimbGraphNodeType Type;
+	uint8 Flags;
+
+	FORCEINLINE FVector GetFacingVector() const { return FRotator(0.f, FRotator::DecompressAxisFromShort(FacingYaw), 0.f).Vector(); }
+
+	/** Stamina recovers here, standing on a ledge or stepping down to the ground */
+	FORCEINLINE bool IsRestNode() const { return Type == EClimbGraphNodeType::Ledge || (Flags & ClimbGraphNodeFlag_Ground) != 0; }
+
+	friend FArchive& operator<<(FArchive& Ar, FClimbGraphNode& Node);
+};
+
+struct FClimbGraphEdge
+{
+	int32 TargetNode;
+
+	/** Stamina the transition drains, from the UClimbingComponent *StaminaConsumption values */
+	float StaminaCost;
+	float Length;
+	EClimbGraphEdgeType Type;
+
+	friend FArchive& operator<<(FArchive& Ar, FClimbGraphEdge& Edge);
+};
+
+/**
+ * Climbable routes of a level, generated offline by FClimbGraphBuilder and read only at runtime.
+ * Edges are stored per node in one array (EdgeOffsets[Node] to EdgeOffsets[Node + 1]) so a query
+ * only walks flat arrays, and one graph can be shared by planners on any thread once loaded.
+ */
+class SECOND_API FClimbGraph
+{
+public:
+	FClimbGraph();
+
+	static const uint32 Magic;
+	static const uint32 Version;
+
+	TArray<FClimbGraphNode> Nodes;
+	TArray<int32> EdgeOffsets;
+	TArray<FClimbGraphEdge> Edges;
+
+	/** Incoming edges per node, TargetNode is the source node. Built after loading, not saved */
+	TArray<int32> ReverseEdgeOffsets;
+	TArray<FClimbGraphEdge> ReverseEdges;
+
+	/** Width of a node lookup cell (cm) */
+	float CellSize;
+
+	FORCEINLINE int32 GetNumNodes() const { return Nodes.Num(); }
+	FORCEINLINE int32 GetFirstEdge(int32 NodeIndex) const { return EdgeOffsets[NodeIndex]; }
+	FORCEINLINE int32 GetLastEdge(int32 NodeIndex) const { return EdgeOffsets[NodeIndex + 1]; }
+	FORCEINLINE int32 GetFirstReverseEdge(int32 NodeIndex) const { return ReverseEdgeOffsets[NodeIndex]; }
+	FORCEINLINE int32 GetLastReverseEdge(int32 NodeIndex) const { return ReverseEdgeOffsets[NodeIndex + 1]; }
+
+	/** INDEX_NONE when no node is within MaxDistance */
+	int32 FindNearestNode(const FVector& Location, float MaxDistance) const;
+
+	void FindNodesInBox(const FBox& Box, EClimbGraphNodeType Type, TArray<int32>& OutNodes) const;
+
+	/** Rebuilds the node lookup cells and the reverse edges, done after loading or building */
+	void BuildLookups();
+
+	void Reset();
+	void Serialize(FArchive& Ar);
+	bool SaveToFile(const FString& FilePath);
+	bool LoadFromFile(const FString& FilePath);
+
+	/** Content/ClimbGraph/<Map>.climbgraph, add the directory to the packaged non-asset directories */
+	static FString GetGraphFilePath(const class UWorld* World);
+
+private:
+	FIntVector GetCellCoord(const FVector& Location) const;
+
+	TMap<FIntVector, TArray<int32>> Cells;
+};
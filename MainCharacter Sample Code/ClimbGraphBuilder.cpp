@@ -0,0 +1,491 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbGraphBuilder.h"
+#include "ClimbingComponent.h"
+#include "MainMovementComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+
+FClimbGraphBuildSettings::FClimbGraphBuildSettings()
+{
+	SampleSpacing = 50.f;
+	WallDistance = 40.f;
+	CapsuleHalfHeight = 90.f;
+	MaxStepHeight = 45.f;
+	ClimbSpeed = 600.f;
+	TurnCornerTime = 1.f;
+	ClimbingStaminaConsumption = 5.f;
+	ClimbDashDistance = 150.f;
+	ClimbDashStaminaConsumption = 15.f;
+	WallJumpDistance = 300.f;
+	WallJumpStaminaConsumption = 20.f;
+	GlideSpeed = 500.f;
+	GlideSinkRate = 200.f;
+	MinGlideDrop = 300.f;
+	MaxGlideDistance = 3000.f;
+	MaxGlideEdges = 8;
+	GlidingStaminaConsumption = 5.f;
+}
+
+void FClimbGraphBuildSettings::InitFromClimber(TSubclassOf<ACharacter> ClimberClass)
+{
+	const ACharacter* Climber = ClimberClass ? ClimberClass->GetDefaultObject<ACharacter>() : nullptr;
+	const UClimbingComponent* Climbing = Climber ? Climber->FindComponentByClass<UClimbingComponent>() : nullptr;
+	if (!Climbing)
+	{
+		Climbing = GetDefault<UClimbingComponent>();
+	}
+
+	ClimbingStaminaConsumption = Climbing->ClimbingStaminaConsumption;
+	ClimbDashStaminaConsumption = Climbing->ClimbDashStaminaConsumption;
+	WallJumpStaminaConsumption = Climbing->WallJumpStaminaConsumption;
+	GlidingStaminaConsumption = Climbing->GlidingStaminaConsumption;
+
+	if (Climber)
+	{
+		ClimbSpeed = Climber->GetCharacterMovement()->MaxFlySpeed;
+		CapsuleHalfHeight = Climber->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight();
+		MaxStepHeight = Climber->GetCharacterMovement()->MaxStepHeight;
+
+		if (const UMainMovementComponent* MainMovement = Cast<UMainMovementComponent>(Climber->GetCharacterMovement()))
+		{
+			GlideSinkRate = MainMovement->GlideFlightModel.TerminalSinkRate;
+		}
+	}
+}
+
+FClimbGraphBuilder::FClimbGraphBuilder(UWorld* InWorld, const FClimbGraphBuildSettings& InSettings)
+	: World(InWorld)
+	, Settings(InSettings)
+{
+	CoarseCellSize = 1000.f;
+}
+
+void FClimbGraphBuilder::Build(const TArray<FBox>& BoundsList, FClimbGraph& OutGraph)
+{
+	Nodes.Reset();
+	NodeEdges.Reset();
+	WallLedges.Reset();
+	Cells.Reset();
+	CoarseCells.Reset();
+
+	for (const FBox& Bounds : BoundsList)
+	{
+		SampleWalls(Bounds, FVector(1.f, 0.f, 0.f));
+		SampleWalls(Bounds, FVector(-1.f, 0.f, 0.f));
+		SampleWalls(Bounds, FVector(0.f, 1.f, 0.f));
+		SampleWalls(Bounds, FVector(0.f, -1.f, 0.f));
+	}
+
+	LinkNodes();
+
+	// Flatten the edges, each node's edges follow the previous node's
+	OutGraph.Reset();
+	OutGraph.Nodes = Nodes;
+	OutGraph.EdgeOffsets.Reserve(Nodes.Num() + 1);
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		OutGraph.EdgeOffsets.Add(OutGraph.Edges.Num());
+		OutGraph.Edges.Append(NodeEdges[NodeIndex]);
+	}
+	OutGraph.EdgeOffsets.Add(OutGraph.Edges.Num());
+	OutGraph.BuildLookups();
+}
+
+void FClimbGraphBuilder::SampleWalls(const FBox& Bounds, const FVector& Direction)
+{
+	// Rows run along Direction across the box, one per SampleSpacing on the other horizontal axis and Z
+	const FVector Side = FVector::CrossProduct(FVector::UpVector, Direction);
+	const FVector Extent = Bounds.GetExtent();
+	const float RowLength = FMath::Abs(FVector::DotProduct(Extent, Direction)) * 2.f;
+	const float SideExtent = FMath::Abs(FVector::DotProduct(Extent, Side));
+	const FVector RowStartCenter = Bounds.GetCenter() - Direction * (RowLength * 0.5f);
+
+	for (float SideOffset = -SideExtent; SideOffset <= SideExtent; SideOffset += Settings.SampleSpacing)
+	{
+		for (float Z = Bounds.Min.Z; Z <= Bounds.Max.Z; Z += Settings.SampleSpacing)
+		{
+			FVector Start = RowStartCenter + Side * SideOffset;
+			Start.Z = Z;
+			const FVector End = Start + Direction * RowLength;
+
+			// Every surface along the row, continuing past each hit
+			FHitResult OutHit{};
+			while (Trace(Start, End, OutHit))
+			{
+				if (!OutHit.bStartPenetrating && FVector::DotProduct(OutHit.Normal, Direction) < -0.7f)
+				{
+					AddWallCandidate(OutHit.ImpactPoint, OutHit.Normal);
+				}
+
+				Start = OutHit.ImpactPoint + Direction * Settings.SampleSpacing;
+				if (FVector::DotProduct(End - Start, Direction) <= 0.f)
+				{
+					break;
+				}
+			}
+		}
+	}
+}
+
+void FClimbGraphBuilder::AddWallCandidate(const FVector& WallPoint, const FVector& WallNormal)
+{
+	const FVector HorizontalNormal = FVector(WallNormal.X, WallNormal.Y, 0.f).GetSafeNormal();
+	const FVector Location = WallPoint + HorizontalNormal * Settings.WallDistance;
+	const FVector Up = FVector::UpVector;
+	const FVector Forward = -HorizontalNormal;
+	const FVector Right = FVector::CrossProduct(Up, Forward);
+
+	// ClimbStartEnoughSpaceConditionForGround, same traces as the SetIs* probes
+	FHitResult OutHit{};
+	const bool bIsBodyWallFacing = Trace(Location, Location + Forward * 70.f, OutHit);
+	const bool bIsRightEdge = !Trace(Location + Up * 60.f + Right * 50.f, Location + Up * 60.f + Right * 50.f + Forward * 100.f);
+	const bool bIsLeftEdge = !Trace(Location + Up * 60.f - Right * 50.f, Location + Up * 60.f - Right * 50.f + Forward * 100.f);
+	const bool bIsFoothold = Trace(Location - Up * 80.f, Location - Up * 80.f + Forward * 70.f);
+
+	if (!bIsBodyWallFacing || bIsRightEdge || bIsLeftEdge || !bIsFoothold)
+	{
+		return;
+	}
+
+	// StartClimb turns the character to the wall normal the body trace hit
+	const FVector Facing = -FVector(OutHit.Normal.X, OutHit.Normal.Y, 0.f).GetSafeNormal();
+	const bool bIsGround = Trace(Location, Location - Up * 100.f);
+	const int32 WallNode = AddNode(Location, Facing, EClimbGraphNodeType::Wall, bIsGround ? ClimbGraphNodeFlag_Ground : 0);
+
+	// ClimbUpCondition, then where the climb up ends
+	const bool bIsTopEdge = !Trace(Location + Up * 90.f, Location + Up * 90.f + Forward * 70.f);
+	const bool bClimbUpEnoughSpace = !Trace(Location + Up * 96.f, Location + Up * 96.f + Forward * 70.f)
+		&& !Trace(Location + Up * 300.f, Location + Up * 300.f + Forward * 70.f);
+
+	if (bIsTopEdge && bClimbUpEnoughSpace && WallLedges[WallNode] == INDEX_NONE)
+	{
+		const FVector LedgeStart = Location + Forward * 70.f + Up * 200.f;
+		if (Trace(LedgeStart, LedgeStart - Up * 200.f, OutHit) && OutHit.ImpactNormal.Z >= 0.7f)
+		{
+			WallLedges[WallNode] = AddNode(OutHit.ImpactPoint + Up * Settings.CapsuleHalfHeight, Facing, EClimbGraphNodeType::Ledge, 0);
+		}
+	}
+}
+
+int32 FClimbGraphBuilder::AddNode(const FVector& Location, const FVector& Facing, EClimbGraphNodeType Type, uint8 Flags)
+{
+	// Rows close to each other find the same patch, keep the first one
+	const float MergeDistSquared = FMath::Square(Settings.SampleSpacing * 0.5f);
+	const FIntVector CellCoord = GetCellCoord(Location);
+	for (int32 X = CellCoord.X - 1; X <= CellCoord.X + 1; ++X)
+	{
+		for (int32 Y = CellCoord.Y - 1; Y <= CellCoord.Y + 1; ++Y)
+		{
+			for (int32 Z = CellCoord.Z - 1; Z <= CellCoord.Z + 1; ++Z)
+			{
+				if (const TArray<int32>* CellNodes = Cells.Find(FIntVector(X, Y, Z)))
+				{
+					for (int32 NodeIndex : *CellNodes)
+					{
+						const FClimbGraphNode& Node = Nodes[NodeIndex];
+						if (Node.Type == Type && FVector::DistSquared(Node.Location, Location) < MergeDistSquared &&
+							(Type == EClimbGraphNodeType::Ledge || FVector::DotProduct(Node.GetFacingVector(), Facing) > 0.9f))
+						{
+							Nodes[NodeIndex].Flags |= Flags;
+							return NodeIndex;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	FClimbGraphNode Node;
+	Node.Location = Location;
+	Node.FacingYaw = FRotator::CompressAxisToShort(Facing.Rotation().Yaw);
+	Node.Type = Type;
+	Node.Flags = Flags;
+
+	const int32 NodeIndex = Nodes.Add(Node);
+	NodeEdges.AddDefaulted();
+	WallLedges.Add(INDEX_NONE);
+	Cells.FindOrAdd(CellCoord).Add(NodeIndex);
+	CoarseCells.FindOrAdd(GetCoarseCellCoord(Location)).Add(NodeIndex);
+	return NodeIndex;
+}
+
+void FClimbGraphBuilder::LinkNodes()
+{
+	const float ClimbStaminaPerCm = Settings.ClimbingStaminaConsumption / Settings.ClimbSpeed;
+	const float NeighbourDistSquared = FMath::Square(Settings.SampleSpacing * 1.5f);
+
+	// Turning around a corner moves the character around the wall distance as well
+	const float CornerDistSquared = FMath::Square(Settings.SampleSpacing * 1.5f + Settings.WallDistance * 2.f);
+	const int32 CellRange = FMath::CeilToInt(FMath::Sqrt(CornerDistSquared) / Settings.SampleSpacing);
+
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		const FClimbGraphNode& Node = Nodes[NodeIndex];
+		const FVector Facing = Node.GetFacingVector();
+
+		if (WallLedges[NodeIndex] != INDEX_NONE)
+		{
+			AddEdge(NodeIndex, WallLedges[NodeIndex], EClimbGraphEdgeType::ClimbUp, 0.f);
+			AddEdge(WallLedges[NodeIndex], NodeIndex, EClimbGraphEdgeType::ClimbDown, 0.f);
+		}
+
+		if (Node.Type == EClimbGraphNodeType::Wall)
+		{
+			LinkClimbDashes(NodeIndex);
+			LinkWallJump(NodeIndex);
+		}
+		else
+		{
+			LinkGlides(NodeIndex);
+		}
+
+		const FIntVector CellCoord = GetCellCoord(Node.Location);
+		for (int32 X = CellCoord.X - CellRange; X <= CellCoord.X + CellRange; ++X)
+		{
+			for (int32 Y = CellCoord.Y - CellRange; Y <= CellCoord.Y + CellRange; ++Y)
+			{
+				for (int32 Z = CellCoord.Z - CellRange; Z <= CellCoord.Z + CellRange; ++Z)
+				{
+					const TArray<int32>* CellNodes = Cells.Find(FIntVector(X, Y, Z));
+					if (!CellNodes)
+					{
+						continue;
+					}
+
+					for (int32 OtherIndex : *CellNodes)
+					{
+						const FClimbGraphNode& Other = Nodes[OtherIndex];
+						if (OtherIndex == NodeIndex || Other.Type != Node.Type)
+						{
+							continue;
+						}
+
+						const FVector Delta = Other.Location - Node.Location;
+						const float DistSquared = Delta.SizeSquared();
+
+						if (Node.Type == EClimbGraphNodeType::Ledge)
+						{
+							if (DistSquared <= NeighbourDistSquared && FMath::Abs(Delta.Z) <= Settings.MaxStepHeight)
+							{
+								AddEdge(NodeIndex, OtherIndex, EClimbGraphEdgeType::Walk, 0.f);
+							}
+							continue;
+						}
+
+						const float FacingDot = FVector::DotProduct(Facing, Other.GetFacingVector());
+						if (FacingDot > 0.9f && DistSquared <= NeighbourDistSquared && FMath::Abs(FVector::DotProduct(Delta, Facing)) < Settings.SampleSpacing * 0.5f)
+						{
+							AddEdge(NodeIndex, OtherIndex, EClimbGraphEdgeType::Climb, FMath::Sqrt(DistSquared) * ClimbStaminaPerCm);
+						}
+						else if (FMath::Abs(FacingDot) < 0.3f && DistSquared <= CornerDistSquared && FMath::Abs(Delta.Z) < Settings.SampleSpacing * 0.5f)
+						{
+							AddEdge(NodeIndex, OtherIndex, EClimbGraphEdgeType::TurnCorner, Settings.TurnCornerTime * Settings.ClimbingStaminaConsumption);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+void FClimbGraphBuilder::LinkClimbDashes(int32 NodeIndex)
+{
+	const FClimbGraphNode& Node = Nodes[NodeIndex];
+	const FVector Facing = Node.GetFacingVector();
+	const FVector Right = FVector::CrossProduct(FVector::UpVector, Facing);
+
+	// One dash per EClimbDirection, landing on a patch of the same wall
+	for (int32 DirectionIndex = 0; DirectionIndex < 8; ++DirectionIndex)
+	{
+		const float Angle = DirectionIndex * PI * 0.25f;
+		const FVector Direction = FVector::UpVector * FMath::Cos(Angle) + Right * FMath::Sin(Angle);
+		const int32 TargetNode = FindWallNode(Node.Location + Direction * Settings.ClimbDashDistance, Facing, Settings.SampleSpacing * 0.75f);
+		if (TargetNode != INDEX_NONE && TargetNode != NodeIndex)
+		{
+			AddEdge(NodeIndex, TargetNode, EClimbGraphEdgeType::ClimbDash, Settings.ClimbDashStaminaConsumption);
+		}
+	}
+}
+
+void FClimbGraphBuilder::LinkWallJump(int32 NodeIndex)
+{
+	const FClimbGraphNode& Node = Nodes[NodeIndex];
+	const FVector Facing = Node.GetFacingVector();
+	const FIntVector CellCoord = GetCoarseCellCoord(Node.Location);
+	const int32 CellRange = FMath::CeilToInt(Settings.WallJumpDistance / CoarseCellSize);
+
+	// Nearest wall behind the character facing the other way, the jump doesn't gain height
+	int32 TargetNode = INDEX_NONE;
+	float TargetDistSquared = FMath::Square(Settings.WallJumpDistance);
+	for (int32 X = CellCoord.X - CellRange; X <= CellCoord.X + CellRange; ++X)
+	{
+		for (int32 Y = CellCoord.Y - CellRange; Y <= CellCoord.Y + CellRange; ++Y)
+		{
+			for (int32 Z = CellCoord.Z - CellRange; Z <= CellCoord.Z + CellRange; ++Z)
+			{
+				const TArray<int32>* CellNodes = CoarseCells.Find(FIntVector(X, Y, Z));
+				if (!CellNodes)
+				{
+					continue;
+				}
+
+				for (int32 OtherIndex : *CellNodes)
+				{
+					const FClimbGraphNode& Other = Nodes[OtherIndex];
+					const FVector Delta = Other.Location - Node.Location;
+					const float DistSquared = Delta.SizeSquared();
+					if (Other.Type == EClimbGraphNodeType::Wall && DistSquared < TargetDistSquared && Delta.Z <= Settings.SampleSpacing &&
+						FVector::DotProduct(Delta, Facing) < 0.f && FVector::DotProduct(Other.GetFacingVector(), Facing) < -0.9f)
+					{
+						TargetNode = OtherIndex;
+						TargetDistSquared = DistSquared;
+					}
+				}
+			}
+		}
+	}
+
+	if (TargetNode != INDEX_NONE && !Trace(Node.Location, Nodes[TargetNode].Location))
+	{
+		AddEdge(NodeIndex, TargetNode, EClimbGraphEdgeType::WallJump, Settings.WallJumpStaminaConsumption);
+	}
+}
+
+void FClimbGraphBuilder::LinkGlides(int32 NodeIndex)
+{
+	const FClimbGraphNode& Node = Nodes[NodeIndex];
+	const FIntVector CellCoord = GetCoarseCellCoord(Node.Location);
+	const int32 CellRange = FMath::CeilToInt(Settings.MaxGlideDistance / CoarseCellSize);
+	const float GlideRatio = Settings.GlideSpeed / Settings.GlideSinkRate;
+
+	struct FGlideTarget
+	{
+		int32 NodeIndex;
+		float StaminaCost;
+
+		FORCEINLINE bool operator<(const FGlideTarget& Other) const { return StaminaCost < Other.StaminaCost; }
+	};
+	TArray<FGlideTarget> Targets;
+
+	for (int32 X = CellCoord.X - CellRange; X <= CellCoord.X + CellRange; ++X)
+	{
+		for (int32 Y = CellCoord.Y - CellRange; Y <= CellCoord.Y + CellRange; ++Y)
+		{
+			// Only lower cells
+			for (int32 Z = CellCoord.Z - CellRange; Z <= CellCoord.Z; ++Z)
+			{
+				const TArray<int32>* CellNodes = CoarseCells.Find(FIntVector(X, Y, Z));
+				if (!CellNodes)
+				{
+					continue;
+				}
+
+				for (int32 OtherIndex : *CellNodes)
+				{
+					const FVector Delta = Nodes[OtherIndex].Location - Node.Location;
+					const float Drop = -Delta.Z;
+					const float HorizontalDist = FVector(Delta.X, Delta.Y, 0.f).Size();
+					if (Drop >= Settings.MinGlideDrop && HorizontalDist <= Drop * GlideRatio && HorizontalDist <= Settings.MaxGlideDistance)
+					{
+						// Drains while sinking the whole drop
+						Targets.Add({ OtherIndex, Settings.GlidingStaminaConsumption * Drop / Settings.GlideSinkRate });
+					}
+				}
+			}
+		}
+	}
+
+	Targets.Sort();
+
+	int32 NumGlideEdges = 0;
+	for (const FGlideTarget& Target : Targets)
+	{
+		if (NumGlideEdges >= Settings.MaxGlideEdges)
+		{
+			break;
+		}
+
+		// Clear flight from above the ledge
+		if (!Trace(Node.Location + FVector::UpVector * Settings.CapsuleHalfHeight, Nodes[Target.NodeIndex].Location))
+		{
+			AddEdge(NodeIndex, Target.NodeIndex, EClimbGraphEdgeType::Glide, Target.StaminaCost);
+			++NumGlideEdges;
+		}
+	}
+}
+
+int32 FClimbGraphBuilder::FindWallNode(const FVector& Location, const FVector& Facing, float MaxDistance) const
+{
+	int32 NearestNode = INDEX_NONE;
+	float NearestDistSquared = FMath::Square(MaxDistance);
+
+	const FIntVector CellCoord = GetCellCoord(Location);
+	for (int32 X = CellCoord.X - 1; X <= CellCoord.X + 1; ++X)
+	{
+		for (int32 Y = CellCoord.Y - 1; Y <= CellCoord.Y + 1; ++Y)
+		{
+			for (int32 Z = CellCoord.Z - 1; Z <= CellCoord.Z + 1; ++Z)
+			{
+				const TArray<int32>* CellNodes = Cells.Find(FIntVector(X, Y, Z));
+				if (!CellNodes)
+				{
+					continue;
+				}
+
+				for (int32 NodeIndex : *CellNodes)
+				{
+					const FClimbGraphNode& Node = Nodes[NodeIndex];
+					const float DistSquared = FVector::DistSquared(Node.Location, Location);
+					if (Node.Type == EClimbGraphNodeType::Wall && DistSquared < NearestDistSquared && FVector::DotProduct(Node.GetFacingVector(), Facing) > 0.9f)
+					{
+						NearestNode = NodeIndex;
+						NearestDistSquared = DistSquared;
+					}
+				}
+			}
+		}
+	}
+
+	return NearestNode;
+}
+
+void FClimbGraphBuilder::AddEdge(int32 FromNode, int32 ToNode, EClimbGraphEdgeType Type, float StaminaCost)
+{
+	FClimbGraphEdge Edge;
+	Edge.TargetNode = ToNode;
+	Edge.StaminaCost = StaminaCost;
+	Edge.Length = FVector::Dist(Nodes[FromNode].Location, Nodes[ToNode].Location);
+	Edge.Type = Type;
+	NodeEdges[FromNode].Add(Edge);
+}
+
+bool FClimbGraphBuilder::Trace(const FVector& Start, const FVector& End, FHitResult& OutHit) const
+{
+	FCollisionQueryParams CollisionParams;
+	return World->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
+}
+
+bool FClimbGraphBuilder::Trace(const FVector& Start, const FVector& End) const
+{
+	FHitResult OutHit{};
+	return Trace(Start, End, OutHit);
+}
+
+FIntVector FClimbGraphBuilder::GetCellCoord(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / Settings.SampleSpacing),
+		FMath::FloorToInt(Location.Y / Settings.SampleSpacing),
+		FMath::FloorToInt(Location.Z / Settings.SampleSpacing));
+}
+
+FIntVector FClimbGraphBuilder::GetCoarseCellCoord(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CoarseCellSize),
+		FMath::FloorToInt(Location.Y / CoarseCellSize),
+		FMath::FloorToInt(Location.Z / CoarseCellSize));
+}
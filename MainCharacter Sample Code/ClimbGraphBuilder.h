@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SubclassOf.h"
+#include "ClimbGraph.h"
+
+struct SECOND_API FClimbGraphBuildSettings
+{
+	FClimbGraphBuildSettings();
+
+	/** Distance between sample rows, and between neighbouring nodes on a wall (cm) */
+	float SampleSpacing;
+
+	/** Distance from the wall a climbing character is kept at */
+	float WallDistance;
+	float CapsuleHalfHeight;
+	float MaxStepHeight;
+
+	/** Speed along the wall, the movement component's MaxFlySpeed */
+	float ClimbSpeed;
+	float TurnCornerTime;
+	float ClimbingStaminaConsumption;
+
+	/** Distance one climb dash covers */
+	float ClimbDashDistance;
+	float ClimbDashStaminaConsumption;
+
+	/** Farthest wall behind the character a wall jump reaches */
+	float WallJumpDistance;
+	float WallJumpStaminaConsumption;
+
+	/** Horizontal speed and sink rate while gliding, they give the distance a glide covers per cm of drop */
+	float GlideSpeed;
+	float GlideSinkRate;
+	float MinGlideDrop;
+	float MaxGlideDistance;
+	int32 MaxGlideEdges;
+	float GlidingStaminaConsumption;
+
+	/** Takes the climbing values from the default object of a character class with a UClimbingComponent */
+	void InitFromClimber(TSubclassOf<class ACharacter> ClimberClass);
+};
+
+/**
+ * Samples level collision offline with the probes UClimbingComponent runs every frame.
+ * Horizontal rows of traces find wall surfaces, then a character placed against each hit is tested
+ * with the ClimbStartEnoughSpaceConditionForGround rules to make a wall patch, and with the
+ * ClimbUpCondition rules to add the ledge on top. Neighbouring patches are linked along the wall
+ * and around corners, with the stamina each transition drains. Climb dashes, wall jumps to the wall
+ * behind and glides down from ledges are added as edges with their own stamina cost.
+ */
+class SECOND_API FClimbGraphBuilder
+{
+public:
+	FClimbGraphBuilder(class UWorld* InWorld, const FClimbGraphBuildSettings& InSettings);
+
+	void Build(const TArray<FBox>& BoundsList, FClimbGraph& OutGraph);
+
+private:
+	void SampleWalls(const FBox& Bounds, const FVector& Direction);
+	void AddWallCandidate(const FVector& WallPoint, const FVector& WallNormal);
+	int32 AddNode(const FVector& Location, const FVector& Facing, EClimbGraphNodeType Type, uint8 Flags);
+	void LinkNodes();
+	void LinkClimbDashes(int32 NodeIndex);
+	void LinkWallJump(int32 NodeIndex);
+	void LinkGlides(int32 NodeIndex);
+	int32 FindWallNode(const FVector& Location, const FVector& Facing, float MaxDistance) const;
+	void AddEdge(int32 FromNode, int32 ToNode, EClimbGraphEdgeType Type, float StaminaCost);
+
+	bool Trace(const FVector& Start, const FVector& End, FHitResult& OutHit) const;
+	bool Trace(const FVector& Start, const FVector& End) const;
+
+	FIntVector GetCellCoord(const FVector& Location) const;
+	FIntVector GetCoarseCellCoord(const FVector& Location) const;
+
+	class UWorld* World;
+	FClimbGraphBuildSettings Settings;
+
+	TArray<FClimbGraphNode> Nodes;
+	TArray<TArray<FClimbGraphEdge>> NodeEdges;
+
+	/** Ledge reached by climbing up from a wall node, INDEX_NONE when it can't be climbed up */
+	TArray<int32> WallLedges;
+
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	/** Wider cells for the long wall jump and glide links */
+	TMap<FIntVector, TArray<int32>> CoarseCells;
+	float CoarseCellSize;
+};
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbGraphVolume.h"
+#include "ClimbGraphBuilder.h"
+#include "Components/BoxComponent.h"
+#include "GameFramework/Character.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+AClimbGraphVolume::AClimbGraphVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	GraphBox = CreateDefaultSubobject<UBoxComponent>(TEXT("GraphBox"));
+	GraphBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GraphBox->SetMobility(EComponentMobility::Static);
+	SetRootComponent(GraphBox);
+
+	SampleSpacing = 50.f;
+	TurnCornerTime = 1.f;
+	ClimbDashDistance = 150.f;
+	WallJumpDistance = 300.f;
+	GlideSpeed = 500.f;
+}
+
+void AClimbGraphVolume::BuildClimbGraph()
+{
+	UWorld* World = GetWorld();
+
+	FClimbGraphBuildSettings Settings;
+	Settings.InitFromClimber(ClimberClass);
+	Settings.SampleSpacing = SampleSpacing;
+	Settings.TurnCornerTime = TurnCornerTime;
+	Settings.ClimbDashDistance = ClimbDashDistance;
+	Settings.WallJumpDistance = WallJumpDistance;
+	Settings.GlideSpeed = GlideSpeed;
+
+	TArray<FBox> BoundsList;
+	for (TActorIterator<AClimbGraphVolume> It(World); It; ++It)
+	{
+		BoundsList.Add(It->GraphBox->Bounds.GetBox());
+	}
+
+	FClimbGraph Graph;
+	FClimbGraphBuilder Builder(World, Settings);
+	Builder.Build(BoundsList, Graph);
+
+	const FString FilePath = FClimbGraph::GetGraphFilePath(World);
+	if (Graph.SaveToFile(FilePath))
+	{
+		UE_LOG(LogTemp, Display, TEXT("Climb graph saved to %s : %d nodes, %d edges"), *FilePath, Graph.Nodes.Num(), Graph.Edges.Num());
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to save climb graph %s"), *FilePath);
+	}
+}
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ClimbGraphVolume.generated.h"
+
+/**
+ * Marks where the climb graph of the level is generated.
+ * Build Climb Graph samples the boxes of every volume in the level and saves the graph next to the content,
+ * UClimbNavigationSubsystem loads it when the level starts.
+ */
+UCLASS()
+class SECOND_API AClimbGraphVolume : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AClimbGraphVolume();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climb Graph")
+	class UBoxComponent* GraphBox;
+
+	/** Character whose climbing component and movement values the stamina costs come from */
+	UPROPERTY(EditAnywhere, Category = "Climb Graph")
+	TSubclassOf<class ACharacter> ClimberClass;
+
+	/** Distance between sampled wall patches (cm) */
+	UPROPERTY(EditAnywhere, Category = "Climb Graph", meta = (ClampMin = "10.0"))
+	float SampleSpacing;
+
+	/** Time a corner turn keeps draining climbing stamina */
+	UPROPERTY(EditAnywhere, Category = "Climb Graph")
+	float TurnCornerTime;
+
+	/** Distance the climb dash montages cover */
+	UPROPERTY(EditAnywhere, Category = "Climb Graph")
+	float ClimbDashDistance;
+
+	/** Farthest wall a wall jump can reach */
+	UPROPERTY(EditAnywhere, Category = "Climb Graph")
+	float WallJumpDistance;
+
+	/** Horizontal speed while gliding */
+	UPROPERTY(EditAnywhere, Category = "Climb Graph")
+	float GlideSpeed;
+
+	UFUNCTION(CallInEditor, Category = "Climb Graph")
+	void BuildClimbGraph();
+};
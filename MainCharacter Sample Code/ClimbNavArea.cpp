@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbNavArea.h"
+
+UNavArea_ClimbUp::UNavArea_ClimbUp(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// Slower than walking and drains stamina
+	DefaultCost = 3.f;
+	DrawColor = FColor(255, 160, 0);
+}
+
+UNavArea_ClimbDown::UNavArea_ClimbDown(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	DefaultCost = 3.f;
+	DrawColor = FColor(255, 220, 0);
+}
+
+UNavArea_Glide::UNavArea_Glide(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	DefaultCost = 1.5f;
+	DrawColor = FColor(0, 200, 255);
+}
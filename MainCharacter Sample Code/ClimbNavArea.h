@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavAreas/NavArea.h"
+#include "ClimbNavArea.generated.h"
+
+/**
+ * Areas of the climb nav links. Path following checks the area of the link it's about to take
+ * to start climbing, grab the wall from the top or glide instead of walking.
+ */
+UCLASS()
+class SECOND_API UNavArea_ClimbUp : public UNavArea
+{
+	GENERATED_BODY()
+
+public:
+	UNavArea_ClimbUp(const FObjectInitializer& ObjectInitializer);
+};
+
+UCLASS()
+class SECOND_API UNavArea_ClimbDown : public UNavArea
+{
+	GENERATED_BODY()
+
+public:
+	UNavArea_ClimbDown(const FObjectInitializer& ObjectInitializer);
+};
+
+UCLASS()
+class SECOND_API UNavArea_Glide : public UNavArea
+{
+	GENERATED_BODY()
+
+public:
+	UNavArea_Glide(const FObjectInitializer& ObjectInitializer);
+};
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbNavLinkComponent.h"
+#include "NavigationSystem.h"
+#include "NavigationSystemTypes.h"
+#include "AI/NavigationSystemHelpers.h"
+#include "AI/Navigation/NavigationRelevantData.h"
+
+UClimbNavLinkComponent::UClimbNavLinkComponent()
+{
+	LinksHash = 0;
+	TileCoord = FIntPoint(0, 0);
+}
+
+void UClimbNavLinkComponent::SetLinks(TArray<FNavigationLink>&& NewLinks, uint32 NewLinksHash)
+{
+	Links = MoveTemp(NewLinks);
+	LinksHash = NewLinksHash;
+
+	// Dirties only the tiles under the old and new bounds
+	RefreshNavigationModifiers();
+}
+
+void UClimbNavLinkComponent::ApplyWorldOffset(const FVector& InOffset, bool bWorldShift)
+{
+	Super::ApplyWorldOffset(InOffset, bWorldShift);
+
+	for (FNavigationLink& Link : Links)
+	{
+		Link.Left += InOffset;
+		Link.Right += InOffset;
+	}
+	CalcAndCacheBounds();
+}
+
+void UClimbNavLinkComponent::GetNavigationData(FNavigationRelevantData& Data) const
+{
+	if (Links.Num() == 0)
+	{
+		return;
+	}
+
+	// Links are kept in world space, ProcessNavLinkAndAppend expects them relative to the owner
+	const FTransform WorldToOwner = GetOwner()->GetActorTransform().Inverse();
+	TArray<FNavigationLink> LocalLinks = Links;
+	for (FNavigationLink& Link : LocalLinks)
+	{
+		Link.Left = WorldToOwner.TransformPosition(Link.Left);
+		Link.Right = WorldToOwner.TransformPosition(Link.Right);
+	}
+
+	NavigationHelper::ProcessNavLinkAndAppend(&Data.Modifiers, GetOwner(), LocalLinks);
+}
+
+void UClimbNavLinkComponent::CalcAndCacheBounds() const
+{
+	Bounds = FBox(ForceInit);
+	for (const FNavigationLink& Link : Links)
+	{
+		Bounds += Link.Left;
+		Bounds += Link.Right;
+	}
+
+	if (Bounds.IsValid)
+	{
+		Bounds = Bounds.ExpandBy(50.f);
+	}
+}
+
+bool UClimbNavLinkComponent::IsNavigationRelevant() const
+{
+	return Links.Num() > 0;
+}
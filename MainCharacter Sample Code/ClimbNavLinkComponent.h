@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavRelevantComponent.h"
+#include "AI/Navigation/NavLinkDefinition.h"
+#include "ClimbNavLinkComponent.generated.h"
+
+/**
+ * Climb nav links of one navmesh tile, added by AClimbNavLinkGenerator.
+ * Recast gathers them when it rebuilds a tile the bounds overlap, one component per tile keeps
+ * a changed tile from dirtying the others.
+ */
+UCLASS()
+class SECOND_API UClimbNavLinkComponent : public UNavRelevantComponent
+{
+	GENERATED_BODY()
+
+public:
+	UClimbNavLinkComponent();
+
+	/** World space */
+	UPROPERTY(VisibleAnywhere, Category = "Climb Nav Link")
+	TArray<FNavigationLink> Links;
+
+	/** Hash of Links, to tell if a regeneration changed them */
+	UPROPERTY()
+	uint32 LinksHash;
+
+	UPROPERTY()
+	FIntPoint TileCoord;
+
+	void SetLinks(TArray<FNavigationLink>&& NewLinks, uint32 NewLinksHash);
+
+	/** Links move with the world origin, the navmesh shifts its tiles by itself. Called by AClimbNavLinkGenerator */
+	virtual void ApplyWorldOffset(const FVector& InOffset, bool bWorldShift) override;
+
+	/* UNavRelevantComponent */
+	virtual void GetNavigationData(FNavigationRelevantData& Data) const override;
+	virtual void CalcAndCacheBounds() const override;
+	virtual bool IsNavigationRelevant() const override;
+};
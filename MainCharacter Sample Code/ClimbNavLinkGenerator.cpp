@@ -0,0 +1,389 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbNavLinkGenerator.h"
+#include "ClimbNavLinkComponent.h"
+#include "ClimbNavArea.h"
+#include "ClimbGraph.h"
+#include "ClimbNavigationSubsystem.h"
+#include "StaminaComponent.h"
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Crc.h"
+#include "Engine/World.h"
+
+AClimbNavLinkGenerator::AClimbNavLinkGenerator()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	SetRootComponent(CreateDefaultSubobject<USceneComponent>(TEXT("Root")));
+
+	LinkSpacing = 200.f;
+	SnapHeight = 150.f;
+	MaxClimbStamina = GetDefault<UStaminaComponent>()->MaxStamina;
+	bGenerateOnBeginPlay = false;
+	bRegenerateDirtyTiles = true;
+	bIsGenerating = false;
+	bIsDirtyTileGenerationPending = false;
+}
+
+void AClimbNavLinkGenerator::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bRegenerateDirtyTiles)
+	{
+		NavigationDirtiedHandle = UNavigationSystemV1::NavigationDirtyEvent.AddUObject(this, &AClimbNavLinkGenerator::OnNavigationDirtied);
+		if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+		{
+			NavSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &AClimbNavLinkGenerator::OnNavigationGenerationFinished);
+		}
+	}
+
+	if (bGenerateOnBeginPlay)
+	{
+		GenerateNavLinks();
+	}
+}
+
+void AClimbNavLinkGenerator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UNavigationSystemV1::NavigationDirtyEvent.Remove(NavigationDirtiedHandle);
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &AClimbNavLinkGenerator::OnNavigationGenerationFinished);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AClimbNavLinkGenerator::ApplyWorldOffset(const FVector& InOffset, bool bWorldShift)
+{
+	Super::ApplyWorldOffset(InOffset, bWorldShift);
+
+	TInlineComponentArray<UClimbNavLinkComponent*> LinkComponents(this);
+	for (UClimbNavLinkComponent* LinkComponent : LinkComponents)
+	{
+		LinkComponent->ApplyWorldOffset(InOffset, bWorldShift);
+	}
+}
+
+void AClimbNavLinkGenerator::GenerateNavLinks()
+{
+	if (!bIsGenerating)
+	{
+		DirtyTiles.Reset();
+		StartGeneration(TSet<FIntPoint>());
+	}
+}
+
+float AClimbNavLinkGenerator::GetTileSize() const
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (const ARecastNavMesh* NavMesh = NavSys ? Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate)) : nullptr)
+	{
+		return NavMesh->TileSizeUU;
+	}
+
+	return 1000.f;
+}
+
+void AClimbNavLinkGenerator::OnNavigationDirtied(const FBox& DirtyBounds)
+{
+	if (!DirtyBounds.IsValid || GetWorld() == nullptr)
+	{
+		return;
+	}
+
+	// A link can end in the tile next to its ledge's, so the neighbours of a dirty tile are dirty too
+	const float TileSize = GetTileSize();
+	const FVector OriginOffset(GetWorld()->OriginLocation);
+	const FVector Min = DirtyBounds.Min + OriginOffset;
+	const FVector Max = DirtyBounds.Max + OriginOffset;
+	for (int32 X = FMath::FloorToInt(Min.X / TileSize) - 1; X <= FMath::FloorToInt(Max.X / TileSize) + 1; ++X)
+	{
+		for (int32 Y = FMath::FloorToInt(Min.Y / TileSize) - 1; Y <= FMath::FloorToInt(Max.Y / TileSize) + 1; ++Y)
+		{
+			DirtyTiles.Add(FIntPoint(X, Y));
+		}
+	}
+}
+
+void AClimbNavLinkGenerator::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	if (bIsGenerating)
+	{
+		bIsDirtyTileGenerationPending = true;
+		return;
+	}
+
+	GenerateDirtyTileLinks();
+}
+
+void AClimbNavLinkGenerator::GenerateDirtyTileLinks()
+{
+	bIsDirtyTileGenerationPending = false;
+	if (DirtyTiles.Num() > 0)
+	{
+		StartGeneration(MoveTemp(DirtyTiles));
+		DirtyTiles.Reset();
+	}
+}
+
+void AClimbNavLinkGenerator::BucketLedgesByTile(const FClimbGraph& Graph, float TileSize, const TSet<FIntPoint>& OnlyTiles, TMap<FIntPoint, TArray<int32>>& OutTileLedges)
+{
+	OutTileLedges.Reset();
+
+	// Links start at a ledge, so the ledge decides the tile
+	for (int32 NodeIndex = 0; NodeIndex < Graph.GetNumNodes(); ++NodeIndex)
+	{
+		const FClimbGraphNode& Node = Graph.Nodes[NodeIndex];
+		if (Node.Type == EClimbGraphNodeType::Ledge)
+		{
+			const FIntPoint TileCoord(FMath::FloorToInt(Node.Location.X / TileSize), FMath::FloorToInt(Node.Location.Y / TileSize));
+			if (OnlyTiles.Num() == 0 || OnlyTiles.Contains(TileCoord))
+			{
+				OutTileLedges.FindOrAdd(TileCoord).Add(NodeIndex);
+			}
+		}
+	}
+}
+
+void AClimbNavLinkGenerator::StartGeneration(TSet<FIntPoint>&& Tiles)
+{
+	UWorld* World = GetWorld();
+	if (bIsGenerating || !World)
+	{
+		return;
+	}
+
+	// The graph loaded for play, or straight from the file in the editor
+	TSharedPtr<const FClimbGraph, ESPMode::ThreadSafe> Graph;
+	if (UClimbNavigationSubsystem* NavigationSubsystem = World->GetSubsystem<UClimbNavigationSubsystem>())
+	{
+		Graph = NavigationSubsystem->GetSharedGraph();
+	}
+	if (!Graph.IsValid())
+	{
+		TSharedRef<FClimbGraph, ESPMode::ThreadSafe> LoadedGraph = MakeShared<FClimbGraph, ESPMode::ThreadSafe>();
+		if (!LoadedGraph->LoadFromFile(FClimbGraph::GetGraphFilePath(World)))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No climb graph for %s, build it with a ClimbGraphVolume first"), *World->GetName());
+			return;
+		}
+		Graph = LoadedGraph;
+	}
+
+	const float TileSize = GetTileSize();
+
+	FClimbNavLinkSettings Settings;
+	Settings.LinkSpacing = LinkSpacing;
+	Settings.SnapHeight = SnapHeight;
+	Settings.MaxClimbStamina = MaxClimbStamina;
+	Settings.MaxClimbNodes = 256;
+
+	bIsGenerating = true;
+	const double GenerateStartTime = FPlatformTime::Seconds();
+	TWeakObjectPtr<AClimbNavLinkGenerator> WeakThis(this);
+
+	Async(EAsyncExecution::ThreadPool, [Graph, Settings, TileSize, WeakThis, GenerateStartTime, Tiles = MoveTemp(Tiles)]() mutable
+		{
+			TMap<FIntPoint, TArray<int32>> TileLedges;
+			BucketLedgesByTile(*Graph, TileSize, Tiles, TileLedges);
+
+			TArray<FIntPoint> TileCoords;
+			TileLedges.GenerateKeyArray(TileCoords);
+
+			TArray<FClimbNavLinkTileResult> Results;
+			Results.SetNum(TileCoords.Num());
+			ParallelFor(TileCoords.Num(), [&](int32 Index)
+				{
+					Results[Index].TileCoord = TileCoords[Index];
+					GenerateTileLinks(*Graph, TileLedges[TileCoords[Index]], Settings, Results[Index]);
+				});
+
+			const double GenerateEndTime = FPlatformTime::Seconds();
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Results = MoveTemp(Results), Tiles = MoveTemp(Tiles), GenerateStartTime, GenerateEndTime]() mutable
+				{
+					if (AClimbNavLinkGenerator* Generator = WeakThis.Get())
+					{
+						Generator->ApplyTileResults(MoveTemp(Results), Tiles, GenerateStartTime, GenerateEndTime);
+					}
+				});
+		});
+}
+
+void AClimbNavLinkGenerator::GenerateTileLinks(const FClimbGraph& Graph, const TArray<int32>& LedgeNodes, const FClimbNavLinkSettings& Settings, FClimbNavLinkTileResult& OutResult)
+{
+	OutResult.Links.Reset();
+	OutResult.LinkTypes.Reset();
+	OutResult.LinksHash = 0;
+
+	// Neighbouring ledge nodes would all link the same cliff, one link per spacing cell
+	TSet<FIntVector> ClimbLinkCells;
+	TSet<FIntVector> GlideLinkCells;
+
+	for (int32 LedgeNode : LedgeNodes)
+	{
+		const FClimbGraphNode& Ledge = Graph.Nodes[LedgeNode];
+		const FIntVector LinkCell(
+			FMath::FloorToInt(Ledge.Location.X / Settings.LinkSpacing),
+			FMath::FloorToInt(Ledge.Location.Y / Settings.LinkSpacing),
+			FMath::FloorToInt(Ledge.Location.Z / Settings.LinkSpacing));
+
+		for (int32 EdgeIndex = Graph.GetFirstEdge(LedgeNode); EdgeIndex < Graph.GetLastEdge(LedgeNode); ++EdgeIndex)
+		{
+			const FClimbGraphEdge& Edge = Graph.Edges[EdgeIndex];
+
+			if (Edge.Type == EClimbGraphEdgeType::ClimbDown && !ClimbLinkCells.Contains(LinkCell))
+			{
+				// Follow the wall down to a patch with ground below, always taking the lowest neighbour
+				int32 CurrentNode = Edge.TargetNode;
+				float ClimbStamina = 0.f;
+				for (int32 Step = 0; Step < Settings.MaxClimbNodes && !(Graph.Nodes[CurrentNode].Flags & ClimbGraphNodeFlag_Ground); ++Step)
+				{
+					int32 LowestNode = INDEX_NONE;
+					float LowestZ = Graph.Nodes[CurrentNode].Location.Z - 1.f;
+					float LowestStamina = 0.f;
+					for (int32 WallEdgeIndex = Graph.GetFirstEdge(CurrentNode); WallEdgeIndex < Graph.GetLastEdge(CurrentNode); ++WallEdgeIndex)
+					{
+						const FClimbGraphEdge& WallEdge = Graph.Edges[WallEdgeIndex];
+						if (WallEdge.Type == EClimbGraphEdgeType::Climb && Graph.Nodes[WallEdge.TargetNode].Location.Z < LowestZ)
+						{
+							LowestNode = WallEdge.TargetNode;
+							LowestZ = Graph.Nodes[WallEdge.TargetNode].Location.Z;
+							LowestStamina = WallEdge.StaminaCost;
+						}
+					}
+
+					if (LowestNode == INDEX_NONE)
+					{
+						break;
+					}
+					CurrentNode = LowestNode;
+					ClimbStamina += LowestStamina;
+				}
+
+				const FClimbGraphNode& Bottom = Graph.Nodes[CurrentNode];
+				if ((Bottom.Flags & ClimbGraphNodeFlag_Ground) && ClimbStamina <= Settings.MaxClimbStamina)
+				{
+					// Step back from the wall onto the navmesh
+					const FVector GroundLocation = Bottom.Location - Bottom.GetFacingVector() * 30.f;
+					AddLink(GroundLocation, Ledge.Location, EClimbNavLinkType::ClimbUp, Settings, OutResult);
+					AddLink(Ledge.Location, GroundLocation, EClimbNavLinkType::ClimbDown, Settings, OutResult);
+					ClimbLinkCells.Add(LinkCell);
+				}
+			}
+			else if (Edge.Type == EClimbGraphEdgeType::Glide && !GlideLinkCells.Contains(LinkCell))
+			{
+				// Glide edges are sorted cheapest first, land where the AI can walk on
+				const FClimbGraphNode& Landing = Graph.Nodes[Edge.TargetNode];
+				if (Landing.IsRestNode() && Edge.StaminaCost <= Settings.MaxClimbStamina)
+				{
+					const FVector LandingLocation = Landing.Type == EClimbGraphNodeType::Ledge ? Landing.Location : Landing.Location - Landing.GetFacingVector() * 30.f;
+					AddLink(Ledge.Location, LandingLocation, EClimbNavLinkType::Glide, Settings, OutResult);
+					GlideLinkCells.Add(LinkCell);
+				}
+			}
+		}
+	}
+}
+
+void AClimbNavLinkGenerator::AddLink(const FVector& Left, const FVector& Right, EClimbNavLinkType Type, const FClimbNavLinkSettings& Settings, FClimbNavLinkTileResult& OutResult)
+{
+	FNavigationLink Link(Left, Right);
+	Link.Direction = ENavLinkDirection::LeftToRight;
+	Link.SnapHeight = Settings.SnapHeight;
+	Link.bUseSnapHeight = true;
+
+	OutResult.Links.Add(Link);
+	OutResult.LinkTypes.Add(Type);
+
+	const uint8 TypeValue = (uint8)Type;
+	OutResult.LinksHash = FCrc::MemCrc32(&Left, sizeof(FVector), OutResult.LinksHash);
+	OutResult.LinksHash = FCrc::MemCrc32(&Right, sizeof(FVector), OutResult.LinksHash);
+	OutResult.LinksHash = FCrc::MemCrc32(&TypeValue, sizeof(uint8), OutResult.LinksHash);
+}
+
+void AClimbNavLinkGenerator::ApplyTileResults(TArray<FClimbNavLinkTileResult>&& Results, const TSet<FIntPoint>& Tiles, double GenerateStartTime, double GenerateEndTime)
+{
+	bIsGenerating = false;
+
+	int32 NumLinks = 0;
+	int32 NumChangedTiles = 0;
+	TSet<FIntPoint> GeneratedTiles;
+
+	for (FClimbNavLinkTileResult& Result : Results)
+	{
+		GeneratedTiles.Add(Result.TileCoord);
+		NumLinks += Result.Links.Num();
+
+		UClimbNavLinkComponent* TileComponent = TileComponents.FindRef(Result.TileCoord);
+		if (!TileComponent)
+		{
+			if (Result.Links.Num() == 0)
+			{
+				continue;
+			}
+
+			TileComponent = NewObject<UClimbNavLinkComponent>(this, NAME_None, RF_Transactional);
+			TileComponent->TileCoord = Result.TileCoord;
+			AddInstanceComponent(TileComponent);
+			TileComponent->RegisterComponent();
+			TileComponents.Add(Result.TileCoord, TileComponent);
+		}
+
+		// Unchanged tiles aren't touched, Recast won't rebuild them
+		if (TileComponent->LinksHash == Result.LinksHash && TileComponent->Links.Num() == Result.Links.Num())
+		{
+			continue;
+		}
+
+		// Links are generated in the graph's absolute coordinates
+		const FVector OriginOffset(GetWorld()->OriginLocation);
+		for (int32 LinkIndex = 0; LinkIndex < Result.Links.Num(); ++LinkIndex)
+		{
+			Result.Links[LinkIndex].Left -= OriginOffset;
+			Result.Links[LinkIndex].Right -= OriginOffset;
+
+			switch (Result.LinkTypes[LinkIndex])
+			{
+			case EClimbNavLinkType::ClimbUp:
+				Result.Links[LinkIndex].SetAreaClass(UNavArea_ClimbUp::StaticClass());
+				break;
+			case EClimbNavLinkType::ClimbDown:
+				Result.Links[LinkIndex].SetAreaClass(UNavArea_ClimbDown::StaticClass());
+				break;
+			case EClimbNavLinkType::Glide:
+				Result.Links[LinkIndex].SetAreaClass(UNavArea_Glide::StaticClass());
+				break;
+			default:
+				break;
+			}
+		}
+
+		TileComponent->SetLinks(MoveTemp(Result.Links), Result.LinksHash);
+		++NumChangedTiles;
+	}
+
+	// Tiles that lost all their ledges, of the ones generated
+	for (TPair<FIntPoint, UClimbNavLinkComponent*>& TileComponent : TileComponents)
+	{
+		if (TileComponent.Value && !GeneratedTiles.Contains(TileComponent.Key) && (Tiles.Num() == 0 || Tiles.Contains(TileComponent.Key))
+			&& TileComponent.Value->Links.Num() > 0)
+		{
+			TileComponent.Value->SetLinks(TArray<FNavigationLink>(), 0);
+			++NumChangedTiles;
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Climb nav links : %d links in %d tiles, %d tiles changed. Generated in %.1f ms, applied in %.1f ms"),
+		NumLinks, Results.Num(), NumChangedTiles, (GenerateEndTime - GenerateStartTime) * 1000.0, (FPlatformTime::Seconds() - GenerateEndTime) * 1000.0);
+
+	// The navmesh rebuilt more tiles while these were generated
+	if (bIsDirtyTileGenerationPending)
+	{
+		GenerateDirtyTileLinks();
+	}
+}
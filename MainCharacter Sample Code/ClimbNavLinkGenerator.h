@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "AI/Navigation/NavLinkDefinition.h"
+#include "ClimbNavLinkGenerator.generated.h"
+
+class FClimbGraph;
+
+enum class EClimbNavLinkType : uint8
+{
+	ClimbUp,
+	ClimbDown,	// GrabWallFromTop
+	Glide,
+	MAX
+};
+
+struct FClimbNavLinkSettings
+{
+	/** One link per this distance along a ledge */
+	float LinkSpacing;
+
+	/** Vertical tolerance projecting a link end to the navmesh */
+	float SnapHeight;
+
+	/** Climbs draining more than this aren't linked */
+	float MaxClimbStamina;
+
+	/** Longest wall, in graph nodes, followed down to the ground */
+	int32 MaxClimbNodes;
+};
+
+struct FClimbNavLinkTileResult
+{
+	FIntPoint TileCoord;
+	TArray<FNavigationLink> Links;
+	TArray<EClimbNavLinkType> LinkTypes;
+	uint32 LinksHash;
+};
+
+/**
+ * Turns the baked climb graph into navmesh links so AI paths can go up, down and over cliffs.
+ * Ledges are bucketed per navmesh tile and each tile's links are generated in parallel on the
+ * thread pool. Only tiles whose links changed are handed to their UClimbNavLinkComponent,
+ * so Recast rebuilds just those tiles in the background.
+ *
+ * In play, the tiles a navigation dirty area touches are collected and, once the navmesh finished
+ * rebuilding, only their links are generated again, on the thread pool like a full generation.
+ */
+UCLASS()
+class SECOND_API AClimbNavLinkGenerator : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AClimbNavLinkGenerator();
+
+	UPROPERTY(EditAnywhere, Category = "Climb Nav Link")
+	float LinkSpacing;
+
+	UPROPERTY(EditAnywhere, Category = "Climb Nav Link")
+	float SnapHeight;
+
+	UPROPERTY(EditAnywhere, Category = "Climb Nav Link")
+	float MaxClimbStamina;
+
+	/** Regenerate from the climb graph loaded for play, for levels with a dynamic navmesh */
+	UPROPERTY(EditAnywhere, Category = "Climb Nav Link")
+	bool bGenerateOnBeginPlay;
+
+	/** Regenerate the links of the tiles a dynamic navmesh rebuilt */
+	UPROPERTY(EditAnywhere, Category = "Climb Nav Link")
+	bool bRegenerateDirtyTiles;
+
+	UFUNCTION(CallInEditor, Category = "Climb Nav Link")
+	void GenerateNavLinks();
+
+	/** Ledge nodes per tile, of the tiles in OnlyTiles or of every tile when it's empty */
+	static void BucketLedgesByTile(const FClimbGraph& Graph, float TileSize, const TSet<FIntPoint>& OnlyTiles, TMap<FIntPoint, TArray<int32>>& OutTileLedges);
+
+	static void GenerateTileLinks(const FClimbGraph& Graph, const TArray<int32>& LedgeNodes, const FClimbNavLinkSettings& Settings, FClimbNavLinkTileResult& OutResult);
+
+	/** The engine only shifts scene components, the tile link components are handed the offset from here */
+	virtual void ApplyWorldOffset(const FVector& InOffset, bool bWorldShift) override;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/** Generates the links of Tiles, every tile when it's empty */
+	void StartGeneration(TSet<FIntPoint>&& Tiles);
+	void ApplyTileResults(TArray<FClimbNavLinkTileResult>&& Results, const TSet<FIntPoint>& Tiles, double GenerateStartTime, double GenerateEndTime);
+
+	float GetTileSize() const;
+
+	/* Dirty Tiles */
+	void OnNavigationDirtied(const FBox& DirtyBounds);
+
+	UFUNCTION()
+	void OnNavigationGenerationFinished(class ANavigationData* NavData);
+
+	void GenerateDirtyTileLinks();
+
+	static void AddLink(const FVector& Left, const FVector& Right, EClimbNavLinkType Type, const FClimbNavLinkSettings& Settings, FClimbNavLinkTileResult& OutResult);
+
+	UPROPERTY()
+	TMap<FIntPoint, class UClimbNavLinkComponent*> TileComponents;
+
+	bool bIsGenerating;
+
+	/** Tiles dirtied since their links were last generated, in the graph's absolute coordinates */
+	TSet<FIntPoint> DirtyTiles;
+
+	/** The navmesh finished a rebuild while links were being generated */
+	bool bIsDirtyTileGenerationPending;
+
+	FDelegateHandle NavigationDirtiedHandle;
+};
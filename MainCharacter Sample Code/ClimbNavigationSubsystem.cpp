@@ -0,0 +1,210 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbNavigationSubsystem.h"
+#include "Engine/World.h"
+
+UClimbNavigationSubsystem::UClimbNavigationSubsystem()
+{
+	MaxSnapDistance = 150.f;
+	NextRequestId = 0;
+	StaminaRegionSize = 500.f;
+	StaminaFieldRadius = 5000.f;
+	StaminaBucketSize = 5.f;
+	MaxCachedStaminaFields = 32;
+}
+
+void UClimbNavigationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (!GetWorld()->IsGameWorld())
+	{
+		return;
+	}
+
+	// Levels without a generated graph just don't plan climbing routes
+	TSharedRef<FClimbGraph, ESPMode::ThreadSafe> LoadedGraph = MakeShared<FClimbGraph, ESPMode::ThreadSafe>();
+	if (!LoadedGraph->LoadFromFile(FClimbGraph::GetGraphFilePath(GetWorld())))
+	{
+		return;
+	}
+
+	Graph = LoadedGraph;
+	GameThreadPlanner = MakeUnique<FClimbPathPlanner>(*LoadedGraph);
+	Worker = MakeUnique<FClimbPathWorker>(LoadedGraph);
+}
+
+void UClimbNavigationSubsystem::Deinitialize()
+{
+	Worker.Reset();
+	GameThreadPlanner.Reset();
+	Graph.Reset();
+	PendingRequests.Reset();
+	StaminaFields.Reset();
+	StaminaFieldUseOrder.Reset();
+	PendingStaminaFields.Reset();
+
+	Super::Deinitialize();
+}
+
+int32 UClimbNavigationSubsystem::RequestPath(const FVector& Start, const FVector& Goal, FOnClimbPathFound OnPathFound)
+{
+	if (!Worker)
+	{
+		return INDEX_NONE;
+	}
+
+	FClimbPathRequest Request;
+	Request.RequestId = NextRequestId;
+	Request.Start = Start + GetOriginOffset();
+	Request.Goal = Goal + GetOriginOffset();
+	Request.MaxSnapDistance = MaxSnapDistance;
+
+	NextRequestId = (NextRequestId + 1) & MAX_int32;
+	PendingRequests.Add(Request.RequestId, OnPathFound);
+	Worker->AddRequest(Request);
+	return Request.RequestId;
+}
+
+void UClimbNavigationSubsystem::CancelPath(int32 RequestId)
+{
+	PendingRequests.Remove(RequestId);
+}
+
+bool UClimbNavigationSubsystem::FindPath(const FVector& Start, const FVector& Goal, FClimbPath& OutPath)
+{
+	if (!GameThreadPlanner)
+	{
+		OutPath.Reset();
+		return false;
+	}
+
+	return GameThreadPlanner->FindPath(Start + GetOriginOffset(), Goal + GetOriginOffset(), MaxSnapDistance, OutPath);
+}
+
+FVector UClimbNavigationSubsystem::GetNodeLocation(int32 NodeIndex) const
+{
+	return Graph->Nodes[NodeIndex].Location - GetOriginOffset();
+}
+
+FVector UClimbNavigationSubsystem::GetOriginOffset() const
+{
+	const UWorld* World = GetWorld();
+	return World != nullptr ? FVector(World->OriginLocation) : FVector(0.f, 0.f, 0.f);
+}
+
+EClimbStaminaQueryResult UClimbNavigationSubsystem::QueryRequiredStamina(FVector Start, FVector TargetLedge, float MaxStamina, float& RequiredStamina)
+{
+	RequiredStamina = 0.f;
+	if (!Graph.IsValid())
+	{
+		return EClimbStaminaQueryResult::ECSQ_NoGraph;
+	}
+
+	const int32 TargetNode = Graph->FindNearestNode(TargetLedge + GetOriginOffset(), MaxSnapDistance);
+	const int32 StartNode = Graph->FindNearestNode(Start + GetOriginOffset(), MaxSnapDistance);
+	if (TargetNode == INDEX_NONE || StartNode == INDEX_NONE)
+	{
+		return EClimbStaminaQueryResult::ECSQ_Unreachable;
+	}
+
+	const FVector TargetLocation = Graph->Nodes[TargetNode].Location;
+	const FIntVector Region(
+		FMath::FloorToInt(TargetLocation.X / StaminaRegionSize),
+		FMath::FloorToInt(TargetLocation.Y / StaminaRegionSize),
+		FMath::FloorToInt(TargetLocation.Z / StaminaRegionSize));
+	const FClimbStaminaFieldKey Key(Region, Graph->Nodes[TargetNode].Type, FMath::FloorToInt(MaxStamina / StaminaBucketSize));
+
+	const TSharedPtr<FClimbStaminaField, ESPMode::ThreadSafe>* Field = StaminaFields.Find(Key);
+	if (!Field)
+	{
+		RequestStaminaField(Key);
+		return EClimbStaminaQueryResult::ECSQ_Pending;
+	}
+
+	// Keep the most recently queried fields cached
+	if (StaminaFieldUseOrder.Last() != Key)
+	{
+		StaminaFieldUseOrder.Remove(Key);
+		StaminaFieldUseOrder.Add(Key);
+	}
+
+	RequiredStamina = (*Field)->GetRequiredStamina(StartNode);
+	if (RequiredStamina < 0.f)
+	{
+		RequiredStamina = 0.f;
+		return EClimbStaminaQueryResult::ECSQ_Unreachable;
+	}
+
+	return EClimbStaminaQueryResult::ECSQ_Reachable;
+}
+
+void UClimbNavigationSubsystem::RequestStaminaField(const FClimbStaminaFieldKey& Key)
+{
+	if (!Worker || PendingStaminaFields.Contains(Key))
+	{
+		return;
+	}
+
+	FClimbStaminaFieldRequest Request;
+	Request.Key = Key;
+	Request.MaxStamina = Key.MaxStaminaBucket * StaminaBucketSize;
+	Request.Radius = StaminaFieldRadius;
+
+	// Every node of the target's type in the region is a target
+	const FBox RegionBox(FVector(Key.Region) * StaminaRegionSize, FVector(Key.Region + FIntVector(1, 1, 1)) * StaminaRegionSize);
+	Request.Center = RegionBox.GetCenter();
+	Graph->FindNodesInBox(RegionBox, Key.TargetType, Request.TargetNodes);
+
+	PendingStaminaFields.Add(Key);
+	Worker->AddStaminaFieldRequest(Request);
+}
+
+void UClimbNavigationSubsystem::AddStaminaField(const TSharedPtr<FClimbStaminaField, ESPMode::ThreadSafe>& Field)
+{
+	PendingStaminaFields.Remove(Field->Key);
+
+	StaminaFields.Add(Field->Key, Field);
+	StaminaFieldUseOrder.Remove(Field->Key);
+	StaminaFieldUseOrder.Add(Field->Key);
+
+	while (StaminaFieldUseOrder.Num() > MaxCachedStaminaFields)
+	{
+		StaminaFields.Remove(StaminaFieldUseOrder[0]);
+		StaminaFieldUseOrder.RemoveAt(0);
+	}
+}
+
+void UClimbNavigationSubsystem::Tick(float DeltaTime)
+{
+	if (!Worker)
+	{
+		return;
+	}
+
+	FClimbPathResult Result;
+	while (Worker->GetResult(Result))
+	{
+		FOnClimbPathFound OnPathFound;
+		if (PendingRequests.RemoveAndCopyValue(Result.RequestId, OnPathFound))
+		{
+			OnPathFound.ExecuteIfBound(Result.Path);
+		}
+	}
+
+	TSharedPtr<FClimbStaminaField, ESPMode::ThreadSafe> Field;
+	while (Worker->GetStaminaField(Field))
+	{
+		AddStaminaField(Field);
+	}
+}
+
+bool UClimbNavigationSubsystem::IsTickable() const
+{
+	return !IsTemplate() && GetWorld() != nullptr && GetWorld()->IsGameWorld();
+}
+
+TStatId UClimbNavigationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbNavigationSubsystem, STATGROUP_Tickables);
+}
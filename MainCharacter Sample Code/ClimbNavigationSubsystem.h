@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ClimbPathPlanner.h"
+#include "ClimbNavigationSubsystem.generated.h"
+
+DECLARE_DELEGATE_OneParam(FOnClimbPathFound, const FClimbPath&);
+
+UENUM(BlueprintType)
+enum class EClimbStaminaQueryResult : uint8
+{
+	ECSQ_NoGraph UMETA(DisplayName = "No Graph"),
+	ECSQ_Pending UMETA(DisplayName = "Pending"),
+	ECSQ_Reachable UMETA(DisplayName = "Reachable"),
+	ECSQ_Unreachable UMETA(DisplayName = "Unreachable"),
+	ECSQ_MAX UMETA(DisplayName = "DefaultMax")
+};
+
+/**
+ * Loads the level's climb graph and plans climbing routes for AI on a worker thread.
+ * Results are handed back from Tick on the game thread. An invalid path means no route was found.
+ *
+ * Stamina queries answer from stamina fields cached per target region (a StaminaRegionSize cell
+ * around the target ledge), target node type and stamina bar (in StaminaBucketSize steps). A field is
+ * built on the worker the first time it is asked for, after that a query is two node lookups and a map
+ * find, cheap enough for the HUD and AI every frame.
+ *
+ * The graph is baked in absolute coordinates. Locations passed in are world locations and are moved
+ * by the world origin, so planning keeps working after the origin is rebased.
+ */
+UCLASS()
+class SECOND_API UClimbNavigationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UClimbNavigationSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** How far a start or goal location may be from the graph node it snaps to */
+	float MaxSnapDistance;
+
+	FORCEINLINE bool HasGraph() const { return Graph.IsValid(); }
+	FORCEINLINE const FClimbGraph* GetGraph() const { return Graph.Get(); }
+	FORCEINLINE TSharedPtr<const FClimbGraph, ESPMode::ThreadSafe> GetSharedGraph() const { return Graph; }
+
+	/** Returns the request id, INDEX_NONE when the level has no climb graph */
+	int32 RequestPath(const FVector& Start, const FVector& Goal, FOnClimbPathFound OnPathFound);
+
+	/** The delegate won't be called, the worker still finishes the query */
+	void CancelPath(int32 RequestId);
+
+	/** Plans on the calling game thread right away */
+	bool FindPath(const FVector& Start, const FVector& Goal, FClimbPath& OutPath);
+
+	/** World location of a graph node, for following a path */
+	FVector GetNodeLocation(int32 NodeIndex) const;
+
+	/** Width of a stamina query target region (cm) */
+	float StaminaRegionSize;
+
+	/** How far from the target region a stamina field searches */
+	float StaminaFieldRadius;
+
+	/** Stamina bars within one step share a field, built for the bottom of the step */
+	float StaminaBucketSize;
+
+	int32 MaxCachedStaminaFields;
+
+	/**
+	 * Least stamina needed at Start to climb to TargetLedge, with the bar refilling to MaxStamina on every ledge
+	 * or ground rest on the way. Pending until the target region's field is built, ask again next frame.
+	 * The field targets every node of TargetLedge's type in its region, so this is the stamina to the
+	 * cheapest of them, the nearest target in the region. MaxStamina is rounded down to StaminaBucketSize,
+	 * a route only the remainder would make is reported unreachable.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Climb Navigation")
+	EClimbStaminaQueryResult QueryRequiredStamina(FVector Start, FVector TargetLedge, float MaxStamina, float& RequiredStamina);
+
+	/* FTickableGameObject */
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	/** World origin location, world to graph coordinates */
+	FVector GetOriginOffset() const;
+
+	TSharedPtr<const FClimbGraph, ESPMode::ThreadSafe> Graph;
+	TUniquePtr<FClimbPathWorker> Worker;
+	TUniquePtr<FClimbPathPlanner> GameThreadPlanner;
+
+	TMap<int32, FOnClimbPathFound> PendingRequests;
+	int32 NextRequestId;
+
+	void RequestStaminaField(const FClimbStaminaFieldKey& Key);
+	void AddStaminaField(const TSharedPtr<FClimbStaminaField, ESPMode::ThreadSafe>& Field);
+
+	TMap<FClimbStaminaFieldKey, TSharedPtr<FClimbStaminaField, ESPMode::ThreadSafe>> StaminaFields;
+
+	/** Least recently queried first */
+	TArray<FClimbStaminaFieldKey> StaminaFieldUseOrder;
+	TSet<FClimbStaminaFieldKey> PendingStaminaFields;
+};
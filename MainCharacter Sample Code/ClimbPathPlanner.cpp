@@ -0,0 +1,314 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbPathPlanner.h"
+#include "Algo/Reverse.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+
+FClimbPath::FClimbPath()
+{
+	StaminaCost = 0.f;
+	Length = 0.f;
+}
+
+void FClimbPath::Reset()
+{
+	Nodes.Reset();
+	EdgeTypes.Reset();
+	StaminaCost = 0.f;
+	Length = 0.f;
+}
+
+FClimbStaminaFieldKey::FClimbStaminaFieldKey()
+{
+	Region = FIntVector(0, 0, 0);
+	TargetType = EClimbGraphNodeType::Ledge;
+	MaxStaminaBucket = 0;
+}
+
+FClimbStaminaFieldKey::FClimbStaminaFieldKey(const FIntVector& InRegion, EClimbGraphNodeType InTargetType, int32 InMaxStaminaBucket)
+{
+	Region = InRegion;
+	TargetType = InTargetType;
+	MaxStaminaBucket = InMaxStaminaBucket;
+}
+
+FClimbStaminaField::FClimbStaminaField()
+{
+	MaxStamina = 0.f;
+}
+
+FClimbPathPlanner::FClimbPathPlanner(const FClimbGraph& InGraph)
+	: Graph(InGraph)
+{
+	DistanceCostWeight = 0.001f;
+	MaxExpandedNodes = 20000;
+	QueryId = 0;
+}
+
+bool FClimbPathPlanner::FindPath(int32 StartNode, int32 GoalNode, FClimbPath& OutPath)
+{
+	OutPath.Reset();
+
+	if (!Graph.Nodes.IsValidIndex(StartNode) || !Graph.Nodes.IsValidIndex(GoalNode))
+	{
+		return false;
+	}
+
+	BeginQuery();
+
+	const FVector GoalLocation = Graph.Nodes[GoalNode].Location;
+
+	QueryStamps[StartNode] = QueryId;
+	CostSoFar[StartNode] = 0.f;
+	ParentNodes[StartNode] = INDEX_NONE;
+	ParentEdges[StartNode] = INDEX_NONE;
+
+	OpenHeap.Reset();
+	OpenHeap.HeapPush({ StartNode, 0.f, FVector::Dist(Graph.Nodes[StartNode].Location, GoalLocation) * DistanceCostWeight });
+
+	int32 ExpandedNodes = 0;
+	while (OpenHeap.Num() > 0)
+	{
+		FOpenNode Current;
+		OpenHeap.HeapPop(Current, false);
+
+		// Already reached cheaper since it was pushed
+		if (Current.CostSoFar > CostSoFar[Current.NodeIndex])
+		{
+			continue;
+		}
+
+		if (Current.NodeIndex == GoalNode)
+		{
+			BuildPath(GoalNode, OutPath);
+			return true;
+		}
+
+		if (++ExpandedNodes > MaxExpandedNodes)
+		{
+			break;
+		}
+
+		for (int32 EdgeIndex = Graph.GetFirstEdge(Current.NodeIndex); EdgeIndex < Graph.GetLastEdge(Current.NodeIndex); ++EdgeIndex)
+		{
+			const FClimbGraphEdge& Edge = Graph.Edges[EdgeIndex];
+			const float NewCost = Current.CostSoFar + Edge.StaminaCost + Edge.Length * DistanceCostWeight;
+
+			if (QueryStamps[Edge.TargetNode] == QueryId && NewCost >= CostSoFar[Edge.TargetNode])
+			{
+				continue;
+			}
+
+			QueryStamps[Edge.TargetNode] = QueryId;
+			CostSoFar[Edge.TargetNode] = NewCost;
+			ParentNodes[Edge.TargetNode] = Current.NodeIndex;
+			ParentEdges[Edge.TargetNode] = EdgeIndex;
+
+			const float Heuristic = FVector::Dist(Graph.Nodes[Edge.TargetNode].Location, GoalLocation) * DistanceCostWeight;
+			OpenHeap.HeapPush({ Edge.TargetNode, NewCost, NewCost + Heuristic });
+		}
+	}
+
+	return false;
+}
+
+bool FClimbPathPlanner::FindPath(const FVector& Start, const FVector& Goal, float MaxSnapDistance, FClimbPath& OutPath)
+{
+	const int32 StartNode = Graph.FindNearestNode(Start, MaxSnapDistance);
+	const int32 GoalNode = Graph.FindNearestNode(Goal, MaxSnapDistance);
+	if (StartNode == INDEX_NONE || GoalNode == INDEX_NONE)
+	{
+		OutPath.Reset();
+		return false;
+	}
+
+	return FindPath(StartNode, GoalNode, OutPath);
+}
+
+void FClimbPathPlanner::BuildStaminaField(const TArray<int32>& TargetNodes, const FVector& Center, float MaxStamina, float Radius, FClimbStaminaField& OutField)
+{
+	OutField.MaxStamina = MaxStamina;
+	OutField.RequiredStamina.Reset();
+
+	BeginQuery();
+
+	const float RadiusSquared = FMath::Square(Radius);
+
+	OpenHeap.Reset();
+	for (int32 TargetNode : TargetNodes)
+	{
+		if (Graph.Nodes.IsValidIndex(TargetNode))
+		{
+			QueryStamps[TargetNode] = QueryId;
+			CostSoFar[TargetNode] = 0.f;
+			OpenHeap.HeapPush({ TargetNode, 0.f, 0.f });
+		}
+	}
+
+	while (OpenHeap.Num() > 0)
+	{
+		FOpenNode Current;
+		OpenHeap.HeapPop(Current, false);
+
+		if (Current.CostSoFar > CostSoFar[Current.NodeIndex])
+		{
+			continue;
+		}
+
+		// Arriving at a rest node refills stamina, only the stretch before it counts
+		const float CarriedStamina = Graph.Nodes[Current.NodeIndex].IsRestNode() ? 0.f : Current.CostSoFar;
+
+		for (int32 EdgeIndex = Graph.GetFirstReverseEdge(Current.NodeIndex); EdgeIndex < Graph.GetLastReverseEdge(Current.NodeIndex); ++EdgeIndex)
+		{
+			const FClimbGraphEdge& Edge = Graph.ReverseEdges[EdgeIndex];
+			const float NewCost = CarriedStamina + Edge.StaminaCost;
+
+			// Exhausted on the way even from a full bar
+			if (NewCost > MaxStamina || FVector::DistSquared(Graph.Nodes[Edge.TargetNode].Location, Center) > RadiusSquared)
+			{
+				continue;
+			}
+
+			if (QueryStamps[Edge.TargetNode] == QueryId && NewCost >= CostSoFar[Edge.TargetNode])
+			{
+				continue;
+			}
+
+			QueryStamps[Edge.TargetNode] = QueryId;
+			CostSoFar[Edge.TargetNode] = NewCost;
+			OpenHeap.HeapPush({ Edge.TargetNode, NewCost, NewCost });
+		}
+	}
+
+	for (int32 NodeIndex = 0; NodeIndex < QueryStamps.Num(); ++NodeIndex)
+	{
+		if (QueryStamps[NodeIndex] == QueryId)
+		{
+			OutField.RequiredStamina.Add(NodeIndex, CostSoFar[NodeIndex]);
+		}
+	}
+}
+
+void FClimbPathPlanner::BeginQuery()
+{
+	const int32 NumNodes = Graph.GetNumNodes();
+	if (QueryStamps.Num() != NumNodes)
+	{
+		CostSoFar.SetNumUninitialized(NumNodes);
+		ParentNodes.SetNumUninitialized(NumNodes);
+		ParentEdges.SetNumUninitialized(NumNodes);
+		QueryStamps.SetNumZeroed(NumNodes);
+		QueryId = 0;
+	}
+
+	// Stamps wrapped around, the old ones could pass for this query
+	if (++QueryId == 0)
+	{
+		FMemory::Memzero(QueryStamps.GetData(), QueryStamps.Num() * sizeof(uint32));
+		QueryId = 1;
+	}
+}
+
+void FClimbPathPlanner::BuildPath(int32 GoalNode, FClimbPath& OutPath) const
+{
+	for (int32 NodeIndex = GoalNode; NodeIndex != INDEX_NONE; NodeIndex = ParentNodes[NodeIndex])
+	{
+		OutPath.Nodes.Add(NodeIndex);
+
+		const int32 EdgeIndex = ParentEdges[NodeIndex];
+		if (EdgeIndex != INDEX_NONE)
+		{
+			const FClimbGraphEdge& Edge = Graph.Edges[EdgeIndex];
+			OutPath.EdgeTypes.Add(Edge.Type);
+			OutPath.StaminaCost += Edge.StaminaCost;
+			OutPath.Length += Edge.Length;
+		}
+		else
+		{
+			OutPath.EdgeTypes.Add(EClimbGraphEdgeType::MAX);
+		}
+	}
+
+	Algo::Reverse(OutPath.Nodes);
+	Algo::Reverse(OutPath.EdgeTypes);
+}
+
+FClimbPathWorker::FClimbPathWorker(const TSharedRef<const FClimbGraph, ESPMode::ThreadSafe>& InGraph)
+	: Graph(InGraph)
+	, Planner(*InGraph)
+{
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("ClimbPathWorker"), 0, TPri_BelowNormal);
+}
+
+FClimbPathWorker::~FClimbPathWorker()
+{
+	if (Thread)
+	{
+		// Stops the loop and waits for the thread to leave Run
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+void FClimbPathWorker::AddRequest(const FClimbPathRequest& Request)
+{
+	Requests.Enqueue(Request);
+	WakeEvent->Trigger();
+}
+
+bool FClimbPathWorker::GetResult(FClimbPathResult& OutResult)
+{
+	return Results.Dequeue(OutResult);
+}
+
+void FClimbPathWorker::AddStaminaFieldRequest(const FClimbStaminaFieldRequest& Request)
+{
+	StaminaFieldRequests.Enqueue(Request);
+	WakeEvent->Trigger();
+}
+
+bool FClimbPathWorker::GetStaminaField(TSharedPtr<FClimbStaminaField, ESPMode::ThreadSafe>& OutField)
+{
+	return StaminaFieldResults.Dequeue(OutField);
+}
+
+uint32 FClimbPathWorker::Run()
+{
+	while (!bIsStopping)
+	{
+		FClimbPathRequest Request;
+		while (!bIsStopping && Requests.Dequeue(Request))
+		{
+			FClimbPathResult Result;
+			Result.RequestId = Request.RequestId;
+			Planner.FindPath(Request.Start, Request.Goal, Request.MaxSnapDistance, Result.Path);
+			Results.Enqueue(MoveTemp(Result));
+		}
+
+		FClimbStaminaFieldRequest FieldRequest;
+		while (!bIsStopping && StaminaFieldRequests.Dequeue(FieldRequest))
+		{
+			TSharedPtr<FClimbStaminaField, ESPMode::ThreadSafe> Field = MakeShared<FClimbStaminaField, ESPMode::ThreadSafe>();
+			Field->Key = FieldRequest.Key;
+			Planner.BuildStaminaField(FieldRequest.TargetNodes, FieldRequest.Center, FieldRequest.MaxStamina, FieldRequest.Radius, *Field);
+			StaminaFieldResults.Enqueue(Field);
+		}
+
+		// A request added since the queue was emptied has already triggered the event
+		WakeEvent->Wait();
+	}
+
+	return 0;
+}
+
+void FClimbPathWorker::Stop()
+{
+	bIsStopping = true;
+	WakeEvent->Trigger();
+}
@@ -0,0 +1,183 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/Event.h"
+#include "Containers/Queue.h"
+#include "ClimbGraph.h"
+
+struct SECOND_API FClimbPath
+{
+	FClimbPath();
+
+	/** Graph nodes from start to goal */
+	TArray<int32> Nodes;
+
+	/** Edge type taken to reach each node, the start node's entry is unused */
+	TArray<EClimbGraphEdgeType> EdgeTypes;
+
+	float StaminaCost;
+	float Length;
+
+	FORCEINLINE bool IsValid() const { return Nodes.Num() > 0; }
+	void Reset();
+};
+
+/** What a stamina field was built for : the target region, the type of node targeted in it, and the stamina bar */
+struct SECOND_API FClimbStaminaFieldKey
+{
+	FClimbStaminaFieldKey();
+	FClimbStaminaFieldKey(const FIntVector& InRegion, EClimbGraphNodeType InTargetType, int32 InMaxStaminaBucket);
+
+	FIntVector Region;
+	EClimbGraphNodeType TargetType;
+
+	/** MaxStamina / bucket size, rounded down */
+	int32 MaxStaminaBucket;
+
+	FORCEINLINE bool operator==(const FClimbStaminaFieldKey& Other) const
+	{
+		return Region == Other.Region && TargetType == Other.TargetType && MaxStaminaBucket == Other.MaxStaminaBucket;
+	}
+
+	friend FORCEINLINE uint32 GetTypeHash(const FClimbStaminaFieldKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.Region), GetTypeHash((uint8)Key.TargetType)), GetTypeHash(Key.MaxStaminaBucket));
+	}
+};
+
+/** Least stamina a climber needs at each node around a target region to reach it */
+struct SECOND_API FClimbStaminaField
+{
+	FClimbStaminaField();
+
+	FClimbStaminaFieldKey Key;
+
+	/** Stamina after resting on a ledge or the ground, no later stretch of the route drains more */
+	float MaxStamina;
+
+	/** Nodes missing from the map can't reach the target */
+	TMap<int32, float> RequiredStamina;
+
+	/** Negative when Node can't reach the target */
+	FORCEINLINE float GetRequiredStamina(int32 Node) const
+	{
+		const float* Stamina = RequiredStamina.Find(Node);
+		return Stamina ? *Stamina : -1.f;
+	}
+};
+
+/**
+ * A* over a loaded FClimbGraph, weighted by the stamina each edge drains.
+ * Length is added with DistanceCostWeight so equal stamina routes prefer the shorter one, and keeps
+ * the straight line heuristic admissible. The per node scores are stamped with a query id instead of
+ * being cleared, so a query only touches the nodes it expands.
+ * Not thread safe, use one planner per thread. The graph itself can be shared.
+ */
+class SECOND_API FClimbPathPlanner
+{
+public:
+	explicit FClimbPathPlanner(const FClimbGraph& InGraph);
+
+	/** Cost of one cm, on top of the stamina cost */
+	float DistanceCostWeight;
+
+	/** Gives up when this many nodes were expanded */
+	int32 MaxExpandedNodes;
+
+	bool FindPath(int32 StartNode, int32 GoalNode, FClimbPath& OutPath);
+
+	/** Snaps both locations to the nearest node within MaxSnapDistance */
+	bool FindPath(const FVector& Start, const FVector& Goal, float MaxSnapDistance, FClimbPath& OutPath);
+
+	/**
+	 * Searches backwards from any of TargetNodes over the nodes within Radius of Center.
+	 * Stamina drained since the last rest node adds up, resting refills it to MaxStamina,
+	 * so a node's requirement is what the stretch up to the next rest node drains.
+	 */
+	void BuildStaminaField(const TArray<int32>& TargetNodes, const FVector& Center, float MaxStamina, float Radius, FClimbStaminaField& OutField);
+
+private:
+	struct FOpenNode
+	{
+		int32 NodeIndex;
+		float CostSoFar;
+		float TotalCost;
+
+		FORCEINLINE bool operator<(const FOpenNode& Other) const { return TotalCost < Other.TotalCost; }
+	};
+
+	void BuildPath(int32 GoalNode, FClimbPath& OutPath) const;
+
+	/** Makes the per node arrays fit the graph and starts a new query id */
+	void BeginQuery();
+
+	const FClimbGraph& Graph;
+
+	TArray<float> CostSoFar;
+	TArray<int32> ParentNodes;
+	TArray<int32> ParentEdges;
+	TArray<uint32> QueryStamps;
+	TArray<FOpenNode> OpenHeap;
+	uint32 QueryId;
+};
+
+struct FClimbPathRequest
+{
+	int32 RequestId;
+	FVector Start;
+	FVector Goal;
+	float MaxSnapDistance;
+};
+
+struct FClimbPathResult
+{
+	int32 RequestId;
+	FClimbPath Path;
+};
+
+struct FClimbStaminaFieldRequest
+{
+	FClimbStaminaFieldKey Key;
+	TArray<int32> TargetNodes;
+	FVector Center;
+	float MaxStamina;
+	float Radius;
+};
+
+/**
+ * Plans requests and builds stamina fields on its own thread with its own FClimbPathPlanner.
+ * Requests are added and results read by the game thread only, the thread sleeps while there is nothing queued.
+ */
+class SECOND_API FClimbPathWorker : public FRunnable
+{
+public:
+	explicit FClimbPathWorker(const TSharedRef<const FClimbGraph, ESPMode::ThreadSafe>& InGraph);
+	virtual ~FClimbPathWorker();
+
+	void AddRequest(const FClimbPathRequest& Request);
+	bool GetResult(FClimbPathResult& OutResult);
+
+	void AddStaminaFieldRequest(const FClimbStaminaFieldRequest& Request);
+	bool GetStaminaField(TSharedPtr<FClimbStaminaField, ESPMode::ThreadSafe>& OutField);
+
+	/* FRunnable */
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	TSharedRef<const FClimbGraph, ESPMode::ThreadSafe> Graph;
+	FClimbPathPlanner Planner;
+
+	TQueue<FClimbPathRequest, EQueueMode::Spsc> Requests;
+	TQueue<FClimbPathResult, EQueueMode::Spsc> Results;
+	TQueue<FClimbStaminaFieldRequest, EQueueMode::Spsc> StaminaFieldRequests;
+	TQueue<TSharedPtr<FClimbStaminaField, ESPMode::ThreadSafe>, EQueueMode::Spsc> StaminaFieldResults;
+
+	FEvent* WakeEvent;
+	FThreadSafeBool bIsStopping;
+	class FRunnableThread* Thread;
+};
@@ -0,0 +1,168 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbProbeSchedulerSubsystem.h"
+#include "GameFramework/Character.h"
+#include "Engine/World.h"
+
+UClimbProbeSchedulerSubsystem::UClimbProbeSchedulerSubsystem()
+{
+	TraceBudgetPerFrame = 400;
+	RemainingBudget = TraceBudgetPerFrame;
+
+	for (int32 Index = 0; Index < (int32)EClimbProbeType::ECP_MAX; ++Index)
+	{
+		ProbeDemand[Index] = 0;
+		LastProbeDemand[Index] = 0;
+	}
+}
+
+int32 UClimbProbeSchedulerSubsystem::GetProbeTraceCost(EClimbProbeType Type)
+{
+	// Line traces each probe issues, see the matching UClimbingComponent condition
+	switch (Type)
+	{
+	case EClimbProbeType::ECP_Maintain:
+		return 2;
+	case EClimbProbeType::ECP_ClimbUp:
+		return 6;
+	case EClimbProbeType::ECP_TurnCorner:
+		return 10;
+	case EClimbProbeType::ECP_StartClimb:
+		return 5;
+	case EClimbProbeType::ECP_GrabFromTop:
+		return 5;
+	default:
+		return 0;
+	}
+}
+
+bool UClimbProbeSchedulerSubsystem::RequestProbe(UClimbingComponent* Climbing, EClimbProbeType Type)
+{
+	const int32 Cost = GetProbeTraceCost(Type);
+	const uint8 TypeBit = 1 << (uint8)Type;
+
+	// Granted while dispatching last frame's deferred probes, already paid for
+	if (Climbing->ClimbProbeGrantMask & TypeBit)
+	{
+		Climbing->ClimbProbeGrantMask &= ~TypeBit;
+		Climbing->ClimbProbeStaleFrames[(int32)Type] = 0;
+		return true;
+	}
+
+	ProbeDemand[(int32)Type] += Cost;
+
+	if (Type == EClimbProbeType::ECP_Maintain || Climbing->CharacterOwner->IsLocallyControlled() || RemainingBudget - GetReservedBudget(Type) >= Cost)
+	{
+		RemainingBudget -= Cost;
+		Climbing->ClimbProbeStaleFrames[(int32)Type] = 0;
+		return true;
+	}
+
+	DeferProbe(Climbing, Type);
+	return false;
+}
+
+int32 UClimbProbeSchedulerSubsystem::GetReservedBudget(EClimbProbeType Type) const
+{
+	// Budget the higher priority probes used last frame and have not asked for yet this frame
+	int32 ReservedBudget = 0;
+	for (int32 Index = 0; Index < (int32)Type; ++Index)
+	{
+		ReservedBudget += FMath::Max(LastProbeDemand[Index] - ProbeDemand[Index], 0);
+	}
+	return ReservedBudget;
+}
+
+void UClimbProbeSchedulerSubsystem::DeferProbe(UClimbingComponent* Climbing, EClimbProbeType Type)
+{
+	++Climbing->ClimbProbeStaleFrames[(int32)Type];
+
+	for (FClimbProbeRequest& Request : DeferredRequests)
+	{
+		if (Request.Climbing == Climbing && Request.Type == Type)
+		{
+			Request.StaleFrames = Climbing->ClimbProbeStaleFrames[(int32)Type];
+			return;
+		}
+	}
+
+	FClimbProbeRequest Request;
+	Request.Climbing = Climbing;
+	Request.Type = Type;
+	Request.StaleFrames = Climbing->ClimbProbeStaleFrames[(int32)Type];
+	DeferredRequests.Add(Request);
+}
+
+void UClimbProbeSchedulerSubsystem::Tick(float DeltaTime)
+{
+	for (int32 Index = 0; Index < (int32)EClimbProbeType::ECP_MAX; ++Index)
+	{
+		LastProbeDemand[Index] = ProbeDemand[Index];
+		ProbeDemand[Index] = 0;
+	}
+
+	RemainingBudget = TraceBudgetPerFrame;
+	ClearProbeGrants();
+	DispatchDeferredProbes();
+}
+
+void UClimbProbeSchedulerSubsystem::ClearProbeGrants()
+{
+	// A grant is for the frame it was dispatched in, one the character didn't ask for again is dropped
+	for (const TWeakObjectPtr<UClimbingComponent>& GrantedClimbing : GrantedClimbings)
+	{
+		if (UClimbingComponent* Climbing = GrantedClimbing.Get())
+		{
+			Climbing->ClimbProbeGrantMask = 0;
+		}
+	}
+
+	GrantedClimbings.Reset();
+}
+
+void UClimbProbeSchedulerSubsystem::DispatchDeferredProbes()
+{
+	DeferredRequests.Sort([](const FClimbProbeRequest& A, const FClimbProbeRequest& B)
+		{
+			if (A.Type != B.Type)
+			{
+				return A.Type < B.Type;
+			}
+			return A.StaleFrames > B.StaleFrames;
+		});
+
+	TArray<FClimbProbeRequest> StillDeferredRequests;
+	for (const FClimbProbeRequest& Request : DeferredRequests)
+	{
+		UClimbingComponent* Climbing = Request.Climbing.Get();
+		if (Climbing == nullptr)
+		{
+			continue;
+		}
+
+		const int32 Cost = GetProbeTraceCost(Request.Type);
+		if (RemainingBudget >= Cost)
+		{
+			RemainingBudget -= Cost;
+			Climbing->ClimbProbeGrantMask |= 1 << (uint8)Request.Type;
+			GrantedClimbings.AddUnique(Request.Climbing);
+		}
+		else
+		{
+			// Stays stale, keeps its place by age when the character asks again
+			StillDeferredRequests.Add(Request);
+		}
+	}
+
+	DeferredRequests = MoveTemp(StillDeferredRequests);
+}
+
+bool UClimbProbeSchedulerSubsystem::IsTickable() const
+{
+	return !IsTemplate() && GetWorld() != nullptr && GetWorld()->IsGameWorld();
+}
+
+TStatId UClimbProbeSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbProbeSchedulerSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ClimbingComponent.h"
+#include "ClimbProbeSchedulerSubsystem.generated.h"
+
+struct FClimbProbeRequest
+{
+	TWeakObjectPtr<UClimbingComponent> Climbing;
+	EClimbProbeType Type;
+	int32 StaleFrames;
+};
+
+/**
+ * Shares one per-frame trace budget between the climb probes of every UClimbingComponent.
+ * Maintain probes and locally controlled characters always run. Other probes run right away while
+ * the budget minus what higher priority probes used last frame allows, otherwise they are deferred.
+ * Deferred probes are granted at the start of the next frame, highest priority and oldest first,
+ * and are reported stale to their component until then. A grant not used in that frame is dropped.
+ */
+UCLASS()
+class SECOND_API UClimbProbeSchedulerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UClimbProbeSchedulerSubsystem();
+
+	/** Traces all climb probes may issue per frame */
+	int32 TraceBudgetPerFrame;
+
+	/** Returns true when the probe may run now. A false return means the probe is deferred */
+	bool RequestProbe(UClimbingComponent* Climbing, EClimbProbeType Type);
+
+	static int32 GetProbeTraceCost(EClimbProbeType Type);
+
+	/* FTickableGameObject */
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	void ClearProbeGrants();
+	void DispatchDeferredProbes();
+	int32 GetReservedBudget(EClimbProbeType Type) const;
+	void DeferProbe(UClimbingComponent* Climbing, EClimbProbeType Type);
+
+	int32 RemainingBudget;
+
+	/** Traces requested per probe type this frame and last frame, to reserve budget for higher priorities */
+	int32 ProbeDemand[(int32)EClimbProbeType::ECP_MAX];
+	int32 LastProbeDemand[(int32)EClimbProbeType::ECP_MAX];
+
+	TArray<FClimbProbeRequest> DeferredRequests;
+
+	/** Components holding a grant mask set this frame */
+	TArray<TWeakObjectPtr<UClimbingComponent>> GrantedClimbings;
+};
@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbSignificanceSubsystem.h"
+#include "ClimbingComponent.h"
+#include "GameFramework/Character.h"
+#include "SignificanceManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+const FName UClimbSignificanceSubsystem::SignificanceTag(TEXT("Climbing"));
+
+UClimbSignificanceSubsystem::UClimbSignificanceSubsystem()
+{
+	TraceBudgetPerFrame = 400;
+	FullProbeTraceCost = 20;
+}
+
+void UClimbSignificanceSubsystem::Tick(float DeltaTime)
+{
+	USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld());
+	if (SignificanceManager == nullptr)
+	{
+		return;
+	}
+
+	// Every player's view counts, a dedicated server has no local camera
+	TArray<FTransform> Viewpoints;
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (APlayerController* PlayerController = Iterator->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			Viewpoints.Add(FTransform(ViewRotation, ViewLocation));
+		}
+	}
+
+	SignificanceManager->Update(Viewpoints);
+	UpdateClimbLOD();
+}
+
+void UClimbSignificanceSubsystem::UpdateClimbLOD()
+{
+	USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld());
+
+	TArray<USignificanceManager::FManagedObjectInfo*> ManagedObjects = SignificanceManager->GetManagedObjects(SignificanceTag);
+	ManagedObjects.Sort([](const USignificanceManager::FManagedObjectInfo& A, const USignificanceManager::FManagedObjectInfo& B)
+		{
+			return A.GetSignificance() > B.GetSignificance();
+		});
+
+	int32 RemainingBudget = TraceBudgetPerFrame;
+	for (USignificanceManager::FManagedObjectInfo* ManagedObject : ManagedObjects)
+	{
+		UClimbingComponent* Climbing = Cast<UClimbingComponent>(ManagedObject->GetObject());
+		if (Climbing == nullptr)
+		{
+			continue;
+		}
+
+		const int32 ReducedProbeTraceCost = FMath::Max(FullProbeTraceCost / FMath::Max(Climbing->ReducedClimbProbeInterval, 1), 1);
+
+		EClimbLOD ClimbLOD = EClimbLOD::ECL_None;
+		if (Climbing->CharacterOwner->IsLocallyControlled())
+		{
+			// The player's own character always gets the full probe pass
+			ClimbLOD = EClimbLOD::ECL_Full;
+		}
+		else if (ManagedObject->GetSignificance() >= Climbing->FullClimbLODSignificance && RemainingBudget >= FullProbeTraceCost)
+		{
+			ClimbLOD = EClimbLOD::ECL_Full;
+		}
+		else if (ManagedObject->GetSignificance() > 0.f && RemainingBudget >= ReducedProbeTraceCost)
+		{
+			ClimbLOD = EClimbLOD::ECL_Reduced;
+		}
+
+		if (ClimbLOD == EClimbLOD::ECL_Full)
+		{
+			RemainingBudget -= FullProbeTraceCost;
+		}
+		else if (ClimbLOD == EClimbLOD::ECL_Reduced)
+		{
+			RemainingBudget -= ReducedProbeTraceCost;
+		}
+
+		Climbing->SetClimbLOD(ClimbLOD);
+	}
+}
+
+bool UClimbSignificanceSubsystem::IsTickable() const
+{
+	return !IsTemplate() && GetWorld() != nullptr && GetWorld()->IsGameWorld();
+}
+
+TStatId UClimbSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbSignificanceSubsystem, STATGROUP_Tickables);
+}
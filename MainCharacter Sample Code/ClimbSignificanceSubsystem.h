@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ClimbSignificanceSubsystem.generated.h"
+
+/**
+ * Drives the significance manager for climbing characters and hands out climb probe LODs.
+ * Characters are visited from the most significant down, each takes its probe cost from the
+ * per-frame trace budget at the best LOD that still fits.
+ */
+UCLASS()
+class SECOND_API UClimbSignificanceSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UClimbSignificanceSubsystem();
+
+	static const FName SignificanceTag;
+
+	/** Traces all climb probes may issue per frame */
+	int32 TraceBudgetPerFrame;
+
+	/** Traces one character's full probe pass costs */
+	int32 FullProbeTraceCost;
+
+	/* FTickableGameObject */
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	void UpdateClimbLOD();
+};
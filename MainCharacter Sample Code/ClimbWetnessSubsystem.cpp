@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbWetnessSubsystem.h"
+#include "Engine/World.h"
+
+UClimbWetnessSubsystem::UClimbWetnessSubsystem()
+{
+	CellSize = 1000.f;
+	DryingRate = 1.f / 180.f;
+	MaxCellUpdatesPerTick = 2048;
+}
+
+int32 UClimbWetnessSubsystem::RegisterVolume(const FBox& Bounds, float WettingRate, bool bIsRaining)
+{
+	int32 VolumeIndex;
+	if (FreeVolumeIndices.Num() > 0)
+	{
+		VolumeIndex = FreeVolumeIndices.Pop();
+	}
+	else
+	{
+		VolumeIndex = Volumes.AddDefaulted();
+	}
+
+	FClimbWetnessVolumeData& Volume = Volumes[VolumeIndex];
+	Volume.Bounds = Bounds.ShiftBy(GetOriginOffset());
+	Volume.WettingRate = WettingRate;
+	Volume.bIsRaining = bIsRaining;
+	Volume.bIsValid = true;
+
+	if (bIsRaining)
+	{
+		QueueVolumeUpdate(Volume.Bounds);
+	}
+
+	return VolumeIndex;
+}
+
+void UClimbWetnessSubsystem::SetVolumeRaining(int32 VolumeIndex, bool bIsRaining)
+{
+	if (!Volumes.IsValidIndex(VolumeIndex) || !Volumes[VolumeIndex].bIsValid || Volumes[VolumeIndex].bIsRaining == bIsRaining)
+	{
+		return;
+	}
+
+	Volumes[VolumeIndex].bIsRaining = bIsRaining;
+	QueueVolumeUpdate(Volumes[VolumeIndex].Bounds);
+}
+
+void UClimbWetnessSubsystem::UnregisterVolume(int32 VolumeIndex)
+{
+	if (!Volumes.IsValidIndex(VolumeIndex) || !Volumes[VolumeIndex].bIsValid)
+	{
+		return;
+	}
+
+	FClimbWetnessVolumeData& Volume = Volumes[VolumeIndex];
+	if (Volume.bIsRaining)
+	{
+		QueueVolumeUpdate(Volume.Bounds);
+	}
+
+	Volume.bIsValid = false;
+	FreeVolumeIndices.Add(VolumeIndex);
+}
+
+FIntPoint UClimbWetnessSubsystem::GetCellCoord(const FVector& Location) const
+{
+	return GetAbsoluteCellCoord(Location + GetOriginOffset());
+}
+
+float UClimbWetnessSubsystem::SampleWetness(const FVector& Location) const
+{
+	const FClimbWetnessCell* Cell = Cells.Find(GetCellCoord(Location));
+	if (Cell == nullptr)
+	{
+		return 0.f;
+	}
+
+	return Cell->GetWetness(GetWorld()->GetTimeSeconds());
+}
+
+void UClimbWetnessSubsystem::Tick(float DeltaTime)
+{
+	const float Time = GetWorld()->GetTimeSeconds();
+	int32 CellBudget = MaxCellUpdatesPerTick;
+
+	// Walk the queued footprints row by row, carrying on next tick where the budget ran out
+	while (CellBudget > 0 && PendingUpdates.Num() > 0)
+	{
+		FClimbWetnessUpdate& Update = PendingUpdates[0];
+		UpdateCell(Update.Cursor, Time);
+		--CellBudget;
+
+		if (++Update.Cursor.Y > Update.Max.Y)
+		{
+			Update.Cursor.Y = Update.Min.Y;
+			if (++Update.Cursor.X > Update.Max.X)
+			{
+				PendingUpdates.RemoveAt(0);
+			}
+		}
+	}
+}
+
+bool UClimbWetnessSubsystem::IsTickable() const
+{
+	return !IsTemplate() && GetWorld() != nullptr && GetWorld()->IsGameWorld();
+}
+
+TStatId UClimbWetnessSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbWetnessSubsystem, STATGROUP_Tickables);
+}
+
+void UClimbWetnessSubsystem::QueueVolumeUpdate(const FBox& Bounds)
+{
+	FClimbWetnessUpdate Update;
+	Update.Min = GetAbsoluteCellCoord(Bounds.Min);
+	Update.Max = GetAbsoluteCellCoord(Bounds.Max);
+	Update.Cursor = Update.Min;
+	PendingUpdates.Add(Update);
+}
+
+void UClimbWetnessSubsystem::UpdateCell(const FIntPoint& CellCoord, float Time)
+{
+	// Overlapping rain adds up
+	const float CellMinX = CellCoord.X * CellSize;
+	const float CellMinY = CellCoord.Y * CellSize;
+	float WettingRate = 0.f;
+	for (const FClimbWetnessVolumeData& Volume : Volumes)
+	{
+		if (Volume.bIsValid && Volume.bIsRaining
+			&& Volume.Bounds.Min.X < CellMinX + CellSize && Volume.Bounds.Max.X >= CellMinX
+			&& Volume.Bounds.Min.Y < CellMinY + CellSize && Volume.Bounds.Max.Y >= CellMinY)
+		{
+			WettingRate += Volume.WettingRate;
+		}
+	}
+
+	FClimbWetnessCell* Cell = Cells.Find(CellCoord);
+	if (Cell == nullptr)
+	{
+		if (WettingRate <= 0.f)
+		{
+			return;
+		}
+
+		Cell = &Cells.Add(CellCoord);
+		Cell->Wetness = 0.f;
+		Cell->UpdateTime = Time;
+	}
+
+	Cell->Wetness = Cell->GetWetness(Time);
+	Cell->UpdateTime = Time;
+
+	if (WettingRate <= 0.f && Cell->Wetness <= 0.f)
+	{
+		Cells.Remove(CellCoord);
+		return;
+	}
+
+	Cell->WetnessRate = WettingRate > 0.f ? WettingRate : -DryingRate;
+}
+
+FIntPoint UClimbWetnessSubsystem::GetAbsoluteCellCoord(const FVector& AbsoluteLocation) const
+{
+	return FIntPoint(FMath::FloorToInt(AbsoluteLocation.X / CellSize), FMath::FloorToInt(AbsoluteLocation.Y / CellSize));
+}
+
+FVector UClimbWetnessSubsystem::GetOriginOffset() const
+{
+	const UWorld* World = GetWorld();
+	return World != nullptr ? FVector(World->OriginLocation) : FVector(0.f, 0.f, 0.f);
+}
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ClimbWetnessSubsystem.generated.h"
+
+/** Rain area registered by AWeatherVolume */
+struct FClimbWetnessVolumeData
+{
+	FBox Bounds;
+
+	/** Wetness per second while it rains */
+	float WettingRate;
+	bool bIsRaining;
+	bool bIsValid;
+};
+
+/** Surface wetness of one grid cell, linear between updates */
+struct FClimbWetnessCell
+{
+	float Wetness;
+	float WetnessRate;
+	float UpdateTime;
+
+	FORCEINLINE float GetWetness(float Time) const { return FMath::Clamp(Wetness + WetnessRate * (Time - UpdateTime), 0.f, 1.f); }
+};
+
+/** Cells of a volume's footprint still waiting for their new wetting rate */
+struct FClimbWetnessUpdate
+{
+	FIntPoint Min;
+	FIntPoint Max;
+	FIntPoint Cursor;
+};
+
+/**
+ * Coarse XY grid of surface wetness (0 dry to 1 soaked), for slipping on walls in the rain.
+ * A cell only stores its wetness and how fast it changes, so sampling is one hash lookup and
+ * nothing has to be stepped every frame. When a weather volume starts or stops raining, its cells get
+ * their new rate a few thousand per tick (MaxCellUpdatesPerTick), so a map wide storm doesn't hitch.
+ * Only rained on cells are stored, dried out ones are dropped the next time their area is updated.
+ * Cells and volume bounds are in absolute coordinates so world origin rebasing doesn't move the rain.
+ */
+UCLASS()
+class SECOND_API UClimbWetnessSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UClimbWetnessSubsystem();
+
+	/** Returns the handle used to change or unregister the volume */
+	int32 RegisterVolume(const FBox& Bounds, float WettingRate, bool bIsRaining);
+	void SetVolumeRaining(int32 VolumeIndex, bool bIsRaining);
+	void UnregisterVolume(int32 VolumeIndex);
+
+	FIntPoint GetCellCoord(const FVector& Location) const;
+
+	/** 0 outside every rained on cell */
+	float SampleWetness(const FVector& Location) const;
+
+	/** Width of a grid cell (cm) */
+	float CellSize;
+
+	/** Wetness per second lost by a cell it doesn't rain on */
+	float DryingRate;
+
+	int32 MaxCellUpdatesPerTick;
+
+	/* FTickableGameObject */
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	void QueueVolumeUpdate(const FBox& Bounds);
+	void UpdateCell(const FIntPoint& CellCoord, float Time);
+	FIntPoint GetAbsoluteCellCoord(const FVector& AbsoluteLocation) const;
+
+	/** World origin location, world to absolute coordinates */
+	FVector GetOriginOffset() const;
+
+	TArray<FClimbWetnessVolumeData> Volumes;
+	TArray<int32> FreeVolumeIndices;
+	TMap<FIntPoint, FClimbWetnessCell> Cells;
+
+	/** Oldest first */
+	TArray<FClimbWetnessUpdate> PendingUpdates;
+};
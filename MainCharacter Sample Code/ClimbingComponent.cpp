@@ -0,0 +1,2956 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbingComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Controller.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "MainMovementComponent.h"
+#include "SignificanceManager.h"
+#include "ClimbSignificanceSubsystem.h"
+#include "ClimbProbeSchedulerSubsystem.h"
+#include "ClimbWetnessSubsystem.h"
+#include "MainMovementSnapshot.h"
+
+UClimbingComponent::UClimbingComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+
+	CharacterOwner = nullptr;
+	StaminaComponent = nullptr;
+	MainMovementComponent = nullptr;
+	GliderMeshComponent = nullptr;
+
+	/* Status */
+	MovementStatus = EMovementStatus::EMS_Normal;
+	ClimbStatus = EClimbStatus::ECS_NormalClimb;
+
+	/* Desired Movement */
+	DesiredMoveDirection = FVector2D(0.f, 0.f);
+	DesiredMoveYaw = 0.f;
+	ClimbMoveInput = FVector2D(0.f, 0.f);
+	bWantsToSprint = false;
+	bIsBracing = false;
+
+	/* Normal & Climbing */
+	bIsRightEdge = false;
+	bIsLeftEdge = false;
+	bIsFoothold = false;
+	bIsBottomEdge = false;
+	bIsTopEdge = false;
+	bIsGround = false;
+
+	/* for Start Climb */
+	bIsCanGrabWall = false;
+	ClimbStartTerm = 0.15f;
+	InitClimbStartTerm = 0.15f;
+
+	/* Climbing */
+	bIsBodyWallFacing = false;
+	NormalVectorBodyWallFacing = FVector(0.0f, 0.0f, 0.0f);
+	BodyWallContactPoint = FVector(0.0f, 0.0f, 0.0f);
+	FootWallContactPoint = FVector(0.0f, 0.0f, 0.0f);
+	bTooFarFromWall = false;
+
+	/* Climbing::Wall Tangent Frame */
+	ClimbFrameForward = FVector(1.0f, 0.0f, 0.0f);
+	ClimbFrameRight = FVector(0.0f, 1.0f, 0.0f);
+	ClimbFrameUp = FVector(0.0f, 0.0f, 1.0f);
+	ClimbAlignSpeed = 10.f;
+	ClimbCeilingThreshold = 0.2f;
+	ClimbUpMinWallUpZ = 0.7f;
+
+	/* Climbing::Movement Base */
+	ClimbBaseBoneName = NAME_None;
+	ClimbBaseTransform = FTransform::Identity;
+	LocalNormalVectorBodyWallFacing = FVector(0.0f, 0.0f, 0.0f);
+	LocalBodyWallContactPoint = FVector(0.0f, 0.0f, 0.0f);
+	LocalFootWallContactPoint = FVector(0.0f, 0.0f, 0.0f);
+	LocalClimbProbeLocation = FVector(0.0f, 0.0f, 0.0f);
+	ClimbBaseRetraceTolerance = 1.f;
+	bClimbBaseRetrace = true;
+
+	/* Climbing::Surface */
+	ClimbSurfaceModifiers.Add(SurfaceType1, FClimbSurfaceModifier(1.0f, 1.0f));	// Rock
+	ClimbSurfaceModifiers.Add(SurfaceType2, FClimbSurfaceModifier(0.7f, 1.5f));	// Wet Rock
+	ClimbSurfaceModifiers.Add(SurfaceType3, FClimbSurfaceModifier(0.5f, 2.0f));	// Ice
+	ClimbSurfaceModifiers.Add(SurfaceType4, FClimbSurfaceModifier(1.2f, 0.8f));	// Wood
+	ClimbSpeed = 0.f;
+
+	/* Climbing::Wetness */
+	ClimbSurfaceWetness = 0.f;
+	WetClimbSpeedMultiplier = 0.6f;
+	WetSlipInterval = 3.f;
+	WetSlipTimer = 0.f;
+	WetSlipDuration = 0.4f;
+	LastWetSlipTime = -1.f;
+	WetnessSubsystem = nullptr;
+
+	/* Climbing::Hand & Foot IK */
+	ClimbIKHandHeight = 60.f;
+	ClimbIKHandSpacing = 25.f;
+	ClimbIKFootHeight = 80.f;
+	ClimbIKFootSpacing = 15.f;
+	ClimbIKWallOffset = 3.f;
+	ClimbIKInterpSpeed = 15.f;
+	for (int32 Hand = 0; Hand < 2; ++Hand)
+	{
+		ClimbIKHandContacts[Hand] = FVector(0.0f, 0.0f, 0.0f);
+		bClimbIKHandContacts[Hand] = false;
+	}
+
+	/* Climbing::Start Climb Prediction */
+	ClimbPredictionTime = 0.5f;
+	ClimbPredictionLeadTime = 0.1f;
+	ClimbPredictionVelocityTolerance = 50.f;
+	InitClimbPredictionRetraceTerm = 0.1f;
+	ClimbPredictionRetraceTerm = 0.f;
+	bHasPredictedClimbContact = false;
+	bIsClimbContactImminent = false;
+	PredictedClimbContactTime = 0.f;
+	PredictedClimbVelocity = FVector(0.0f, 0.0f, 0.0f);
+
+	/* Climbing::Turn Corner */
+	bIsTurnCornerRightEdge = false;
+	bIsTurnCornerLeftEdge = false;
+	bCanRightTurnInsideCorner = false;
+	bCanLeftTurnInsideCorner = false;
+	bCanRightTurnOutsideCorner = false;
+	bCanLeftTurnOutsideCorner = false;
+
+	/* Climbing::Dash Jump*/
+	bIsLeftDashing = false;
+	bIsRightDashing = false;
+
+
+	/* Climb Up*/
+	bClimbUpEnoughSpace = false;
+	bClimbUpTraceGround = false;
+	ClimbUpGroundZ = 0.f;
+
+	/* Climb Down*/
+	NormalVectorGrabWallFromTop = FVector(0.0f, 0.0f, 0.0f);
+	bCanGrabWallFromTop = false;
+	ClimbDownSpeed = 150.f;
+	ClimbDownLedgeDepth = 184.f;
+	ClimbDownTargetZ = 0.f;
+	ClimbDownGrabTime = -1.f;
+
+	/* Front Flip */
+	FrontFlipEndTime = -1.f;
+	bIsLowerRightEdge = false;
+	bIsLowerLeftEdge = false;
+	LastGroundProbeFrame = 0;
+	LastGrabFromTopProbeFrame = 0;
+
+	/* Jumping */
+	bIsJumping = false;
+
+	/* Wall Jump */
+	ClimbCoyoteTime = 0.1f;
+	LastClimbStopTime = -1.f;
+	WallJumpGravityEndTime = -1.f;
+
+	/* Gliding */
+	GlidingCoolTime = 0.3f;
+	InitGlidingCoolTime = 0.3f;
+
+	/* for Stamina Status */
+	bIsStaminaConsumSprinting = false;
+	InitSprintJumpStaminaConsumDuration = 1.0f;
+	SprintJumpStaminaConsumDuration = 1.0f;
+
+	/* for current Stamina */
+	SprintStaminaConsumption = 20.f;
+	ClimbingStaminaConsumption = 5.f;
+	GlidingStaminaConsumption = 5.f;
+	FrontFlipStaminaConsumption = 10.f;
+	ClimbDashStaminaConsumption = 15.f;
+	WallJumpStaminaConsumption = 20.f;
+
+	/* Debug */
+	bDrawDebugLine = false;
+
+	/* Climb LOD */
+	ClimbLODMaxDistance = 6000.f;
+	FullClimbLODSignificance = 0.7f;
+	ReducedClimbProbeInterval = 4;
+	ClimbLOD = EClimbLOD::ECL_Full;
+	ClimbProbeFrameCounter = 0;
+	ClimbProbeDeltaTime = 0.f;
+
+	/* Climb Probe Schedule */
+	ClimbProbeGrantMask = 0;
+	for (int32 Index = 0; Index < (int32)EClimbProbeType::ECP_MAX; ++Index)
+	{
+		ClimbProbeStaleFrames[Index] = 0;
+	}
+
+	/* Climb Clock */
+	ClimbTime = 0.f;
+	ClimbFrameCounter = 0;
+
+	/* Climb Probe Record & Replay */
+	ClimbProbeReplayTolerance = 1.f;
+	ClimbProbeRecordFrame = nullptr;
+	ClimbProbeReplayFrame = nullptr;
+	ClimbProbeReplayTraceIndex = 0;
+	ClimbProbeReplayGateIndex = 0;
+	ClimbProbeReplayMisses = 0;
+}
+
+void UClimbingComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	CharacterOwner = Cast<ACharacter>(GetOwner());
+	if (CharacterOwner != nullptr)
+	{
+		MainMovementComponent = Cast<UMainMovementComponent>(CharacterOwner->GetCharacterMovement());
+	}
+}
+
+void UClimbingComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Any character can take this component, it brings its own stamina when the character has none
+	StaminaComponent = GetOwner()->FindComponentByClass<UStaminaComponent>();
+	if (StaminaComponent == nullptr)
+	{
+		StaminaComponent = NewObject<UStaminaComponent>(GetOwner(), TEXT("StaminaComponent"));
+		StaminaComponent->RegisterComponent();
+	}
+
+	// Stamina drains with the rate this component sets in the same frame
+	StaminaComponent->AddTickPrerequisiteComponent(this);
+
+	ClimbSpeed = CharacterOwner->GetCharacterMovement()->MaxFlySpeed;
+	UpdateClimbFrame();
+	WetnessSubsystem = GetWorld()->GetSubsystem<UClimbWetnessSubsystem>();
+
+	if (GliderMeshComponent != nullptr)
+	{
+		GliderMeshComponent->SetVisibility(false);
+	}
+
+	if (USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld()))
+	{
+		SignificanceManager->RegisterObject(this, UClimbSignificanceSubsystem::SignificanceTag,
+			[this](USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+			{
+				return CalculateClimbSignificance(Viewpoint);
+			});
+	}
+}
+
+void UClimbingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld()))
+	{
+		SignificanceManager->UnregisterObject(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UClimbingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	MovementManager(DeltaTime);
+	StaminaManager(DeltaTime);
+}
+
+void UClimbingComponent::ApplyWorldOffset(const FVector& InOffset, bool bWorldShift)
+{
+	Super::ApplyWorldOffset(InOffset, bWorldShift);
+
+	// Only locations move, wall normals (NormalVectorGrabWallFromTop too) and the climb frame don't
+	BodyWallContactPoint += InOffset;
+	FootWallContactPoint += InOffset;
+	ClimbUpGroundZ += InOffset.Z;
+	ClimbDownTargetZ += InOffset.Z;
+
+	// A base is shifted along with the world, without one the local probe results are world space
+	if (ClimbBase.IsValid())
+	{
+		ClimbBaseTransform.AddToTranslation(InOffset);
+	}
+	else
+	{
+		LocalBodyWallContactPoint += InOffset;
+		LocalFootWallContactPoint += InOffset;
+		LocalClimbProbeLocation += InOffset;
+	}
+
+	// Hand traces still in flight were traced before the shift, drop them
+	for (int32 Hand = 0; Hand < 2; ++Hand)
+	{
+		ClimbIKHandTraceHandles[Hand] = FTraceHandle();
+		ClimbIKHandContacts[Hand] += InOffset;
+	}
+
+	ClimbIKTargets.LeftHandLocation += InOffset;
+	ClimbIKTargets.RightHandLocation += InOffset;
+	ClimbIKTargets.LeftFootLocation += InOffset;
+	ClimbIKTargets.RightFootLocation += InOffset;
+}
+
+void UClimbingComponent::MovementManager(float DeltaTime)
+{
+	ClimbTime += DeltaTime;
+	++ClimbFrameCounter;
+	ClimbDeadlineManager();
+
+	UpdateClimbFrame();
+	SprintManager();
+
+	// Carry the character and its wall probes along with a moving wall first, then follow the wall's curve
+	ClimbBaseManager();
+	AlignCharacterToWall(DeltaTime);
+	ClimbMovementManager();
+
+	// Managing MovementStatus Transition, as often as the climb LOD allows
+	if (ClimbLODCondition(DeltaTime))
+	{
+		bClimbBaseRetrace = ClimbBaseRetraceCondition();
+		MovementStatusManager(ClimbProbeDeltaTime, true);
+		ClimbProbeDeltaTime = 0.f;
+
+		// Hand rays go out in the same batch as the probes
+		if (!IsReplayingClimbProbes())
+		{
+			RequestClimbIKTraces();
+		}
+	}
+	else if (GetClimbLOD() == EClimbLOD::ECL_None)
+	{
+		// No probes, the transitions that need no trace (exhaustion, landing, gliding out of stamina) still run
+		MovementStatusManager(DeltaTime, false);
+	}
+
+	// Limb targets from the cached contacts, every frame. Re-simulated frames aren't drawn
+	if (!IsReplayingClimbProbes())
+	{
+		ClimbIKManager(DeltaTime);
+	}
+}
+
+void UClimbingComponent::StaminaManager(float DeltaTime)
+{
+	// Managing StaminaStatus Transition
+	StaminaStatusManager(DeltaTime);
+
+	// Managing how fast the current movement drains stamina
+	StaminaDrainManager();
+}
+
+void UClimbingComponent::SetDesiredMoveDirection(FVector2D Direction, float ReferenceYaw)
+{
+	DesiredMoveDirection = Direction;
+	DesiredMoveYaw = ReferenceYaw;
+}
+
+void UClimbingComponent::SetDesiredWorldDirection(FVector WorldDirection)
+{
+	if (GetMovementStatus() == EMovementStatus::EMS_Climbing)
+	{
+		DesiredMoveDirection.X = FVector::DotProduct(WorldDirection, CharacterOwner->GetActorUpVector());
+		DesiredMoveDirection.Y = FVector::DotProduct(WorldDirection, CharacterOwner->GetActorRightVector());
+	}
+	else
+	{
+		const FVector Horizontal = FVector(WorldDirection.X, WorldDirection.Y, 0.f);
+		DesiredMoveDirection = FVector2D(FMath::Min(Horizontal.Size(), 1.f), 0.f);
+		DesiredMoveYaw = Horizontal.Rotation().Yaw;
+	}
+}
+
+void UClimbingComponent::SetWantsToSprint(bool bSprint)
+{
+	bWantsToSprint = bSprint;
+}
+
+void UClimbingComponent::SetBracing(bool bBrace)
+{
+	bIsBracing = bBrace;
+}
+
+void UClimbingComponent::Jump()
+{
+	CharacterOwner->Jump();
+	bIsJumping = true;
+}
+
+void UClimbingComponent::ReleaseWall()
+{
+	if (GetMovementStatus() == EMovementStatus::EMS_Climbing && !(GetClimbStatus() == EClimbStatus::ECS_DashJump) && !(GetClimbStatus() == EClimbStatus::ECS_TurnCorner))
+	{
+		ResetUprightRotation();
+		CharacterOwner->GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Falling);
+		CharacterOwner->GetCharacterMovement()->bOrientRotationToMovement = true;
+		SetMovementStatus(EMovementStatus::EMS_HaltClimbing);
+	}
+}
+
+EClimbStaminaQueryResult UClimbingComponent::QueryRequiredStamina(FVector TargetLedge, float& RequiredStamina)
+{
+	UClimbNavigationSubsystem* NavigationSubsystem = GetWorld()->GetSubsystem<UClimbNavigationSubsystem>();
+	if (!NavigationSubsystem)
+	{
+		RequiredStamina = 0.f;
+		return EClimbStaminaQueryResult::ECSQ_NoGraph;
+	}
+
+	return NavigationSubsystem->QueryRequiredStamina(CharacterOwner->GetActorLocation(), TargetLedge, StaminaComponent->MaxStamina, RequiredStamina);
+}
+
+EClimbActionResult UClimbingComponent::JumpAction()
+{
+	// Input arrives between ticks
+	UpdateClimbFrame();
+
+	if (ClimbDashJumpCondition())
+	{
+		ClimbDashJump();
+		return EClimbActionResult::PerformedMontage;
+	}
+	else if (WallJumpCondition())
+	{
+		WallJump();
+		return EClimbActionResult::PerformedMontage;
+	}
+	else if (GlidingCondition() && GetMovementStatus() != EMovementStatus::EMS_Gliding && StaminaComponent->CurrentStamina > 0)
+	{
+		if (GlidingCoolTime <= 0)
+		{
+			StartGliding();
+			return EClimbActionResult::PerformedMontage;
+		}
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_Gliding)
+	{
+		StopGliding();
+		return EClimbActionResult::Performed;
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_ClimbUp)
+	{
+
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_ClimbDown)
+	{
+
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_FrontFlip)
+	{
+
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_Climbing && GetClimbStatus() != EClimbStatus::ECS_NormalClimb)
+	{
+		// Pressed during a dash or corner turn, stays buffered until it's a normal climb again
+	}
+	else 
+	{
+		if (FrontFlipCondition())
+		{
+			FrontFlip();
+			return EClimbActionResult::PerformedMontage;
+		}
+		else
+		{
+			Jump();
+			return EClimbActionResult::Performed;
+		}
+	}
+
+	return EClimbActionResult::None;
+}
+
+EClimbActionResult UClimbingComponent::GrabWallFromTopAction()
+{
+	UpdateClimbFrame();
+
+	if (GrabWallFromTopCondition())
+	{
+		GrabWallFromTop();
+		return EClimbActionResult::PerformedMontage;
+	}
+
+	return EClimbActionResult::None;
+}
+
+void UClimbingComponent::SprintManager()
+{
+	// Sprinting is decided from the desired direction every tick, on the ground only
+	if (GetMovementStatus() == EMovementStatus::EMS_Sprinting)
+	{
+		SetMovementStatus(EMovementStatus::EMS_Normal);
+	}
+
+	if (CharacterOwner->GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Flying || CharacterOwner->GetMovementComponent()->IsFalling())
+	{
+		return;
+	}
+
+	bIsStaminaConsumSprinting = false;
+
+	if (bWantsToSprint && !StaminaComponent->IsExhausted() &&
+		(FMath::Abs(DesiredMoveDirection.X) >= 0.3f || FMath::Abs(DesiredMoveDirection.Y) >= 0.3f))
+	{
+		SetMovementStatus(EMovementStatus::EMS_Sprinting);
+		bIsStaminaConsumSprinting = true;
+	}
+}
+
+void UClimbingComponent::ClimbMovementManager()
+{
+	ClimbMoveInput = DesiredMoveDirection;
+
+	if (CharacterOwner->GetCharacterMovement()->MovementMode != EMovementMode::MOVE_Flying || GetMovementStatus() != EMovementStatus::EMS_Climbing)
+	{
+		return;
+	}
+
+	bIsStaminaConsumSprinting = false;
+
+	// One grid lookup per climbing tick
+	ClimbSurfaceWetness = WetnessSubsystem != nullptr ? WetnessSubsystem->SampleWetness(CharacterOwner->GetActorLocation()) : 0.f;
+
+	// Bracing and the top edge also stop the climbing stamina drain, the other edges only block the movement
+	FVector2D ClimbMove = DesiredMoveDirection;
+	if (bIsBracing)
+	{
+		ClimbMove = FVector2D(0.f, 0.f);
+		ClimbMoveInput = FVector2D(0.f, 0.f);
+	}
+
+	// A slip slides down the wall whatever the input, off it onto the ground like climbing down
+	if (IsWetSlipping())
+	{
+		ClimbMove = FVector2D(-1.f, 0.f);
+		ClimbMoveInput = FVector2D(-1.f, 0.f);
+	}
+
+	if (bIsTopEdge && ClimbMove.X > 0.f)
+	{
+		ClimbMove.X = 0.f;
+		ClimbMoveInput.X = 0.f;
+	}
+
+	if (bIsBottomEdge && ClimbMove.X < 0.f)
+	{
+		ClimbMove.X = 0.f;
+	}
+
+	if (bIsRightEdge && ClimbMove.Y > 0.f)
+	{
+		ClimbMove.Y = 0.f;
+	}
+
+	if (bIsLeftEdge && ClimbMove.Y < 0.f)
+	{
+		ClimbMove.Y = 0.f;
+	}
+
+	CharacterOwner->GetCharacterMovement()->MaxFlySpeed = ClimbSpeed * ClimbSurfaceModifier.ClimbSpeedMultiplier * FMath::Lerp(1.f, WetClimbSpeedMultiplier, ClimbSurfaceWetness);
+	CharacterOwner->AddMovementInput(CharacterOwner->GetActorUpVector(), ClimbMove.X);
+	CharacterOwner->AddMovementInput(CharacterOwner->GetActorRightVector(), ClimbMove.Y);
+}
+
+void UClimbingComponent::StaminaDrainManager()
+{
+	float DrainRate = 0.f;
+	float DrainMultiplier = 1.f;
+
+	if (StaminaComponent->GetStaminaStatus() == EStaminaStatus::ESS_Sprinting && CharacterOwner->GetCharacterMovement()->Velocity.Size() > 300.f)
+	{
+		DrainRate = SprintStaminaConsumption;
+	}
+	else if (StaminaComponent->GetStaminaStatus() == EStaminaStatus::ESS_Climbing && ClimbingStaminaDrainCondition())
+	{
+		DrainRate = ClimbingStaminaConsumption;
+		DrainMultiplier = ClimbSurfaceModifier.StaminaMultiplier;
+	}
+	else if (StaminaComponent->GetStaminaStatus() == EStaminaStatus::ESS_Gliding)
+	{
+		DrainRate = GlidingStaminaConsumption;
+	}
+
+	StaminaComponent->StaminaDrainRate = DrainRate;
+	StaminaComponent->StaminaDrainMultiplier = DrainMultiplier;
+}
+
+bool UClimbingComponent::ClimbingStaminaDrainCondition()
+{
+	// Moving along the wall or turning a corner, not pushing against an edge and not dashing
+	if (ClimbMoveInput.X != 0.f || ClimbMoveInput.Y != 0.f || (GetClimbStatus() == EClimbStatus::ECS_TurnCorner))
+	{
+		if (!(ClimbMoveInput.Y > 0 && ClimbMoveInput.X == 0 && bIsRightEdge)
+			&& !(ClimbMoveInput.Y < 0 && ClimbMoveInput.X == 0 && bIsLeftEdge)
+			&& !(ClimbMoveInput.X > 0 && ClimbMoveInput.Y == 0 && bIsTopEdge)
+			&& !(ClimbMoveInput.X < 0 && ClimbMoveInput.Y == 0 && bIsBottomEdge))
+		{
+			if (GetClimbStatus() != EClimbStatus::ECS_DashJump)
+			{
+				return true;
+			}
+		}
+		else if (GetClimbStatus() == EClimbStatus::ECS_TurnCorner)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UClimbingComponent::MovementStatusManager(float DeltaTime, bool bRunProbes)
+{
+	if (GetMovementStatus() == EMovementStatus::EMS_Climbing)
+	{
+		if (GetClimbStatus() == EClimbStatus::ECS_NormalClimb && CharacterOwner->GetMesh()->GetAnimInstance()->Montage_IsPlaying(NULL))
+		{
+			CharacterOwner->StopAnimMontage();
+		}
+
+		if (StaminaComponent->GetStaminaStatus() == EStaminaStatus::ESS_Exhausted && GetClimbStatus() == EClimbStatus::ECS_NormalClimb)
+		{
+			bCanGrabWallFromTop = false;
+			StopClimb();
+		}
+		else if (bRunProbes)
+		{
+			if (ClimbMaintainCondition())
+			{
+				if (!(GetClimbStatus() == EClimbStatus::ECS_TurnCorner))
+				{
+					if (ClimbUpCondition())
+					{
+						// Start Climb Up
+						ClimbUp();
+					}
+					else if(TurnCornerCondition())
+					{
+						// Start Turn Corner
+						TurnCorner();
+					}
+					else if (WetSlipCondition(DeltaTime))
+					{
+						WetSlip();
+					}
+				}
+			}
+			else
+			{
+				StopClimb();
+			}
+
+			AttachCharacterToWall();
+		}
+
+
+		if (GlidingCoolTime > 0)
+		{
+			GlidingCoolTime -= DeltaTime;
+		}
+
+		if (bIsJumping)
+		{
+			bIsJumping = false;
+		}
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_HaltClimbing)
+	{
+		if (CharacterOwner->GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Walking)
+		{
+			SetMovementStatus(EMovementStatus::EMS_Normal);
+		}
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_ClimbUp)
+	{
+		if (bRunProbes)
+		{
+			AttachCharacterToGround();
+		}
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_WallJumping)
+	{
+		if (CharacterOwner->GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Walking)
+		{
+			CharacterOwner->StopAnimMontage();
+			SetMovementStatus(EMovementStatus::EMS_Normal);
+			bIsCanGrabWall = false;
+		}
+		else if (bRunProbes)
+		{
+			if (StartClimbWhileWallJumpCondition(DeltaTime))
+			{
+				StartClimb();
+			}
+
+		}
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_Gliding)
+	{
+		if (StaminaComponent->GetStaminaStatus() != EStaminaStatus::ESS_Exhausted)
+		{
+			if (bRunProbes)
+			{
+				if (EnoughSpaceForGliding())
+				{
+					if (StartClimbWhileGlidingCondition(DeltaTime))
+					{
+						StopGliding();
+						StartClimb();
+					}
+				}
+				else
+				{
+					StopGliding();
+				}
+			}
+		}
+		else
+		{
+			StopGliding();
+		}
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_ClimbDown)
+	{
+		ClimbDownDescent(DeltaTime);
+
+		// The target is checked on its own, it is reached whether or not the grab montage let the wall be grabbed.
+		// A skipped probe frame waits for the next one, no climb LOD never probes and leaves right away
+		const bool bReachedTarget = CharacterOwner->GetActorLocation().Z <= ClimbDownTargetZ;
+		if (bRunProbes && bIsCanGrabWall && ClimbStartEnoughSpaceCondition())
+		{
+			StartClimb();
+			bIsCanGrabWall = false;
+		}
+		else if (bReachedTarget && (bRunProbes || GetClimbLOD() == EClimbLOD::ECL_None))
+		{
+			// Reached the bottom of the ledge without finding a wall to grab
+			bIsCanGrabWall = false;
+			StopClimb();
+		}
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_FrontFlip)
+	{
+
+	}
+	else
+	{
+		if (StaminaComponent->GetStaminaStatus() == EStaminaStatus::ESS_Exhausted)
+		{
+			CharacterOwner->GetCharacterMovement()->MaxWalkSpeed = 100.f;
+		}
+		else
+		{
+			if (GetMovementStatus() == EMovementStatus::EMS_Sprinting)
+			{
+				CharacterOwner->GetCharacterMovement()->MaxWalkSpeed = 1000.f;
+			}
+			else
+			{
+				CharacterOwner->GetCharacterMovement()->MaxWalkSpeed = 500.f;
+			}
+
+			if (bRunProbes && StartClimbAtNormalStatusCondition(DeltaTime))
+			{
+				StartClimb();
+			}
+
+
+			// Opportunistic, keeps the last result while the scheduler defers it
+			if (bRunProbes && ClimbProbeCondition(EClimbProbeType::ECP_GrabFromTop))
+			{
+				SetCanGrabWallFromTopAndNormalVector();
+				LastGrabFromTopProbeFrame = ClimbFrameCounter;
+			}
+
+		}
+
+		if (GlidingCoolTime > 0)
+		{
+			GlidingCoolTime -= DeltaTime;
+		}
+
+		if (bIsJumping)
+		{
+			if (!CharacterOwner->GetCharacterMovement()->IsFalling())
+			{
+				bIsJumping = false;
+			}
+		}
+	}
+
+}
+
+void UClimbingComponent::StaminaStatusManager(float DeltaTime)
+{
+	// Managing Stamina Status by referring to Movement and Stamina Status
+
+	if ((StaminaComponent->CurrentStamina <= 0.0f) &&
+		(GetClimbStatus() == EClimbStatus::ECS_NormalClimb) &&
+		(GetMovementStatus() != EMovementStatus::EMS_ClimbUp) &&
+		(GetMovementStatus() != EMovementStatus::EMS_WallJumping) &&
+		(GetMovementStatus() != EMovementStatus::EMS_FrontFlip))
+	{
+		StaminaComponent->CurrentStamina = 0.0f;
+
+		StaminaComponent->SetStaminaStatus(EStaminaStatus::ESS_Exhausted);
+	}
+	else if (StaminaComponent->GetStaminaStatus() == EStaminaStatus::ESS_Exhausted)
+	{
+		if (StaminaComponent->CurrentStamina == StaminaComponent->MaxStamina)
+		{
+			StaminaComponent->SetStaminaStatus(EStaminaStatus::ESS_Normal);
+		}
+	}
+	else if (
+		bIsStaminaConsumSprinting && (StaminaComponent->GetStaminaStatus() != EStaminaStatus::ESS_Exhausted) 
+		&& GetMovementStatus() != EMovementStatus::EMS_FrontFlip)
+	{
+		StaminaComponent->SetStaminaStatus(EStaminaStatus::ESS_Sprinting);
+
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_Climbing)
+	{
+		StaminaComponent->SetStaminaStatus(EStaminaStatus::ESS_Climbing);
+	}
+	else if (GetMovementStatus() == EMovementStatus::EMS_Gliding)
+	{
+		StaminaComponent->SetStaminaStatus(EStaminaStatus::ESS_Gliding);
+	}
+	else if (!CharacterOwner->GetMovementComponent()->IsFalling() && GetMovementStatus() == EMovementStatus::EMS_Normal)
+	{
+		StaminaComponent->SetStaminaStatus(EStaminaStatus::ESS_Normal);
+	}
+	else if (
+		(CharacterOwner->GetMovementComponent()->IsFalling() && GetMovementStatus() == EMovementStatus::EMS_Normal) ||
+		(GetMovementStatus() == EMovementStatus::EMS_ClimbUp) ||
+		(GetMovementStatus() == EMovementStatus::EMS_HaltClimbing) ||
+		(GetMovementStatus() == EMovementStatus::EMS_WallJumping) ||
+		(GetMovementStatus() == EMovementStatus::EMS_ClimbDown) ||
+		(GetMovementStatus() == EMovementStatus::EMS_FrontFlip)
+		)
+	{
+		StaminaComponent->SetStaminaStatus(EStaminaStatus::ESS_Pause);
+	}
+
+
+	if (StaminaComponent->GetStaminaStatus() == EStaminaStatus::ESS_Sprinting && CharacterOwner->GetCharacterMovement()->Velocity.Size() > 300.f)
+	{
+		if (CharacterOwner->GetMovementComponent()->IsFalling() && bIsJumping && !(GetMovementStatus() == EMovementStatus::EMS_Gliding))
+		{
+			SprintJumpStaminaConsumDuration -= DeltaTime;
+			if (SprintJumpStaminaConsumDuration <= 0.f)
+			{
+				bIsStaminaConsumSprinting = false;
+				SprintJumpStaminaConsumDuration = InitSprintJumpStaminaConsumDuration;
+			}
+		}
+		else if (CharacterOwner->GetMovementComponent()->IsFalling() && !bIsJumping)
+		{
+			SprintJumpStaminaConsumDuration = 0.f;
+			bIsStaminaConsumSprinting = false;
+
+		}
+		else
+		{
+			bIsJumping = false;
+			SprintJumpStaminaConsumDuration = InitSprintJumpStaminaConsumDuration;
+		}
+	}
+
+}
+
+EMovementStatus UClimbingComponent::GetMovementStatus()
+{
+	return MovementStatus;
+}
+
+void UClimbingComponent::SetMovementStatus(EMovementStatus Status)
+{
+	MovementStatus = Status;
+}
+
+EClimbStatus UClimbingComponent::GetClimbStatus()
+{
+	return ClimbStatus;
+}
+
+void UClimbingComponent::SetClimbStatus(EClimbStatus Status)
+{
+	ClimbStatus = Status;
+}
+
+EClimbLOD UClimbingComponent::GetClimbLOD()
+{
+	return ClimbLOD;
+}
+
+void UClimbingComponent::SetClimbLOD(EClimbLOD LOD)
+{
+	ClimbLOD = LOD;
+}
+
+bool UClimbingComponent::ClimbLODCondition(float DeltaTime)
+{
+	// Reduced LOD runs the probes every ReducedClimbProbeInterval frames with the accumulated time,
+	// the flags keep their last value in between. No LOD runs no probes, only the status transitions without traces
+	if (GetClimbLOD() == EClimbLOD::ECL_None)
+	{
+		ClimbProbeDeltaTime = 0.f;
+		return false;
+	}
+
+	ClimbProbeDeltaTime += DeltaTime;
+
+	bool bProbe = true;
+	if (!ReplayClimbProbeGate(EClimbProbeType::ECP_MAX, bProbe) && GetClimbLOD() == EClimbLOD::ECL_Reduced)
+	{
+		++ClimbProbeFrameCounter;
+		bProbe = ClimbProbeFrameCounter % FMath::Max(ReducedClimbProbeInterval, 1) == 0;
+	}
+
+	RecordClimbProbeGate(EClimbProbeType::ECP_MAX, bProbe);
+	return bProbe;
+}
+
+float UClimbingComponent::CalculateClimbSignificance(const FTransform& Viewpoint) const
+{
+	const float Distance = FVector::Dist(Viewpoint.GetLocation(), CharacterOwner->GetActorLocation());
+	float Significance = FMath::Clamp(1.f - Distance / ClimbLODMaxDistance, 0.f, 1.f);
+
+	// Off-screen characters count half. A dedicated server renders nothing, so only distance counts there
+	if (GetNetMode() != NM_DedicatedServer && !CharacterOwner->WasRecentlyRendered(0.2f))
+	{
+		Significance *= 0.5f;
+	}
+
+	return Significance;
+}
+
+bool UClimbingComponent::ClimbProbeCondition(EClimbProbeType Type)
+{
+	// A re-simulated frame doesn't spend this frame's probe budget
+	bool bGranted = true;
+	if (!ReplayClimbProbeGate(Type, bGranted))
+	{
+		UClimbProbeSchedulerSubsystem* ProbeScheduler = GetWorld()->GetSubsystem<UClimbProbeSchedulerSubsystem>();
+		bGranted = ProbeScheduler == nullptr || ProbeScheduler->RequestProbe(this, Type);
+	}
+
+	RecordClimbProbeGate(Type, bGranted);
+	return bGranted;
+}
+
+bool UClimbingComponent::IsClimbProbeStale(EClimbProbeType Type) const
+{
+	return ClimbProbeStaleFrames[(int32)Type] > 0;
+}
+
+bool UClimbingComponent::ReplayClimbProbeGate(EClimbProbeType Type, bool& bOutGranted)
+{
+	if (ClimbProbeReplayFrame == nullptr)
+	{
+		return false;
+	}
+
+	// A corrected input can skip or add a probe, so take the next recorded gate of the same type.
+	// None left means the frame went another way, the caller decides it live
+	const TArray<FClimbProbeGate>& Gates = ClimbProbeReplayFrame->Gates;
+	for (int32 Index = ClimbProbeReplayGateIndex; Index < Gates.Num(); ++Index)
+	{
+		if (Gates[Index].Type == Type)
+		{
+			bOutGranted = Gates[Index].bGranted;
+			ClimbProbeReplayGateIndex = Index + 1;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UClimbingComponent::RecordClimbProbeGate(EClimbProbeType Type, bool bGranted)
+{
+	if (ClimbProbeRecordFrame != nullptr)
+	{
+		ClimbProbeRecordFrame->Gates.Add({ Type, bGranted });
+	}
+}
+
+void UClimbingComponent::BeginClimbProbeFrame(FClimbProbeFrame* RecordFrame, const FClimbProbeFrame* ReplayFrame)
+{
+	check(RecordFrame == nullptr || RecordFrame != ReplayFrame);
+
+	ClimbProbeRecordFrame = RecordFrame;
+	ClimbProbeReplayFrame = ReplayFrame;
+	ClimbProbeReplayTraceIndex = 0;
+	ClimbProbeReplayGateIndex = 0;
+	ClimbProbeReplayMisses = 0;
+
+	if (ClimbProbeRecordFrame != nullptr)
+	{
+		ClimbProbeRecordFrame->Reset();
+	}
+}
+
+void UClimbingComponent::EndClimbProbeFrame()
+{
+	ClimbProbeRecordFrame = nullptr;
+	ClimbProbeReplayFrame = nullptr;
+}
+
+bool UClimbingComponent::ClimbLineTrace(FHitResult& OutHit, const FVector& Start, const FVector& End, const FCollisionQueryParams& Params)
+{
+	return ClimbSweep(OutHit, Start, End, FQuat::Identity, FCollisionShape(), Params);
+}
+
+bool UClimbingComponent::ClimbSweep(FHitResult& OutHit, const FVector& Start, const FVector& End, const FQuat& Rotation, const FCollisionShape& Shape, const FCollisionQueryParams& Params)
+{
+	const FVector ShapeExtent = Shape.GetExtent();
+
+	const FClimbProbeRecord* Replayed = nullptr;
+	if (ClimbProbeReplayFrame != nullptr)
+	{
+		// The same state asks the same probes in the same order, the next record is nearly always it.
+		// A corrected input moves the character a little, so search the rest within the tolerance
+		const TArray<FClimbProbeRecord>& Traces = ClimbProbeReplayFrame->Traces;
+		for (int32 Offset = 0; Offset < Traces.Num() && Replayed == nullptr; ++Offset)
+		{
+			const int32 Index = (ClimbProbeReplayTraceIndex + Offset) % Traces.Num();
+			const FClimbProbeRecord& Record = Traces[Index];
+			if (Record.ShapeExtent == ShapeExtent && Record.Start.Equals(Start, ClimbProbeReplayTolerance) && Record.End.Equals(End, ClimbProbeReplayTolerance))
+			{
+				Replayed = &Record;
+				ClimbProbeReplayTraceIndex = Index + 1;
+			}
+		}
+	}
+
+	bool bHit;
+	if (Replayed != nullptr)
+	{
+		OutHit = Replayed->Hit;
+		bHit = Replayed->bHit;
+	}
+	else
+	{
+		if (ClimbProbeReplayFrame != nullptr)
+		{
+			++ClimbProbeReplayMisses;
+		}
+
+		bHit = Shape.IsLine()
+			? GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, Params)
+			: GetWorld()->SweepSingleByChannel(OutHit, Start, End, Rotation, ECollisionChannel::ECC_Visibility, Shape, Params);
+	}
+
+	if (ClimbProbeRecordFrame != nullptr)
+	{
+		FClimbProbeRecord& Record = ClimbProbeRecordFrame->Traces.AddDefaulted_GetRef();
+		Record.Start = Start;
+		Record.End = End;
+		Record.ShapeExtent = ShapeExtent;
+		Record.Hit = OutHit;
+		Record.bHit = bHit;
+	}
+
+	return bHit;
+}
+
+bool UClimbingComponent::EnoughSpaceForGliding()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	bool Enough = true;
+
+	FVector Start = CharacterOwner->GetActorLocation() - CharacterOwner->GetActorUpVector() * 100.f;
+	FVector End = Start;
+	FQuat Rot{};
+	FHitResult OutHit{};
+	FCollisionShape Shape;
+	Shape.SetSphere(40.0f);
+	
+	Enough = !ClimbSweep(OutHit, Start, End, Rot, Shape, CollisionParams);
+	return Enough;
+}
+
+void UClimbingComponent::SetIsRightLeftEdgeAtNormal()
+{
+
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	FHitResult OutHit{};
+	FVector RightStart = CharacterOwner->GetActorLocation() + (ClimbFrameUp * 60.f + ClimbFrameRight * 50.f);
+	FVector RightEnd = RightStart + ClimbFrameForward * 100.f;
+	
+	bIsRightEdge = !ClimbLineTrace(OutHit, RightStart, RightEnd, CollisionParams);
+	
+	FVector LeftStart = CharacterOwner->GetActorLocation() + (ClimbFrameUp * 60.f - ClimbFrameRight * 50.f);
+	FVector LeftEnd = LeftStart + ClimbFrameForward * 100.f;
+
+	bIsLeftEdge = !ClimbLineTrace(OutHit, LeftStart, LeftEnd, CollisionParams);
+}
+
+void UClimbingComponent::SetIsLowerRightLeftEdgeAtGround()
+{
+
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	FHitResult OutHit{};
+	FVector RightStart = CharacterOwner->GetActorLocation() + (ClimbFrameUp * (-30.f) + ClimbFrameRight * 50.f);
+	FVector RightEnd = RightStart + ClimbFrameForward * 60.f;
+
+	bIsLowerRightEdge = !ClimbLineTrace(OutHit, RightStart, RightEnd, CollisionParams);
+
+	FVector LeftStart = CharacterOwner->GetActorLocation() + (ClimbFrameUp * (-30.f) - ClimbFrameRight * 50.f);
+	FVector LeftEnd = LeftStart + ClimbFrameForward * 60.f;
+
+	bIsLowerLeftEdge = !ClimbLineTrace(OutHit, LeftStart, LeftEnd, CollisionParams);
+}
+
+void UClimbingComponent::SetIsFoothold()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation() + ClimbFrameUp * (-80.f);
+	FVector End = Start + ClimbFrameForward * 70.f;
+
+	bIsFoothold = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	if (bIsFoothold)
+	{
+		FootWallContactPoint = OutHit.ImpactPoint;
+		LocalFootWallContactPoint = ClimbBaseTransform.InverseTransformPosition(FootWallContactPoint);
+	}
+}
+
+void UClimbingComponent::SetIsTopEdge()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation() + ClimbFrameUp * 90.f;
+	FVector End = Start + ClimbFrameForward * 70.f;
+
+	bIsTopEdge = !ClimbLineTrace(OutHit, Start, End, CollisionParams);
+}
+
+void UClimbingComponent::SetCanGrabWallFromTopAndNormalVector()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	bool bDeepEnoughSpace = false;
+	bool bCloserGroundCheck = false;
+	
+	bool bSpaceCheckRight = false;
+	bool bSpaceCheckLeft = false;
+
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation() + ClimbFrameForward * 42.f;
+	FVector End = Start + ClimbFrameUp * (-276.f);
+
+
+
+	bDeepEnoughSpace = !ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	Start = CharacterOwner->GetActorLocation() + ClimbFrameForward * 15.f;
+	End = Start + ClimbFrameUp * (-100.f);
+	bCloserGroundCheck = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+
+	Start = CharacterOwner->GetActorLocation() + (ClimbFrameForward * 42.f + ClimbFrameUp * (-184.f) + ClimbFrameRight * 42.f);
+	End = Start + ClimbFrameForward * (-35.f);
+	bSpaceCheckRight = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	Start = CharacterOwner->GetActorLocation() + (ClimbFrameForward * 42.f + ClimbFrameUp * (-184.f) + ClimbFrameRight * (-42.f));
+	End = Start + ClimbFrameForward * (-35.f);
+	bSpaceCheckLeft = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	Start = CharacterOwner->GetActorLocation() + (ClimbFrameForward * 42.f + ClimbFrameUp * (-184.f));
+	End = Start + ClimbFrameForward * (-35.f);
+	ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	if (bDeepEnoughSpace && bCloserGroundCheck && bSpaceCheckRight && bSpaceCheckLeft)
+	{
+		bCanGrabWallFromTop = true;
+		NormalVectorGrabWallFromTop = OutHit.Normal;
+	}
+	else
+	{
+		bCanGrabWallFromTop = false;
+	}
+
+}
+
+void UClimbingComponent::SetTooFarFromWall()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation();
+	FVector End = Start + ClimbFrameForward * 45.f;
+
+	bTooFarFromWall = !ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+}
+
+void UClimbingComponent::SetClimbUpTraceGround()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation();
+	FVector End = Start + ClimbFrameUp * (-130.f);
+
+	bClimbUpTraceGround = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	if (bClimbUpTraceGround)
+	{
+		ClimbUpGroundZ = OutHit.ImpactPoint.Z;
+	}
+}
+
+void UClimbingComponent::SetIsGround()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	FHitResult OutHit{};
+	// The ground is below in the world, under an overhang too
+	FVector Start = CharacterOwner->GetActorLocation();
+	FVector End = Start + FVector(0.f, 0.f, -100.f);
+
+	bIsGround = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+}
+
+void UClimbingComponent::SetIsBottomEdge()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation() + ClimbFrameUp * (-80.f);
+	FVector End = Start + ClimbFrameForward * 80.f;
+
+	bIsBottomEdge = !ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	if (!bIsBottomEdge)
+	{
+		FootWallContactPoint = OutHit.ImpactPoint;
+		LocalFootWallContactPoint = ClimbBaseTransform.InverseTransformPosition(FootWallContactPoint);
+	}
+}
+
+void UClimbingComponent::SetCanRightTurnInsideCorner()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	bool Condition_1 = false;
+	bool Condition_2 = false;
+
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation() + ClimbFrameForward * 40.f;
+	FVector End = Start + ClimbFrameRight * 45.f;
+
+	Condition_1 = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	Start = CharacterOwner->GetActorLocation() + ClimbFrameForward * (-40.f);
+	End = Start + ClimbFrameRight * 45.f;
+
+	Condition_2 = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	if (Condition_1 && Condition_2)
+	{
+		bCanRightTurnInsideCorner = true;
+	}
+	else
+	{
+		bCanRightTurnInsideCorner = false;
+	}
+
+}
+
+void UClimbingComponent::SetCanLeftTurnInsideCorner()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	bool Condition_1 = false;
+	bool Condition_2 = false;
+
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation() + ClimbFrameForward * 40.f;
+	FVector End = Start + ClimbFrameRight * (-45.f);
+
+	Condition_1 = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	Start = CharacterOwner->GetActorLocation() + ClimbFrameForward * (-40.f);
+	End = Start + ClimbFrameRight * (-45.f);
+
+	Condition_2 = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	if (Condition_1 && Condition_2)
+	{
+		bCanLeftTurnInsideCorner = true;
+	}
+	else
+	{
+		bCanLeftTurnInsideCorner = false;
+	}
+
+}
+
+void UClimbingComponent::SetIsRightLeftEdgeAtClimbing()
+{
+
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	FHitResult OutHit{};
+	FVector RightStart = CharacterOwner->GetActorLocation() + ClimbFrameRight * 50.f;
+	FVector RightEnd = RightStart + ClimbFrameForward * 60.f;
+
+	bIsRightEdge = !ClimbLineTrace(OutHit, RightStart, RightEnd, CollisionParams);
+
+	FVector LeftStart = CharacterOwner->GetActorLocation() + ClimbFrameRight * (-50.f);
+	FVector LeftEnd = LeftStart + ClimbFrameForward * 60.f;
+
+	bIsLeftEdge = !ClimbLineTrace(OutHit, LeftStart, LeftEnd, CollisionParams);
+
+}
+
+void UClimbingComponent::SetCanRightTurnOutsideCorner()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	bool Condition_1 = false;
+	bool Condition_2 = false;
+
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation() + (ClimbFrameRight * 84.f + ClimbFrameForward * 50.f);
+	FVector End = Start + ClimbFrameRight * (-70.f);
+
+	Condition_1 = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	Start = CharacterOwner->GetActorLocation() + (ClimbFrameRight * 84.f + ClimbFrameForward * 126.f);
+	End = Start + ClimbFrameRight * (-70.f);
+
+	Condition_2 = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	if (Condition_1 && Condition_2)
+	{
+		bCanRightTurnOutsideCorner = true;
+	}
+	else
+	{
+		bCanRightTurnOutsideCorner = false;
+	}
+
+}
+
+void UClimbingComponent::SetCanLeftTurnOutsideCorner()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	bool Condition_1 = false;
+	bool Condition_2 = false;
+
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation() + (ClimbFrameRight * (-84.f) + ClimbFrameForward * 50.f);
+	FVector End = Start + ClimbFrameRight * (70.f);
+
+	Condition_1 = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	Start = CharacterOwner->GetActorLocation() + (ClimbFrameRight * (-84.f) + ClimbFrameForward * 126.f);
+	End = Start + ClimbFrameRight * (70.f);
+
+	Condition_2 = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	if (Condition_1 && Condition_2)
+	{
+		bCanLeftTurnOutsideCorner = true;
+	}
+	else
+	{
+		bCanLeftTurnOutsideCorner = false;
+	}
+
+}
+
+void UClimbingComponent::SetClimbUpEnoughSpace()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	bool Condition_1 = false;
+	bool Condition_2 = false;
+
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation() + ClimbFrameUp * 96.f;
+	FVector End = Start + ClimbFrameForward * 70.f;
+
+	Condition_1 = !ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	Start = CharacterOwner->GetActorLocation() + ClimbFrameUp * 300.f;
+	End = Start + ClimbFrameForward * 70.f;
+	Condition_2 = !ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	if (Condition_1 && Condition_2)
+	{
+		bClimbUpEnoughSpace = true;
+	}
+	else
+	{
+		bClimbUpEnoughSpace = false;
+	}
+}
+
+void UClimbingComponent::SetIsBodyWallFacingAndNormalVector()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	CollisionParams.bReturnPhysicalMaterial = true;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	bool bDeepEnoughSpace = false;
+	bool bCloserGroundCheck = false;
+
+	bool bSpaceCheckRight = false;
+	bool bSpaceCheckLeft = false;
+
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation();
+	FVector End = Start + ClimbFrameForward * (70.f);
+
+	bIsBodyWallFacing = ClimbLineTrace(OutHit, Start, End, CollisionParams);
+
+	if (bIsBodyWallFacing)
+	{
+		NormalVectorBodyWallFacing = OutHit.Normal;
+		BodyWallContactPoint = OutHit.ImpactPoint;
+		UpdateClimbSurface(OutHit);
+
+		SetClimbBase(OutHit);
+		LocalNormalVectorBodyWallFacing = ClimbBaseTransform.InverseTransformVectorNoScale(NormalVectorBodyWallFacing);
+		LocalBodyWallContactPoint = ClimbBaseTransform.InverseTransformPosition(BodyWallContactPoint);
+	}
+}
+
+void UClimbingComponent::UpdateClimbFrame()
+{
+	// One rotation for the whole probe pass instead of one per axis per trace
+	const FQuat Rotation = CharacterOwner->GetActorQuat();
+	ClimbFrameForward = Rotation.GetForwardVector();
+	ClimbFrameRight = Rotation.GetRightVector();
+	ClimbFrameUp = Rotation.GetUpVector();
+}
+
+FQuat UClimbingComponent::GetClimbRotation(const FVector& WallNormal) const
+{
+	// Up along the wall is the world up on walls and overhangs. A ceiling has none, there the current up
+	// is kept, or the facing is used when the character reaches for the ceiling from below
+	FVector Up = FVector::VectorPlaneProject(FVector::UpVector, WallNormal);
+	if (Up.SizeSquared() < FMath::Square(ClimbCeilingThreshold))
+	{
+		Up = FVector::VectorPlaneProject(CharacterOwner->GetActorUpVector(), WallNormal);
+		if (Up.SizeSquared() < FMath::Square(ClimbCeilingThreshold))
+		{
+			Up = FVector::VectorPlaneProject(CharacterOwner->GetActorForwardVector(), WallNormal);
+		}
+	}
+
+	return FRotationMatrix::MakeFromXZ(-WallNormal, Up).ToQuat();
+}
+
+void UClimbingComponent::AlignCharacterToWall(float DeltaTime)
+{
+	if (GetMovementStatus() != EMovementStatus::EMS_Climbing || GetClimbStatus() != EClimbStatus::ECS_NormalClimb || !bIsBodyWallFacing)
+	{
+		return;
+	}
+
+	const FQuat Rotation = FMath::QInterpTo(CharacterOwner->GetActorQuat(), GetClimbRotation(NormalVectorBodyWallFacing), DeltaTime, ClimbAlignSpeed);
+	CharacterOwner->SetActorRotation(Rotation);
+	UpdateClimbFrame();
+}
+
+void UClimbingComponent::ClimbBaseManager()
+{
+	if (GetMovementStatus() != EMovementStatus::EMS_Climbing)
+	{
+		ClimbBase.Reset();
+		bClimbBaseRetrace = true;
+		return;
+	}
+
+	if (!ClimbBase.IsValid())
+	{
+		return;
+	}
+
+	const FTransform BaseTransform = GetClimbBaseWorldTransform();
+	if (BaseTransform.Equals(ClimbBaseTransform))
+	{
+		return;
+	}
+
+	// Keep the character where it was on the base, turning with it. The whole rotation, not only the yaw : the capsule
+	// keeps its pose to the wall, so a pitching or rolling base can't tip it off. AlignCharacterToWall then brings
+	// its up back along the wall, as on a static overhang
+	const FVector Location = BaseTransform.TransformPosition(ClimbBaseTransform.InverseTransformPosition(CharacterOwner->GetActorLocation()));
+	const FQuat DeltaRotation = BaseTransform.GetRotation() * ClimbBaseTransform.GetRotation().Inverse();
+	CharacterOwner->SetActorLocationAndRotation(Location, DeltaRotation * CharacterOwner->GetActorQuat());
+	UpdateClimbFrame();
+
+	for (int32 Hand = 0; Hand < 2; ++Hand)
+	{
+		ClimbIKHandContacts[Hand] = BaseTransform.TransformPosition(ClimbBaseTransform.InverseTransformPosition(ClimbIKHandContacts[Hand]));
+	}
+
+	ClimbBaseTransform = BaseTransform;
+	NormalVectorBodyWallFacing = ClimbBaseTransform.TransformVectorNoScale(LocalNormalVectorBodyWallFacing);
+	BodyWallContactPoint = ClimbBaseTransform.TransformPosition(LocalBodyWallContactPoint);
+	FootWallContactPoint = ClimbBaseTransform.TransformPosition(LocalFootWallContactPoint);
+}
+
+void UClimbingComponent::SetClimbBase(const FHitResult& Hit)
+{
+	// Static and stationary walls never move, their probes stay in world space
+	UPrimitiveComponent* Component = Hit.GetComponent();
+	if (Component != nullptr && Component->Mobility == EComponentMobility::Movable)
+	{
+		ClimbBase = Component;
+		ClimbBaseBoneName = Hit.BoneName;
+		ClimbBaseTransform = GetClimbBaseWorldTransform();
+	}
+	else
+	{
+		ClimbBase.Reset();
+		ClimbBaseBoneName = NAME_None;
+		ClimbBaseTransform = FTransform::Identity;
+	}
+
+	LocalClimbProbeLocation = ClimbBaseTransform.InverseTransformPosition(CharacterOwner->GetActorLocation());
+}
+
+FTransform UClimbingComponent::GetClimbBaseWorldTransform() const
+{
+	const UPrimitiveComponent* Base = ClimbBase.Get();
+	if (Base == nullptr)
+	{
+		return FTransform::Identity;
+	}
+
+	if (ClimbBaseBoneName != NAME_None)
+	{
+		return Base->GetSocketTransform(ClimbBaseBoneName);
+	}
+
+	return Base->GetComponentTransform();
+}
+
+bool UClimbingComponent::ClimbBaseRetraceCondition()
+{
+	// Without a movable base nothing can be reused, a skinned base changes shape under the character
+	if (!ClimbBase.IsValid() || ClimbBase->IsA<USkinnedMeshComponent>())
+	{
+		return true;
+	}
+
+	if (!ClimbMoveInput.IsZero() || GetClimbStatus() != EClimbStatus::ECS_NormalClimb)
+	{
+		return true;
+	}
+
+	const FVector LocalLocation = ClimbBaseTransform.InverseTransformPosition(CharacterOwner->GetActorLocation());
+	return !LocalLocation.Equals(LocalClimbProbeLocation, ClimbBaseRetraceTolerance);
+}
+
+void UClimbingComponent::UpdateClimbSurface(const FHitResult& Hit)
+{
+	// The wall probe returns the material of the face hit, one component can have several (landscape layers, material slots)
+	if (Hit.PhysMaterial.IsValid() && Hit.PhysMaterial == ClimbSurfacePhysMaterial)
+	{
+		return;
+	}
+
+	ClimbSurfacePhysMaterial = Hit.PhysMaterial;
+
+	// Unlisted surface types climb like plain rock
+	const EPhysicalSurface SurfaceType = UPhysicalMaterial::DetermineSurfaceType(Hit.PhysMaterial.Get());
+	const FClimbSurfaceModifier* Modifier = ClimbSurfaceModifiers.Find(SurfaceType);
+	ClimbSurfaceModifier = Modifier != nullptr ? *Modifier : FClimbSurfaceModifier();
+}
+
+bool UClimbingComponent::WetSlipCondition(float DeltaTime)
+{
+	// Only climbing up a wet wall slips, the wetter the sooner
+	if (GetClimbStatus() != EClimbStatus::ECS_NormalClimb || ClimbSurfaceWetness <= 0.f || ClimbMoveInput.X <= 0.f)
+	{
+		return false;
+	}
+
+	WetSlipTimer += DeltaTime * ClimbSurfaceWetness;
+	if (WetSlipTimer < WetSlipInterval)
+	{
+		return false;
+	}
+
+	WetSlipTimer = 0.f;
+	return true;
+}
+
+void UClimbingComponent::WetSlip()
+{
+	LastWetSlipTime = GetClimbTime();
+}
+
+bool UClimbingComponent::IsWetSlipping() const
+{
+	return LastWetSlipTime >= 0.f && GetClimbTime() - LastWetSlipTime < WetSlipDuration;
+}
+
+void UClimbingComponent::ClimbIKManager(float DeltaTime)
+{
+	// Hand rays issued last frame
+	for (int32 Hand = 0; Hand < 2; ++Hand)
+	{
+		FTraceDatum TraceDatum;
+		if (ClimbIKHandTraceHandles[Hand].IsValid() && GetWorld()->QueryTraceData(ClimbIKHandTraceHandles[Hand], TraceDatum))
+		{
+			bClimbIKHandContacts[Hand] = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit;
+			if (bClimbIKHandContacts[Hand])
+			{
+				ClimbIKHandContacts[Hand] = TraceDatum.OutHits[0].ImpactPoint;
+			}
+			ClimbIKHandTraceHandles[Hand] = FTraceHandle();
+		}
+	}
+
+	// Montages (corners, dashes) and LOD'd climbers animate without IK
+	const bool bClimbIK = GetMovementStatus() == EMovementStatus::EMS_Climbing && GetClimbStatus() == EClimbStatus::ECS_NormalClimb
+		&& GetClimbLOD() != EClimbLOD::ECL_None && bIsBodyWallFacing;
+
+	FVector HandLocations[2] = { ClimbIKTargets.LeftHandLocation, ClimbIKTargets.RightHandLocation };
+	FVector FootLocations[2] = { ClimbIKTargets.LeftFootLocation, ClimbIKTargets.RightFootLocation };
+	float HandAlphas[2] = { 0.f, 0.f };
+	float FootAlphas[2] = { 0.f, 0.f };
+
+	if (bClimbIK)
+	{
+		const FVector Location = CharacterOwner->GetActorLocation();
+		const FVector Up = CharacterOwner->GetActorUpVector();
+		const FVector Right = CharacterOwner->GetActorRightVector();
+		const FVector WallOffset = NormalVectorBodyWallFacing * ClimbIKWallOffset;
+		const bool bIsSideEdge[2] = { bIsLeftEdge, bIsRightEdge };
+
+		for (int32 Side = 0; Side < 2; ++Side)
+		{
+			const float SideSign = Side == 0 ? -1.f : 1.f;
+
+			// Hands : the hand ray contact, else the body's wall plane. Nothing to hold on past a side edge
+			const FVector HandAnchor = Location + Up * ClimbIKHandHeight + Right * (SideSign * ClimbIKHandSpacing);
+			HandLocations[Side] = FVector::PointPlaneProject(HandAnchor, BodyWallContactPoint, NormalVectorBodyWallFacing);
+			if (bClimbIKHandContacts[Side] && FVector::DistSquared(ClimbIKHandContacts[Side], HandLocations[Side]) < FMath::Square(ClimbIKHandSpacing))
+			{
+				HandLocations[Side] = ClimbIKHandContacts[Side];
+			}
+			HandLocations[Side] += WallOffset;
+			HandAlphas[Side] = (bClimbIKHandContacts[Side] || !bIsSideEdge[Side]) ? 1.f : 0.f;
+
+			// Feet : the foothold plane, they dangle below the bottom edge
+			const FVector FootAnchor = Location - Up * ClimbIKFootHeight + Right * (SideSign * ClimbIKFootSpacing);
+			FootLocations[Side] = FVector::PointPlaneProject(FootAnchor, FootWallContactPoint, NormalVectorBodyWallFacing) + WallOffset;
+			FootAlphas[Side] = bIsBottomEdge ? 0.f : 1.f;
+		}
+	}
+
+	// Blend in from the target itself, not from wherever the limb was last placed
+	if (ClimbIKTargets.LeftHandAlpha > KINDA_SMALL_NUMBER)
+	{
+		HandLocations[0] = FMath::VInterpTo(ClimbIKTargets.LeftHandLocation, HandLocations[0], DeltaTime, ClimbIKInterpSpeed);
+	}
+	if (ClimbIKTargets.RightHandAlpha > KINDA_SMALL_NUMBER)
+	{
+		HandLocations[1] = FMath::VInterpTo(ClimbIKTargets.RightHandLocation, HandLocations[1], DeltaTime, ClimbIKInterpSpeed);
+	}
+	if (ClimbIKTargets.LeftFootAlpha > KINDA_SMALL_NUMBER)
+	{
+		FootLocations[0] = FMath::VInterpTo(ClimbIKTargets.LeftFootLocation, FootLocations[0], DeltaTime, ClimbIKInterpSpeed);
+	}
+	if (ClimbIKTargets.RightFootAlpha > KINDA_SMALL_NUMBER)
+	{
+		FootLocations[1] = FMath::VInterpTo(ClimbIKTargets.RightFootLocation, FootLocations[1], DeltaTime, ClimbIKInterpSpeed);
+	}
+
+	ClimbIKTargets.LeftHandLocation = HandLocations[0];
+	ClimbIKTargets.RightHandLocation = HandLocations[1];
+	ClimbIKTargets.LeftFootLocation = FootLocations[0];
+	ClimbIKTargets.RightFootLocation = FootLocations[1];
+	ClimbIKTargets.WallNormal = NormalVectorBodyWallFacing;
+	ClimbIKTargets.LeftHandAlpha = FMath::FInterpTo(ClimbIKTargets.LeftHandAlpha, HandAlphas[0], DeltaTime, ClimbIKInterpSpeed);
+	ClimbIKTargets.RightHandAlpha = FMath::FInterpTo(ClimbIKTargets.RightHandAlpha, HandAlphas[1], DeltaTime, ClimbIKInterpSpeed);
+	ClimbIKTargets.LeftFootAlpha = FMath::FInterpTo(ClimbIKTargets.LeftFootAlpha, FootAlphas[0], DeltaTime, ClimbIKInterpSpeed);
+	ClimbIKTargets.RightFootAlpha = FMath::FInterpTo(ClimbIKTargets.RightFootAlpha, FootAlphas[1], DeltaTime, ClimbIKInterpSpeed);
+}
+
+void UClimbingComponent::RequestClimbIKTraces()
+{
+	if (GetMovementStatus() != EMovementStatus::EMS_Climbing || GetClimbStatus() != EClimbStatus::ECS_NormalClimb || !bClimbBaseRetrace)
+	{
+		return;
+	}
+
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	for (int32 Hand = 0; Hand < 2; ++Hand)
+	{
+		const float SideSign = Hand == 0 ? -1.f : 1.f;
+		FVector Start = CharacterOwner->GetActorLocation() + CharacterOwner->GetActorUpVector() * ClimbIKHandHeight + CharacterOwner->GetActorRightVector() * (SideSign * ClimbIKHandSpacing);
+		FVector End = Start + CharacterOwner->GetActorForwardVector() * 70.f;
+
+		ClimbIKHandTraceHandles[Hand] = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
+	}
+}
+
+void UClimbingComponent::ResetClimbIK()
+{
+	for (int32 Hand = 0; Hand < 2; ++Hand)
+	{
+		ClimbIKHandTraceHandles[Hand] = FTraceHandle();
+		bClimbIKHandContacts[Hand] = false;
+	}
+}
+
+void UClimbingComponent::StopClimb()
+{
+	ResetUprightRotation();
+
+	CharacterOwner->GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Falling);
+	SetMovementStatus(EMovementStatus::EMS_Normal);
+	CharacterOwner->GetCharacterMovement()->bOrientRotationToMovement = true;
+	LastClimbStopTime = GetClimbTime();
+}
+
+void UClimbingComponent::ResetUprightRotation()
+{
+	// Back upright after an overhang or a ceiling
+	const FRotator Rotation = CharacterOwner->GetActorRotation();
+	CharacterOwner->SetActorRotation(FRotator(0.f, Rotation.Yaw, 0.f));
+	UpdateClimbFrame();
+}
+
+void UClimbingComponent::StartClimb()
+{
+	CharacterOwner->StopAnimMontage();
+	CharacterOwner->SetActorRotation(GetClimbRotation(NormalVectorBodyWallFacing));
+	UpdateClimbFrame();
+	ClimbStartTerm = InitClimbStartTerm;
+	SetMovementStatus(EMovementStatus::EMS_Climbing);
+	bIsCanGrabWall = false;
+	ResetClimbContactPrediction();
+	ResetClimbIK();
+	WetSlipTimer = 0.f;
+	CharacterOwner->GetCharacterMovement()->Velocity = FVector(0.f, 0.f, 0.f);
+	CharacterOwner->GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Flying);
+	CharacterOwner->GetCharacterMovement()->bOrientRotationToMovement = false;
+	bIsJumping = false;
+
+	OnClimbStarted.Broadcast();
+}
+
+bool UClimbingComponent::StartClimbAtNormalStatusCondition(float DeltaTime)
+{
+	if (!ClimbProbeCondition(EClimbProbeType::ECP_StartClimb))
+	{
+		return false;
+	}
+
+	if (ClimbStartEnoughSpaceConditionForGround())
+	{
+		if (ClimbStartInputDirectionCondition())
+		{
+			ClimbStartTerm -= DeltaTime;
+			//UE_LOG(LogTemp, Warning, TEXT("I'm in air~"));
+		}
+		else
+		{
+			ClimbStartTerm = InitClimbStartTerm;
+		}
+
+		if (ClimbStartTerm <= 0.0)
+		{
+			return true;
+		}
+
+	}
+	return false;
+}
+
+bool UClimbingComponent::StartClimbWhileGlidingCondition(float DeltaTime)
+{
+	// Skip the climb start traces until the predicted wall contact is reached
+	if (!ClimbContactPredictionCondition(DeltaTime) || !ClimbProbeCondition(EClimbProbeType::ECP_StartClimb))
+	{
+		return false;
+	}
+
+	if (ClimbStartEnoughSpaceCondition())
+	{
+		if (ClimbStartInputDirectionCondition())
+		{
+			ClimbStartTerm -= DeltaTime;
+			//UE_LOG(LogTemp, Warning, TEXT("I'm in air~"));
+		}
+		else
+		{
+			ClimbStartTerm = InitClimbStartTerm;
+		}
+
+		if (ClimbStartTerm <= 0.f)
+		{
+			return true;
+		}
+	}
+	else if (!bIsBodyWallFacing)
+	{
+		// Passed by the wall or turned away from it
+		ResetClimbContactPrediction();
+	}
+
+	return false;
+}
+
+void UClimbingComponent::PredictClimbContact()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+	CollisionParams.AddIgnoredActor(CharacterOwner);
+
+	ClimbPredictionRetraceTerm = InitClimbPredictionRetraceTerm;
+	PredictedClimbVelocity = CharacterOwner->GetCharacterMovement()->Velocity;
+	bHasPredictedClimbContact = false;
+
+	if (PredictedClimbVelocity.IsNearlyZero())
+	{
+		return;
+	}
+
+	// Cast the capsule along the current velocity for the next ClimbPredictionTime seconds
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation();
+	FVector End = Start + PredictedClimbVelocity * ClimbPredictionTime;
+	FCollisionShape Shape = CharacterOwner->GetCapsuleComponent()->GetCollisionShape();
+
+	if (ClimbSweep(OutHit, Start, End, CharacterOwner->GetActorQuat(), Shape, CollisionParams))
+	{
+		// Walls, overhangs and ceilings are grabbed like the climb start check grabs them, in the wall tangent frame.
+		// Only a floor the character would land on doesn't need the check
+		if (!OutHit.bStartPenetrating && OutHit.ImpactNormal.Z < CharacterOwner->GetCharacterMovement()->GetWalkableFloorZ())
+		{
+			bHasPredictedClimbContact = true;
+			PredictedClimbContactTime = OutHit.Time * ClimbPredictionTime;
+		}
+	}
+}
+
+bool UClimbingComponent::ClimbContactPredictionCondition(float DeltaTime)
+{
+	// Once the wall is close enough, the regular climb start check runs every tick
+	if (bIsClimbContactImminent)
+	{
+		return true;
+	}
+
+	ClimbPredictionRetraceTerm -= DeltaTime;
+	PredictedClimbContactTime -= DeltaTime;
+
+	// Re-sweep periodically, or immediately when the velocity no longer matches the prediction
+	if (ClimbPredictionRetraceTerm <= 0.f ||
+		(bHasPredictedClimbContact && !CharacterOwner->GetCharacterMovement()->Velocity.Equals(PredictedClimbVelocity, ClimbPredictionVelocityTolerance)))
+	{
+		PredictClimbContact();
+	}
+
+	// Schedule the check slightly ahead of the contact so fast gliders don't grab a frame late
+	if (bHasPredictedClimbContact && PredictedClimbContactTime <= FMath::Max(DeltaTime, ClimbPredictionLeadTime))
+	{
+		bIsClimbContactImminent = true;
+	}
+
+	return bIsClimbContactImminent;
+}
+
+void UClimbingComponent::ResetClimbContactPrediction()
+{
+	bHasPredictedClimbContact = false;
+	bIsClimbContactImminent = false;
+	PredictedClimbContactTime = 0.f;
+	ClimbPredictionRetraceTerm = 0.f;
+}
+
+bool UClimbingComponent::ClimbStartInputDirectionCondition()
+{
+	FVector Vec = FVector(ClimbMoveInput.X, ClimbMoveInput.Y, 0.f);
+	FRotator Rot = FRotator(0.f, DesiredMoveYaw, 0.f);
+	FVector ControlDirection = Rot.RotateVector(Vec);
+
+	FVector ForwardVec = CharacterOwner->GetActorForwardVector();
+
+	// Input within 45 degrees of the facing and facing within 30 degrees of the wall, compared by cosine
+	if (ClimbDirection::IsWithinCone(ControlDirection, ForwardVec, ClimbDirection::CosFortyFive) &&
+		ClimbDirection::IsWithinCone(-NormalVectorBodyWallFacing, ForwardVec, ClimbDirection::CosThirty))
+	{
+		return true;
+	}
+
+	return false;
+}
+
+bool UClimbingComponent::ClimbMaintainCondition()
+{
+	// Still on the same spot of a moving base, last pass's results hold
+	if (bClimbBaseRetrace)
+	{
+		// Never deferred, only counted against the frame's trace budget
+		ClimbProbeCondition(EClimbProbeType::ECP_Maintain);
+
+		SetIsBodyWallFacingAndNormalVector();
+		SetIsGround();
+	}
+
+	if ((bIsBodyWallFacing || !(GetClimbStatus() == EClimbStatus::ECS_NormalClimb)) && !((bIsGround) && (ClimbMoveInput.X < 0.0)))
+	{
+		return true;
+	}
+
+	return false;
+}
+
+bool UClimbingComponent::ClimbUpCondition()
+{
+	// Nothing moved on the base since these probes last failed. Ledges are only climbed onto from near vertical walls
+	if (!bClimbBaseRetrace || ClimbFrameUp.Z < ClimbUpMinWallUpZ || !ClimbProbeCondition(EClimbProbeType::ECP_ClimbUp))
+	{
+		return false;
+	}
+
+	SetIsBottomEdge();
+	SetIsLowerRightLeftEdgeAtGround();
+	SetIsTopEdge();
+	SetClimbUpEnoughSpace();
+
+	if ( 
+		( bIsTopEdge && bClimbUpEnoughSpace && !(GetClimbStatus() == EClimbStatus::ECS_DashJump)  || ((GetClimbStatus() == EClimbStatus::ECS_DashJump) && !bIsBottomEdge)) &&
+		(!bIsRightEdge || !bIsLeftEdge) && 
+		bIsTopEdge && 
+		bClimbUpEnoughSpace 
+		)
+	{
+		return true;
+	}
+	return false;
+}
+
+bool UClimbingComponent::FrontFlipCondition()
+{
+	// Reuse the probes MovementStatusManager already ran this frame. The scheduler grants the climb start and
+	// the ledge probe separately, so each is checked on its own
+	if (LastGroundProbeFrame != ClimbFrameCounter)
+	{
+		SetIsRightLeftEdgeAtNormal();
+		SetIsFoothold();
+		SetIsTopEdge();
+		SetIsBodyWallFacingAndNormalVector();
+	}
+	if (LastGrabFromTopProbeFrame != ClimbFrameCounter)
+	{
+		SetCanGrabWallFromTopAndNormalVector();
+	}
+	SetIsLowerRightLeftEdgeAtGround();
+
+	if ( bIsRightEdge && bIsLeftEdge && !bIsLowerLeftEdge && !bIsLowerRightEdge && bIsFoothold && bIsTopEdge && !CharacterOwner->GetCharacterMovement()->IsFalling())
+	{
+		return true;
+	}
+	return false;
+}
+
+bool UClimbingComponent::TurnCornerInsideRightCondition()
+{
+	if (bCanRightTurnInsideCorner && ( ClimbDirection::IsRight(GetClimbInputDirection()) || (GetClimbStatus() == EClimbStatus::ECS_DashJump && bIsRightDashing) ) )
+	{
+		return true;
+	}
+
+	return false;
+}
+
+bool UClimbingComponent::TurnCornerInsideLeftCondition()
+{
+	if (bCanLeftTurnInsideCorner && (ClimbDirection::IsLeft(GetClimbInputDirection()) || (GetClimbStatus() == EClimbStatus::ECS_DashJump && bIsLeftDashing)))
+	{
+		return true;
+	}
+
+	return false;
+}
+
+bool UClimbingComponent::TurnCornerOutsideRightCondition()
+{
+	if (bCanRightTurnOutsideCorner && bIsRightEdge && (ClimbDirection::IsRight(GetClimbInputDirection()) || (GetClimbStatus() == EClimbStatus::ECS_DashJump && bIsRightDashing)))
+	{
+		return true;
+	}
+
+	return false;
+}
+
+bool UClimbingComponent::TurnCornerOutsideLeftCondition()
+{
+	if (bCanLeftTurnOutsideCorner && bIsLeftEdge && (ClimbDirection::IsLeft(GetClimbInputDirection()) || (GetClimbStatus() == EClimbStatus::ECS_DashJump && bIsLeftDashing)))
+	{
+		return true;
+	}
+
+	
+
+	return false;
+}
+
+bool UClimbingComponent::TurnCornerCondition()
+{
+	if (!bClimbBaseRetrace || !ClimbProbeCondition(EClimbProbeType::ECP_TurnCorner))
+	{
+		return false;
+	}
+
+	// Can do Turn Corner Check
+	TurnCornerVariableRenewal();
+
+	if (TurnCornerInsideRightCondition())
+	{
+		return true;
+	}
+	else if (TurnCornerInsideLeftCondition())
+	{
+		return true;
+	}
+	else if (TurnCornerOutsideRightCondition())
+	{
+		return true;
+	}
+	else if (TurnCornerOutsideLeftCondition())
+	{
+		return true;
+	}
+
+	return false;
+}
+
+void UClimbingComponent::TurnCorner()
+{
+	if (TurnCornerInsideRightCondition())
+	{
+		TurnCornerInsideRight();
+	}
+	else if (TurnCornerInsideLeftCondition())
+	{
+		TurnCornerInsideLeft();
+	}
+	else if (TurnCornerOutsideRightCondition())
+	{
+		TurnCornerOutsideRight();
+	}
+	else if (TurnCornerOutsideLeftCondition())
+	{
+		TurnCornerOutsideLeft();
+	}
+}
+
+void UClimbingComponent::StartGliding()
+{
+	SetMovementStatus(EMovementStatus::EMS_Gliding);
+
+	// Gliding start macro
+	// Lift, drag and sink rate are integrated by the flight model in the movement component
+	if (MainMovementComponent != nullptr)
+	{
+		MainMovementComponent->SetGliding(true);
+	}
+	CharacterOwner->GetCharacterMovement()->AirControl = 1.0f;
+	FVector CurrentVelocity = CharacterOwner->GetCharacterMovement()->Velocity;
+	CharacterOwner->GetCharacterMovement()->Velocity = FVector(CurrentVelocity.X, CurrentVelocity.Y, 0.f);
+
+	CharacterOwner->LaunchCharacter(FVector(0.0f, 0.0f, 150.f), false, false);
+
+	CharacterOwner->GetCharacterMovement()->RotationRate = FRotator(0.0f, 120.f, 0.0f);
+	CharacterOwner->GetCharacterMovement()->bOrientRotationToMovement = true;
+	CharacterOwner->GetCharacterMovement()->BrakingDecelerationFalling = 500.f;
+	CharacterOwner->GetCharacterMovement()->MaxWalkSpeed = 750.f;
+
+	// Play anim montage part
+	if (StartGlidingAnimMontage)
+	{
+		FTimerHandle WaitHandle;
+		float WaitTime = CharacterOwner->PlayAnimMontage(StartGlidingAnimMontage);
+		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
+			{
+
+
+			}), WaitTime, false); //ݺ ⼭ ߰   
+	}
+
+	bIsJumping = false;
+	if (GliderMeshComponent != nullptr)
+	{
+		GliderMeshComponent->SetVisibility(true);
+	}
+
+}
+
+void UClimbingComponent::StopGliding()
+{
+	bIsJumping = false;
+	CharacterOwner->StopAnimMontage();
+	if (MainMovementComponent != nullptr)
+	{
+		MainMovementComponent->SetGliding(false);
+	}
+	CharacterOwner->GetCharacterMovement()->GravityScale = 1.0f;
+	CharacterOwner->GetCharacterMovement()->AirControl = 0.0f;
+	CharacterOwner->GetCharacterMovement()->RotationRate = FRotator(0.f, 720.f, 0.f);
+	SetMovementStatus(EMovementStatus::EMS_Normal);
+	CharacterOwner->GetCharacterMovement()->BrakingDecelerationFalling = 0.f;
+	CharacterOwner->GetCharacterMovement()->MaxWalkSpeed = 500.f;
+
+	GlidingCoolTime = InitGlidingCoolTime;
+	ResetClimbContactPrediction();
+	
+	if (GliderMeshComponent != nullptr)
+	{
+		GliderMeshComponent->SetVisibility(false);
+	}
+}
+
+void UClimbingComponent::ClimbDashJump()
+{
+	ClimbDashJumpStaminaManage();
+
+	const EClimbDirection Direction = ClimbDirection::Classify(ClimbMoveInput.X, ClimbMoveInput.Y);
+
+	UAnimMontage* ClimbDashAnimMontage = GetClimbDashAnimMontage(Direction);
+	if (ClimbDashAnimMontage)
+	{
+		CharacterOwner->PlayAnimMontage(ClimbDashAnimMontage);
+	}
+
+	bIsRightDashing = ClimbDirection::IsRight(Direction);
+	bIsLeftDashing = ClimbDirection::IsLeft(Direction);
+
+	SetClimbStatus(EClimbStatus::ECS_DashJump);
+
+}
+
+UAnimMontage* UClimbingComponent::GetClimbDashAnimMontage(EClimbDirection Direction) const
+{
+	switch (Direction)
+	{
+	case EClimbDirection::U: return ClimbingDash_U_AnimMontage;
+	case EClimbDirection::D: return ClimbingDash_D_AnimMontage;
+	case EClimbDirection::R: return ClimbingDash_R_AnimMontage;
+	case EClimbDirection::L: return ClimbingDash_L_AnimMontage;
+	case EClimbDirection::UR: return ClimbingDash_UR_AnimMontage;
+	case EClimbDirection::DR: return ClimbingDash_DR_AnimMontage;
+	case EClimbDirection::UL: return ClimbingDash_UL_AnimMontage;
+	case EClimbDirection::DL: return ClimbingDash_DL_AnimMontage;
+	default: return nullptr;
+	}
+}
+
+bool UClimbingComponent::ClimbDashJumpCondition()
+{
+	const EClimbDirection Direction = GetClimbInputDirection();
+	if (GetMovementStatus() == EMovementStatus::EMS_Climbing && (GetClimbStatus() == EClimbStatus::ECS_NormalClimb) && !bIsBracing && 
+		!(TurnCornerOutsideLeftCondition() && ClimbDirection::IsLeft(Direction)) && !(TurnCornerOutsideRightCondition() && ClimbDirection::IsRight(Direction)))
+	{
+		return true;
+	}
+
+	return false;
+}
+
+void UClimbingComponent::ClimbDashJumpStaminaManage()
+{
+	StaminaComponent->ConsumeStamina(ClimbDashStaminaConsumption);
+}
+
+void UClimbingComponent::WallJump()
+{
+	WallJumpStaminaManage();
+
+	if (WallJumpAnimMontage)
+	{
+		FTimerHandle WaitHandle;
+		float WaitTime = CharacterOwner->PlayAnimMontage(WallJumpAnimMontage);
+		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
+			{
+
+
+			}), WaitTime, false); //ݺ ⼭ ߰   
+	}
+
+	ResetUprightRotation();
+	CharacterOwner->GetCharacterMovement()->bOrientRotationToMovement = true;
+	SetMovementStatus(EMovementStatus::EMS_WallJumping);
+	CharacterOwner->GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Falling);
+	ResetClimbContactPrediction();
+	CharacterOwner->GetCharacterMovement()->GravityScale = 0.1f;
+	WallJumpGravityEndTime = GetClimbTime() + 0.3f;
+}
+
+bool UClimbingComponent::WallJumpCondition()
+{
+	if (GetMovementStatus() == EMovementStatus::EMS_Climbing && bIsBracing && !(GetClimbStatus() == EClimbStatus::ECS_DashJump) && !(GetClimbStatus() == EClimbStatus::ECS_TurnCorner))
+	{
+		return true;
+	}
+
+	// Coyote time : just fell off the wall
+	if (GetMovementStatus() == EMovementStatus::EMS_Normal && bIsBracing && CharacterOwner->GetCharacterMovement()->IsFalling() &&
+		StaminaComponent->GetStaminaStatus() != EStaminaStatus::ESS_Exhausted && LastClimbStopTime >= 0.f &&
+		GetClimbTime() - LastClimbStopTime <= ClimbCoyoteTime)
+	{
+		return true;
+	}
+	
+	return false;
+}
+
+void UClimbingComponent::WallJumpStaminaManage()
+{
+	StaminaComponent->ConsumeStamina(WallJumpStaminaConsumption);
+}
+
+bool UClimbingComponent::StartClimbWhileWallJumpCondition(float DeltaTime)
+{
+	if (!(StaminaComponent->GetStaminaStatus() == EStaminaStatus::ESS_Exhausted) && bIsCanGrabWall && ClimbContactPredictionCondition(DeltaTime) && ClimbProbeCondition(EClimbProbeType::ECP_StartClimb))
+	{
+		if (ClimbStartEnoughSpaceCondition())
+		{
+			return true;
+		}
+		else if (!bIsBodyWallFacing)
+		{
+			ResetClimbContactPrediction();
+		}
+	}
+
+	return false;
+}
+
+bool UClimbingComponent::GlidingCondition()
+{
+	if ((GetMovementStatus() == EMovementStatus::EMS_Normal || 
+		GetMovementStatus() == EMovementStatus::EMS_Sprinting || 
+		GetMovementStatus() == EMovementStatus::EMS_HaltClimbing || 
+		GetMovementStatus() == EMovementStatus::EMS_WallJumping)
+		&&
+		EnoughSpaceForGliding() &&
+		(StaminaComponent->GetStaminaStatus() != EStaminaStatus::ESS_Exhausted)
+		)
+	{
+
+		return true;
+	}
+
+	return false;
+}
+
+void UClimbingComponent::GrabWallFromTop()
+{
+	bCanGrabWallFromTop = false;
+	FRotator Rot = NormalVectorGrabWallFromTop.Rotation();
+	CharacterOwner->SetActorRotation(FRotator(0.f, Rot.Yaw, 0.f));
+	UpdateClimbFrame();
+	SetMovementStatus(EMovementStatus::EMS_ClimbDown);
+	CharacterOwner->GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Flying);
+	SetClimbDownTargetZ();
+	if(GrabWallFromTopAnimMontage)
+	{
+		float WaitTime = CharacterOwner->PlayAnimMontage(GrabWallFromTopAnimMontage) - 0.3f;
+		ClimbDownGrabTime = GetClimbTime() + FMath::Max(WaitTime, 0.f);
+	}
+	else
+	{
+		// Nothing to wait for, the descent alone is paced by ClimbDownSpeed
+		bIsCanGrabWall = true;
+	}
+}
+
+bool UClimbingComponent::GrabWallFromTopCondition()
+{
+
+	// A deferred ledge probe leaves bCanGrabWallFromTop from where the character stood frames ago
+	if (GetMovementStatus() == EMovementStatus::EMS_Normal && !CharacterOwner->GetCharacterMovement()->IsFalling() && bCanGrabWallFromTop
+		&& !IsClimbProbeStale(EClimbProbeType::ECP_GrabFromTop))
+	{
+		return true;
+	}
+
+	return false;
+}
+
+void UClimbingComponent::SetClimbDownTargetZ()
+{
+	const FName TraceTag("MyTraceTag");
+	GetWorld()->DebugDrawTraceTag = TraceTag;
+	FCollisionQueryParams CollisionParams;
+	if (bDrawDebugLine)
+	{
+		CollisionParams.TraceTag = TraceTag;
+	}
+
+	// The ledge top is the ground under the character, the wall below it was found by the -184 probe
+	FHitResult OutHit{};
+	FVector Start = CharacterOwner->GetActorLocation();
+	FVector End = Start + CharacterOwner->GetActorUpVector() * (-130.f);
+
+	float LedgeZ = CharacterOwner->GetActorLocation().Z - CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	if (ClimbLineTrace(OutHit, Start, End, CollisionParams))
+	{
+		LedgeZ = OutHit.ImpactPoint.Z;
+	}
+
+	ClimbDownTargetZ = LedgeZ + CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() - ClimbDownLedgeDepth;
+}
+
+void UClimbingComponent::ClimbDownDescent(float DeltaTime)
+{
+	// Fixed speed descent toward the ledge target, one swept move per frame
+	const float Remaining = CharacterOwner->GetActorLocation().Z - ClimbDownTargetZ;
+	if (Remaining <= 0.f)
+	{
+		return;
+	}
+
+	const float Step = FMath::Min(GetClimbDownSpeed() * DeltaTime, Remaining);
+	CharacterOwner->AddActorWorldOffset(FVector(0.f, 0.f, -Step), true);
+}
+
+float UClimbingComponent::GetClimbDownSpeed() const
+{
+	// Paced by the grab montage so the ledge depth is covered when it ends.
+	// Only assets, no state : a restored or re-simulated descent runs at the same speed
+	if (GrabWallFromTopAnimMontage != nullptr && GrabWallFromTopAnimMontage->GetPlayLength() > KINDA_SMALL_NUMBER)
+	{
+		return ClimbDownLedgeDepth / GrabWallFromTopAnimMontage->GetPlayLength();
+	}
+
+	return ClimbDownSpeed;
+}
+
+bool UClimbingComponent::ClimbStartEnoughSpaceCondition()
+{
+	SetIsRightLeftEdgeAtNormal();
+	SetIsFoothold();
+	SetIsBodyWallFacingAndNormalVector();
+	SetIsTopEdge();
+
+	if (!bIsRightEdge && !bIsLeftEdge && !bIsTopEdge && bIsFoothold && bIsBodyWallFacing)
+	{
+		return true;
+	}
+
+	return false;
+}
+
+bool UClimbingComponent::ClimbStartEnoughSpaceConditionForGround()
+{
+	SetIsRightLeftEdgeAtNormal();
+	SetIsFoothold();
+	SetIsTopEdge();
+	SetIsBodyWallFacingAndNormalVector();
+	LastGroundProbeFrame = ClimbFrameCounter;
+
+	if (!bIsRightEdge && !bIsLeftEdge && bIsFoothold && bIsBodyWallFacing)
+	{
+		return true;
+	}
+
+	return false;
+}
+
+void UClimbingComponent::FrontFlip()
+{
+	FrontFlipStaminaManage();
+	CharacterOwner->GetCharacterMovement()->Velocity = FVector(0.0f, 0.0f, 0.0f);
+	CharacterOwner->GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Flying);
+	SetMovementStatus(EMovementStatus::EMS_FrontFlip);
+	CharacterOwner->GetCharacterMovement()->bOrientRotationToMovement = false;
+	if (FrontFlipAnimMontage)
+	{
+		float WaitTime = CharacterOwner->PlayAnimMontage(FrontFlipAnimMontage);
+		FrontFlipEndTime = GetClimbTime() + WaitTime;
+	}
+}
+
+void UClimbingComponent::FrontFlipStaminaManage()
+{
+	StaminaComponent->ConsumeStamina(FrontFlipStaminaConsumption);
+}
+
+void UClimbingComponent::ClimbUp()
+{
+	CharacterOwner->GetCharacterMovement()->Velocity = FVector(0.0f, 0.0f, 0.0f);
+	SetMovementStatus(EMovementStatus::EMS_ClimbUp);
+	SetClimbStatus(EClimbStatus::ECS_NormalClimb);
+	if (ClimbUpAnimMontage)
+	{
+		FTimerHandle WaitHandle;
+		float WaitTime = CharacterOwner->PlayAnimMontage(ClimbUpAnimMontage);
+		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
+			{
+
+
+			}), WaitTime, false); //ݺ ⼭ ߰   
+	}
+}
+
+void UClimbingComponent::TurnCornerInsideRight()
+{
+	if (TurnCornerInsideRightAnimMontage)
+	{
+		FTimerHandle WaitHandle;
+		float WaitTime = CharacterOwner->PlayAnimMontage(TurnCornerInsideRightAnimMontage);
+		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
+			{
+
+
+			}), WaitTime, false); //ݺ ⼭ ߰   
+
+		SetClimbStatus(EClimbStatus::ECS_TurnCorner);
+	}
+}
+
+void UClimbingComponent::TurnCornerInsideLeft()
+{
+	if (TurnCornerInsideLeftAnimMontage)
+	{
+		FTimerHandle WaitHandle;
+		float WaitTime = CharacterOwner->PlayAnimMontage(TurnCornerInsideLeftAnimMontage);
+		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
+			{
+
+
+			}), WaitTime, false); //ݺ ⼭ ߰   
+
+		SetClimbStatus(EClimbStatus::ECS_TurnCorner);
+	}
+}
+
+void UClimbingComponent::TurnCornerOutsideRight()
+{
+	if (TurnCornerOutsideRightAnimMontage)
+	{
+		FTimerHandle WaitHandle;
+		float WaitTime = CharacterOwner->PlayAnimMontage(TurnCornerOutsideRightAnimMontage);
+		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
+			{
+
+
+			}), WaitTime, false); //ݺ ⼭ ߰   
+
+		SetClimbStatus(EClimbStatus::ECS_TurnCorner);
+	}		
+}
+
+void UClimbingComponent::TurnCornerOutsideLeft()
+{
+	if (TurnCornerOutsideLeftAnimMontage)
+	{
+		FTimerHandle WaitHandle;
+		float WaitTime = CharacterOwner->PlayAnimMontage(TurnCornerOutsideLeftAnimMontage);
+		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
+			{
+
+			}), WaitTime, false); //ݺ ⼭ ߰   
+
+		SetClimbStatus(EClimbStatus::ECS_TurnCorner);
+	}
+}
+
+void UClimbingComponent::TurnCornerVariableRenewal()
+{
+	SetIsRightLeftEdgeAtClimbing();
+	SetCanLeftTurnInsideCorner();
+	SetCanRightTurnInsideCorner();
+	SetCanLeftTurnOutsideCorner();
+	SetCanRightTurnOutsideCorner();
+}
+
+void UClimbingComponent::AttachCharacterToWall()
+{
+	if (bClimbBaseRetrace)
+	{
+		SetTooFarFromWall();
+	}
+	if (bTooFarFromWall)
+	{
+		const FVector Direction = CharacterOwner->GetActorForwardVector();
+		CharacterOwner->AddMovementInput(Direction, 1.0f);
+	}
+}
+
+void UClimbingComponent::AttachCharacterToGround()
+{
+	SetClimbUpTraceGround();
+	SetIsBodyWallFacingAndNormalVector();
+	if (bClimbUpTraceGround && !bIsBodyWallFacing)
+	{
+		ResetUprightRotation();
+		CharacterOwner->GetCharacterMovement()->bOrientRotationToMovement = true;
+		CharacterOwner->GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Falling);
+
+		// Single swept move onto the traced ground instead of a fixed 1 unit teleport
+		const float FloorZ = ClimbUpGroundZ + CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		const float Drop = FMath::Max(CharacterOwner->GetActorLocation().Z - FloorZ, 0.f);
+		CharacterOwner->AddActorWorldOffset(FVector(0.f, 0.f, -Drop), true);
+		SetMovementStatus(EMovementStatus::EMS_Normal);
+
+	}
+}
+
+void UClimbingComponent::CaptureSnapshot(FMainMovementSnapshot& OutSnapshot) const
+{
+	const UCharacterMovementComponent* Movement = CharacterOwner->GetCharacterMovement();
+	const FVector OriginOffset(GetWorld()->OriginLocation);
+	const float Time = GetClimbTime();
+
+	OutSnapshot.Location = CharacterOwner->GetActorLocation() + OriginOffset;
+	OutSnapshot.Rotation = CharacterOwner->GetActorRotation();
+	OutSnapshot.ControlRotation = CharacterOwner->GetControlRotation();
+	OutSnapshot.Velocity = Movement->Velocity;
+
+	OutSnapshot.AirControl = Movement->AirControl;
+	OutSnapshot.RotationRateYaw = Movement->RotationRate.Yaw;
+	OutSnapshot.BrakingDecelerationFalling = Movement->BrakingDecelerationFalling;
+	OutSnapshot.MaxWalkSpeed = Movement->MaxWalkSpeed;
+	OutSnapshot.MaxFlySpeed = Movement->MaxFlySpeed;
+	OutSnapshot.GravityScale = Movement->GravityScale;
+	OutSnapshot.bOrientRotationToMovement = Movement->bOrientRotationToMovement;
+	OutSnapshot.MovementMode = (uint8)Movement->MovementMode;
+	OutSnapshot.CustomMovementMode = Movement->CustomMovementMode;
+
+	OutSnapshot.bIsGliding = MainMovementComponent != nullptr && MainMovementComponent->IsGliding();
+	OutSnapshot.GlideBankAngle = MainMovementComponent != nullptr ? MainMovementComponent->GetGlideBankAngle() : 0.f;
+	OutSnapshot.GlideBankStepTime = MainMovementComponent != nullptr ? MainMovementComponent->GetGlideBankStepTime() : 0.f;
+
+	OutSnapshot.MovementStatus = (uint8)MovementStatus;
+	OutSnapshot.ClimbStatus = (uint8)ClimbStatus;
+
+	OutSnapshot.NormalVectorBodyWallFacing = NormalVectorBodyWallFacing;
+	OutSnapshot.NormalVectorGrabWallFromTop = NormalVectorGrabWallFromTop;
+	OutSnapshot.BodyWallContactPoint = BodyWallContactPoint + OriginOffset;
+	OutSnapshot.FootWallContactPoint = FootWallContactPoint + OriginOffset;
+	OutSnapshot.PredictedClimbVelocity = PredictedClimbVelocity;
+
+	OutSnapshot.ClimbStartTerm = ClimbStartTerm;
+	OutSnapshot.GlidingCoolTime = GlidingCoolTime;
+	OutSnapshot.SprintJumpStaminaConsumDuration = SprintJumpStaminaConsumDuration;
+	OutSnapshot.ClimbUpGroundZ = ClimbUpGroundZ + OriginOffset.Z;
+	OutSnapshot.ClimbDownTargetZ = ClimbDownTargetZ + OriginOffset.Z;
+	OutSnapshot.ClimbPredictionRetraceTerm = ClimbPredictionRetraceTerm;
+	OutSnapshot.PredictedClimbContactTime = PredictedClimbContactTime;
+	OutSnapshot.ClimbSpeedMultiplier = ClimbSurfaceModifier.ClimbSpeedMultiplier;
+	OutSnapshot.ClimbStaminaMultiplier = ClimbSurfaceModifier.StaminaMultiplier;
+	OutSnapshot.ClimbSurfaceWetness = ClimbSurfaceWetness;
+	OutSnapshot.WetSlipTimer = WetSlipTimer;
+	OutSnapshot.ClimbProbeDeltaTime = ClimbProbeDeltaTime;
+	OutSnapshot.WetSlipAge = LastWetSlipTime >= 0.f ? Time - LastWetSlipTime : -1.f;
+	OutSnapshot.ClimbStopAge = LastClimbStopTime >= 0.f ? Time - LastClimbStopTime : -1.f;
+
+	OutSnapshot.bIsJumping = bIsJumping;
+	OutSnapshot.bWantsToSprint = bWantsToSprint;
+	OutSnapshot.bIsBracing = bIsBracing;
+	OutSnapshot.bTooFarFromWall = bTooFarFromWall;
+	OutSnapshot.bIsRightEdge = bIsRightEdge;
+	OutSnapshot.bIsLeftEdge = bIsLeftEdge;
+	OutSnapshot.bIsBottomEdge = bIsBottomEdge;
+	OutSnapshot.bIsFoothold = bIsFoothold;
+	OutSnapshot.bIsGround = bIsGround;
+	OutSnapshot.bIsTopEdge = bIsTopEdge;
+	OutSnapshot.bIsCanGrabWall = bIsCanGrabWall;
+	OutSnapshot.bIsBodyWallFacing = bIsBodyWallFacing;
+	OutSnapshot.bHasPredictedClimbContact = bHasPredictedClimbContact;
+	OutSnapshot.bIsClimbContactImminent = bIsClimbContactImminent;
+	OutSnapshot.bIsTurnCornerRightEdge = bIsTurnCornerRightEdge;
+	OutSnapshot.bIsTurnCornerLeftEdge = bIsTurnCornerLeftEdge;
+	OutSnapshot.bCanRightTurnInsideCorner = bCanRightTurnInsideCorner;
+	OutSnapshot.bCanLeftTurnInsideCorner = bCanLeftTurnInsideCorner;
+	OutSnapshot.bCanRightTurnOutsideCorner = bCanRightTurnOutsideCorner;
+	OutSnapshot.bCanLeftTurnOutsideCorner = bCanLeftTurnOutsideCorner;
+	OutSnapshot.bIsLeftDashing = bIsLeftDashing;
+	OutSnapshot.bIsRightDashing = bIsRightDashing;
+	OutSnapshot.bClimbUpEnoughSpace = bClimbUpEnoughSpace;
+	OutSnapshot.bClimbUpTraceGround = bClimbUpTraceGround;
+	OutSnapshot.bCanGrabWallFromTop = bCanGrabWallFromTop;
+	OutSnapshot.bIsStaminaConsumSprinting = bIsStaminaConsumSprinting;
+	OutSnapshot.bIsLowerRightEdge = bIsLowerRightEdge;
+	OutSnapshot.bIsLowerLeftEdge = bIsLowerLeftEdge;
+}
+
+void UClimbingComponent::RestoreSnapshot(const FMainMovementSnapshot& Snapshot)
+{
+	UCharacterMovementComponent* Movement = CharacterOwner->GetCharacterMovement();
+
+	CharacterOwner->StopAnimMontage();
+	RestoreSnapshotState(Snapshot);
+
+	// The montages are gone, land montage driven states where their montage would have
+	if (MovementStatus == EMovementStatus::EMS_ClimbUp || MovementStatus == EMovementStatus::EMS_FrontFlip)
+	{
+		MovementStatus = EMovementStatus::EMS_Normal;
+		ResetUprightRotation();
+		Movement->SetMovementMode(EMovementMode::MOVE_Falling);
+		Movement->bOrientRotationToMovement = true;
+	}
+
+	// Dashes and corner turns end back in normal climbing
+	ClimbStatus = EClimbStatus::ECS_NormalClimb;
+	bIsLeftDashing = false;
+	bIsRightDashing = false;
+
+	// So do the deadlines the montages were timing : the wall jump's gravity comes back, the ledge is let go
+	if (MovementStatus == EMovementStatus::EMS_WallJumping && !bIsCanGrabWall)
+	{
+		Movement->GravityScale = 1.0f;
+		bIsCanGrabWall = true;
+	}
+	else if (MovementStatus == EMovementStatus::EMS_ClimbDown)
+	{
+		bIsCanGrabWall = true;
+	}
+	WallJumpGravityEndTime = -1.f;
+	ClimbDownGrabTime = -1.f;
+	FrontFlipEndTime = -1.f;
+
+	// No movement base, the probe results are world space until the next probe pass finds one
+	ClimbBase.Reset();
+	ClimbBaseBoneName = NAME_None;
+	ClimbBaseTransform = FTransform::Identity;
+	LocalNormalVectorBodyWallFacing = NormalVectorBodyWallFacing;
+	LocalBodyWallContactPoint = BodyWallContactPoint;
+	LocalFootWallContactPoint = FootWallContactPoint;
+	LocalClimbProbeLocation = CharacterOwner->GetActorLocation();
+	ClimbSurfacePhysMaterial.Reset();
+
+	UpdateClimbFrame();
+	ResetClimbIK();
+}
+
+void UClimbingComponent::RestoreSnapshotState(const FMainMovementSnapshot& Snapshot)
+{
+	UCharacterMovementComponent* Movement = CharacterOwner->GetCharacterMovement();
+	const FVector OriginOffset(GetWorld()->OriginLocation);
+	const float Time = GetClimbTime();
+
+	CharacterOwner->SetActorLocationAndRotation(Snapshot.Location - OriginOffset, Snapshot.Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	if (AController* Controller = CharacterOwner->GetController())
+	{
+		Controller->SetControlRotation(Snapshot.ControlRotation);
+	}
+
+	Movement->SetMovementMode((EMovementMode)Snapshot.MovementMode, Snapshot.CustomMovementMode);
+	Movement->Velocity = Snapshot.Velocity;
+	Movement->AirControl = Snapshot.AirControl;
+	Movement->RotationRate = FRotator(0.f, Snapshot.RotationRateYaw, 0.f);
+	Movement->BrakingDecelerationFalling = Snapshot.BrakingDecelerationFalling;
+	Movement->MaxWalkSpeed = Snapshot.MaxWalkSpeed;
+	Movement->MaxFlySpeed = Snapshot.MaxFlySpeed;
+	Movement->GravityScale = Snapshot.GravityScale;
+	Movement->bOrientRotationToMovement = Snapshot.bOrientRotationToMovement;
+
+	if (MainMovementComponent != nullptr)
+	{
+		MainMovementComponent->SetGliding(Snapshot.bIsGliding);
+		MainMovementComponent->SetGlideBankAngle(Snapshot.GlideBankAngle, Snapshot.GlideBankStepTime);
+	}
+	if (GliderMeshComponent != nullptr)
+	{
+		GliderMeshComponent->SetVisibility(Snapshot.bIsGliding);
+	}
+
+	MovementStatus = (EMovementStatus)Snapshot.MovementStatus;
+	ClimbStatus = (EClimbStatus)Snapshot.ClimbStatus;
+
+	NormalVectorBodyWallFacing = Snapshot.NormalVectorBodyWallFacing;
+	NormalVectorGrabWallFromTop = Snapshot.NormalVectorGrabWallFromTop;
+	BodyWallContactPoint = Snapshot.BodyWallContactPoint - OriginOffset;
+	FootWallContactPoint = Snapshot.FootWallContactPoint - OriginOffset;
+	PredictedClimbVelocity = Snapshot.PredictedClimbVelocity;
+
+	ClimbStartTerm = Snapshot.ClimbStartTerm;
+	GlidingCoolTime = Snapshot.GlidingCoolTime;
+	SprintJumpStaminaConsumDuration = Snapshot.SprintJumpStaminaConsumDuration;
+	ClimbUpGroundZ = Snapshot.ClimbUpGroundZ - OriginOffset.Z;
+	ClimbDownTargetZ = Snapshot.ClimbDownTargetZ - OriginOffset.Z;
+	ClimbPredictionRetraceTerm = Snapshot.ClimbPredictionRetraceTerm;
+	PredictedClimbContactTime = Snapshot.PredictedClimbContactTime;
+	ClimbSurfaceModifier = FClimbSurfaceModifier(Snapshot.ClimbSpeedMultiplier, Snapshot.ClimbStaminaMultiplier);
+	ClimbSurfaceWetness = Snapshot.ClimbSurfaceWetness;
+	WetSlipTimer = Snapshot.WetSlipTimer;
+	ClimbProbeDeltaTime = Snapshot.ClimbProbeDeltaTime;
+	LastWetSlipTime = Snapshot.WetSlipAge >= 0.f ? Time - Snapshot.WetSlipAge : -1.f;
+	LastClimbStopTime = Snapshot.ClimbStopAge >= 0.f ? Time - Snapshot.ClimbStopAge : -1.f;
+
+	bIsJumping = Snapshot.bIsJumping;
+	bWantsToSprint = Snapshot.bWantsToSprint;
+	bIsBracing = Snapshot.bIsBracing;
+	bTooFarFromWall = Snapshot.bTooFarFromWall;
+	bIsRightEdge = Snapshot.bIsRightEdge;
+	bIsLeftEdge = Snapshot.bIsLeftEdge;
+	bIsBottomEdge = Snapshot.bIsBottomEdge;
+	bIsFoothold = Snapshot.bIsFoothold;
+	bIsGround = Snapshot.bIsGround;
+	bIsTopEdge = Snapshot.bIsTopEdge;
+	bIsCanGrabWall = Snapshot.bIsCanGrabWall;
+	bIsBodyWallFacing = Snapshot.bIsBodyWallFacing;
+	bHasPredictedClimbContact = Snapshot.bHasPredictedClimbContact;
+	bIsClimbContactImminent = Snapshot.bIsClimbContactImminent;
+	bIsTurnCornerRightEdge = Snapshot.bIsTurnCornerRightEdge;
+	bIsTurnCornerLeftEdge = Snapshot.bIsTurnCornerLeftEdge;
+	bCanRightTurnInsideCorner = Snapshot.bCanRightTurnInsideCorner;
+	bCanLeftTurnInsideCorner = Snapshot.bCanLeftTurnInsideCorner;
+	bCanRightTurnOutsideCorner = Snapshot.bCanRightTurnOutsideCorner;
+	bCanLeftTurnOutsideCorner = Snapshot.bCanLeftTurnOutsideCorner;
+	bIsLeftDashing = Snapshot.bIsLeftDashing;
+	bIsRightDashing = Snapshot.bIsRightDashing;
+	bClimbUpEnoughSpace = Snapshot.bClimbUpEnoughSpace;
+	bClimbUpTraceGround = Snapshot.bClimbUpTraceGround;
+	bCanGrabWallFromTop = Snapshot.bCanGrabWallFromTop;
+	bIsStaminaConsumSprinting = Snapshot.bIsStaminaConsumSprinting;
+	bIsLowerRightEdge = Snapshot.bIsLowerRightEdge;
+	bIsLowerLeftEdge = Snapshot.bIsLowerLeftEdge;
+}
+
+void UClimbingComponent::CaptureRollbackState(FClimbRollbackState& OutState) const
+{
+	const UAnimInstance* AnimInstance = CharacterOwner->GetMesh() != nullptr ? CharacterOwner->GetMesh()->GetAnimInstance() : nullptr;
+	OutState.Montage = AnimInstance != nullptr ? AnimInstance->GetCurrentActiveMontage() : nullptr;
+	OutState.MontagePosition = OutState.Montage != nullptr ? AnimInstance->Montage_GetPosition(OutState.Montage) : 0.f;
+	OutState.MontagePlayRate = OutState.Montage != nullptr ? AnimInstance->Montage_GetPlayRate(OutState.Montage) : 1.f;
+
+	OutState.WallJumpGravityEndTime = WallJumpGravityEndTime;
+	OutState.ClimbDownGrabTime = ClimbDownGrabTime;
+	OutState.FrontFlipEndTime = FrontFlipEndTime;
+
+	OutState.ClimbBase = ClimbBase;
+	OutState.ClimbBaseBoneName = ClimbBaseBoneName;
+	OutState.ClimbBaseTransform = ClimbBaseTransform;
+	OutState.LocalNormalVectorBodyWallFacing = LocalNormalVectorBodyWallFacing;
+	OutState.LocalBodyWallContactPoint = LocalBodyWallContactPoint;
+	OutState.LocalFootWallContactPoint = LocalFootWallContactPoint;
+	OutState.LocalClimbProbeLocation = LocalClimbProbeLocation;
+	OutState.ClimbSurfacePhysMaterial = ClimbSurfacePhysMaterial;
+
+	OutState.ClimbIKTargets = ClimbIKTargets;
+	for (int32 Hand = 0; Hand < 2; ++Hand)
+	{
+		OutState.ClimbIKHandContacts[Hand] = ClimbIKHandContacts[Hand];
+		OutState.bClimbIKHandContacts[Hand] = bClimbIKHandContacts[Hand];
+	}
+}
+
+void UClimbingComponent::RestoreRollbackState(const FMainMovementSnapshot& Snapshot, const FClimbRollbackState& State)
+{
+	RestoreSnapshotState(Snapshot);
+
+	// Seek the frame's montage back instead of stopping it, re-simulating plays it on and its notifies end what it drives
+	UAnimInstance* AnimInstance = CharacterOwner->GetMesh() != nullptr ? CharacterOwner->GetMesh()->GetAnimInstance() : nullptr;
+	if (AnimInstance != nullptr)
+	{
+		if (State.Montage == nullptr)
+		{
+			AnimInstance->Montage_Stop(0.f);
+		}
+		else if (AnimInstance->Montage_IsPlaying(State.Montage))
+		{
+			AnimInstance->Montage_SetPosition(State.Montage, State.MontagePosition);
+			AnimInstance->Montage_SetPlayRate(State.Montage, State.MontagePlayRate);
+		}
+		else
+		{
+			AnimInstance->Montage_Play(State.Montage, State.MontagePlayRate, EMontagePlayReturnType::MontageLength, State.MontagePosition);
+		}
+	}
+
+	WallJumpGravityEndTime = State.WallJumpGravityEndTime;
+	ClimbDownGrabTime = State.ClimbDownGrabTime;
+	FrontFlipEndTime = State.FrontFlipEndTime;
+
+	ClimbBase = State.ClimbBase;
+	ClimbBaseBoneName = State.ClimbBaseBoneName;
+	ClimbBaseTransform = State.ClimbBaseTransform;
+	LocalNormalVectorBodyWallFacing = State.LocalNormalVectorBodyWallFacing;
+	LocalBodyWallContactPoint = State.LocalBodyWallContactPoint;
+	LocalFootWallContactPoint = State.LocalFootWallContactPoint;
+	LocalClimbProbeLocation = State.LocalClimbProbeLocation;
+	ClimbSurfacePhysMaterial = State.ClimbSurfacePhysMaterial;
+
+	ClimbIKTargets = State.ClimbIKTargets;
+	for (int32 Hand = 0; Hand < 2; ++Hand)
+	{
+		ClimbIKHandContacts[Hand] = State.ClimbIKHandContacts[Hand];
+		bClimbIKHandContacts[Hand] = State.bClimbIKHandContacts[Hand];
+	}
+
+	UpdateClimbFrame();
+}
+
+void UClimbingComponent::ClimbDeadlineManager()
+{
+	UCharacterMovementComponent* Movement = CharacterOwner->GetCharacterMovement();
+	const float Time = GetClimbTime();
+
+	if (WallJumpGravityEndTime >= 0.f && Time >= WallJumpGravityEndTime)
+	{
+		WallJumpGravityEndTime = -1.f;
+		Movement->GravityScale = 1.0f;
+		bIsCanGrabWall = true;
+	}
+
+	if (ClimbDownGrabTime >= 0.f && Time >= ClimbDownGrabTime)
+	{
+		ClimbDownGrabTime = -1.f;
+		bIsCanGrabWall = true;
+	}
+
+	if (FrontFlipEndTime >= 0.f && Time >= FrontFlipEndTime)
+	{
+		FrontFlipEndTime = -1.f;
+		Movement->SetMovementMode(EMovementMode::MOVE_Falling);
+		SetMovementStatus(EMovementStatus::EMS_Normal);
+		Movement->bOrientRotationToMovement = true;
+	}
+}
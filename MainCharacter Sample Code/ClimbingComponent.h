@@ -0,0 +1,849 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WorldCollision.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "ClimbDirection.h"
+#include "StaminaComponent.h"
+#include "ClimbNavigationSubsystem.h"
+#include "ClimbingComponent.generated.h"
+
+UENUM(BlueprintType)
+enum class EMovementStatus : uint8
+{
+	EMS_Normal UMETA(DisplayName = "Normal"),
+	EMS_Sprinting UMETA(DisplayName = "Sprinting"),
+	EMS_Climbing UMETA(DisplayName = "Climbing"),
+	EMS_Gliding UMETA(DisplayName = "Gliding"),
+	EMS_ClimbUp UMETA(DisplayName = "Climb Up"),
+	EMS_ClimbDown UMETA(DisplayName = "Climb Down"),
+	EMS_WallJumping UMETA(DisplayName = "Wall Jumping"),
+	EMS_HaltClimbing UMETA(DisplayName = "Halt Climbing"),
+	EMS_FrontFlip UMETA(DisplayName = "Front Flip"),
+	EMS_MAX UMETA(DisplayName = "DefaultMAX")
+};
+
+UENUM(BlueprintType)
+enum class EClimbStatus : uint8
+{
+	ECS_NormalClimb UMETA(DisplayName = "Normal Climb"),
+	ECS_DashJump UMETA(DispayName = "Dash Jump"),
+	ECS_TurnCorner UMETA(DispayName = "Turn Corner"),
+	ESS_MAX UMETA(DisplayName = "DefaultMax")
+};
+
+UENUM(BlueprintType)
+enum class EClimbLOD : uint8
+{
+	ECL_Full UMETA(DisplayName = "Full"),
+	ECL_Reduced UMETA(DisplayName = "Reduced"),
+	ECL_None UMETA(DisplayName = "None"),
+	ECL_MAX UMETA(DisplayName = "DefaultMax")
+};
+
+/** Climb probes scheduled by UClimbProbeSchedulerSubsystem, in priority order */
+UENUM(BlueprintType)
+enum class EClimbProbeType : uint8
+{
+	ECP_Maintain UMETA(DisplayName = "Maintain"),
+	ECP_ClimbUp UMETA(DisplayName = "Climb Up"),
+	ECP_TurnCorner UMETA(DisplayName = "Turn Corner"),
+	ECP_StartClimb UMETA(DisplayName = "Start Climb"),
+	ECP_GrabFromTop UMETA(DisplayName = "Grab From Top"),
+	ECP_MAX UMETA(DisplayName = "DefaultMax")
+};
+
+/** One climbing trace or sweep as it ran in a recorded frame */
+struct FClimbProbeRecord
+{
+	FVector Start;
+	FVector End;
+
+	/** Zero for line traces */
+	FVector ShapeExtent;
+
+	FHitResult Hit;
+	bool bHit;
+};
+
+/** One climb LOD or probe scheduler decision of a recorded frame, ECP_MAX marks the LOD gate */
+struct FClimbProbeGate
+{
+	EClimbProbeType Type;
+	bool bGranted;
+};
+
+/**
+ * The world queries of one simulated frame, in the order the climbing code asked them.
+ * Rollback re-simulation answers its probes from here instead of the physics scene (UClimbingComponent::BeginClimbProbeFrame).
+ */
+struct FClimbProbeFrame
+{
+	TArray<FClimbProbeRecord> Traces;
+
+	/** Climb LOD and probe scheduler decisions, so the re-simulated frame probes when this one did */
+	TArray<FClimbProbeGate> Gates;
+
+	void Reset()
+	{
+		Traces.Reset();
+		Gates.Reset();
+	}
+};
+
+enum class EClimbActionResult : uint8
+{
+	None,		// state doesn't allow the action yet, keep it buffered
+	Performed,
+	PerformedMontage
+};
+
+/** How a climbing surface type scales the climb speed and the climbing stamina drain */
+USTRUCT(BlueprintType)
+struct FClimbSurfaceModifier
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Surface")
+	float ClimbSpeedMultiplier;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Surface")
+	float StaminaMultiplier;
+
+	FClimbSurfaceModifier()
+		: ClimbSpeedMultiplier(1.f)
+		, StaminaMultiplier(1.f)
+	{
+	}
+
+	FClimbSurfaceModifier(float InClimbSpeedMultiplier, float InStaminaMultiplier)
+		: ClimbSpeedMultiplier(InClimbSpeedMultiplier)
+		, StaminaMultiplier(InStaminaMultiplier)
+	{
+	}
+};
+
+/** World space hand and foot effectors while climbing, an alpha of 0 leaves the limb to the animation */
+USTRUCT(BlueprintType)
+struct FClimbIKTargets
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Climb IK")
+	FVector LeftHandLocation;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Climb IK")
+	FVector RightHandLocation;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Climb IK")
+	FVector LeftFootLocation;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Climb IK")
+	FVector RightFootLocation;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Climb IK")
+	FVector WallNormal;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Climb IK")
+	float LeftHandAlpha;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Climb IK")
+	float RightHandAlpha;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Climb IK")
+	float LeftFootAlpha;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Climb IK")
+	float RightFootAlpha;
+
+	FClimbIKTargets()
+		: LeftHandLocation(FVector::ZeroVector)
+		, RightHandLocation(FVector::ZeroVector)
+		, LeftFootLocation(FVector::ZeroVector)
+		, RightFootLocation(FVector::ZeroVector)
+		, WallNormal(FVector::ZeroVector)
+		, LeftHandAlpha(0.f)
+		, RightHandAlpha(0.f)
+		, LeftFootAlpha(0.f)
+		, RightFootAlpha(0.f)
+	{
+	}
+};
+
+/**
+ * What a rollback frame keeps of the climbing state besides its FMainMovementSnapshot : the playing montage,
+ * the climb clock deadlines of the montage driven states, the movement base and the limb targets.
+ * The snapshot leaves those out or lands them for a save game, a re-simulated frame continues them instead.
+ * In memory only, the montage and the base are object pointers.
+ */
+struct FClimbRollbackState
+{
+	/** Null when no montage was playing */
+	class UAnimMontage* Montage;
+	float MontagePosition;
+	float MontagePlayRate;
+
+	float WallJumpGravityEndTime;
+	float ClimbDownGrabTime;
+	float FrontFlipEndTime;
+
+	TWeakObjectPtr<UPrimitiveComponent> ClimbBase;
+	FName ClimbBaseBoneName;
+	FTransform ClimbBaseTransform;
+	FVector LocalNormalVectorBodyWallFacing;
+	FVector LocalBodyWallContactPoint;
+	FVector LocalFootWallContactPoint;
+	FVector LocalClimbProbeLocation;
+	TWeakObjectPtr<UPhysicalMaterial> ClimbSurfacePhysMaterial;
+
+	FClimbIKTargets ClimbIKTargets;
+	FVector ClimbIKHandContacts[2];
+	bool bClimbIKHandContacts[2];
+};
+
+/** The character grabbed a wall, actions pressed before it were meant for the previous movement */
+DECLARE_MULTICAST_DELEGATE(FOnClimbStarted);
+
+/**
+ * Climbing, gliding and the movement state machine with its probes, for any ACharacter.
+ * Driven by a desired move direction instead of key input, so AI pawns can climb without the player's camera and input.
+ * Walking and gliding movement stay with the owner (path following, or AMain's camera relative input),
+ * this component moves the character along the wall. Stamina goes through the owner's UStaminaComponent.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class SECOND_API UClimbingComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+private:
+	EMovementStatus MovementStatus;
+	EClimbStatus ClimbStatus;
+
+public:
+	UClimbingComponent();
+
+	UPROPERTY()
+	class ACharacter* CharacterOwner;
+
+	UPROPERTY()
+	class UStaminaComponent* StaminaComponent;
+
+	/** Null when the owner doesn't use UMainMovementComponent, gliding then falls with the default movement */
+	UPROPERTY()
+	class UMainMovementComponent* MainMovementComponent;
+
+	/** Optional, shown while gliding */
+	UPROPERTY()
+	class USkeletalMeshComponent* GliderMeshComponent;
+
+	FOnClimbStarted OnClimbStarted;
+
+	/* Desired Movement (set by the owner's input or AI) */
+
+	/** X is forward (up on the wall), Y is right */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climbing Input")
+	FVector2D DesiredMoveDirection;
+
+	/** Yaw the desired direction is relative to while not climbing */
+	float DesiredMoveYaw;
+
+	/** Desired direction after the wall edges and bracing, what the climbing logic reads */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climbing Input")
+	FVector2D ClimbMoveInput;
+
+	bool bWantsToSprint;
+
+	/** Holding still on the wall, a jump then becomes a wall jump */
+	bool bIsBracing;
+
+	/* Normal */
+	/** Jump */
+	bool bIsJumping;
+
+	/* Climbing Variable */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Climbing)
+	float ClimbingStaminaConsumption;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Climbing)
+	float InitClimbStartTerm;
+	float ClimbStartTerm;
+
+	bool bTooFarFromWall;
+	bool bIsRightEdge;
+	bool bIsLeftEdge;
+	bool bIsBottomEdge;
+	bool bIsFoothold;
+	bool bIsGround;
+	bool bIsTopEdge;
+	bool bIsCanGrabWall;
+
+	bool bIsBodyWallFacing;
+	FVector NormalVectorBodyWallFacing;
+
+	/**
+	 * Climbing::Wall Tangent Frame, the axes every probe is offset along (forward into the wall, up along it).
+	 * Taken from the actor once per probe pass and whenever this component turns the character,
+	 * so walls, overhangs and ceilings all probe the same way
+	 */
+	FVector ClimbFrameForward;
+	FVector ClimbFrameRight;
+	FVector ClimbFrameUp;
+
+	/** How fast the character turns to follow a curved wall */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Orientation")
+	float ClimbAlignSpeed;
+
+	/** A wall with less world up along it than this is climbed as a ceiling */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Orientation")
+	float ClimbCeilingThreshold;
+
+	/** Climbing up over the top edge needs a wall this close to vertical (world Z of its up axis) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Orientation")
+	float ClimbUpMinWallUpZ;
+
+	/**
+	 * Climbing::Surface, by the surface type of the wall's physical material. The defaults expect
+	 * SurfaceType1 Rock, SurfaceType2 Wet Rock, SurfaceType3 Ice and SurfaceType4 Wood in the project's physical surfaces
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Surface")
+	TMap<TEnumAsByte<EPhysicalSurface>, FClimbSurfaceModifier> ClimbSurfaceModifiers;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climb Surface")
+	FClimbSurfaceModifier ClimbSurfaceModifier;
+
+	/** Physical material of the wall hit ClimbSurfaceModifier was looked up for, staying on it is a pointer compare */
+	TWeakObjectPtr<UPhysicalMaterial> ClimbSurfacePhysMaterial;
+
+	/** MaxFlySpeed at BeginPlay, scaled by the surface while climbing */
+	float ClimbSpeed;
+
+	/* Climbing::Wetness (rain, sampled from UClimbWetnessSubsystem every climbing tick) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climb Wetness")
+	float ClimbSurfaceWetness;
+
+	/** Climb speed scale on a soaked wall, blended in by the wetness */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Wetness")
+	float WetClimbSpeedMultiplier;
+
+	/** Seconds of climbing up a soaked wall between slips, longer on drier walls */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Wetness")
+	float WetSlipInterval;
+	float WetSlipTimer;
+
+	/** A slip slides the character down the wall for this long, ignoring the climbing input */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Wetness")
+	float WetSlipDuration;
+	float LastWetSlipTime;
+
+	UPROPERTY()
+	class UClimbWetnessSubsystem* WetnessSubsystem;
+
+	/** Where the body wall facing and foothold (or bottom edge) probes last hit, the IK wall planes */
+	FVector BodyWallContactPoint;
+	FVector FootWallContactPoint;
+
+	/**
+	 * Climbing::Movement Base, the movable wall (platform, airship, creature bone) being climbed.
+	 * The wall probes are kept in its space and carried along with it every frame, they are only
+	 * traced again once the character moves on the base or the base can change shape (skinned meshes)
+	 */
+	TWeakObjectPtr<UPrimitiveComponent> ClimbBase;
+	FName ClimbBaseBoneName;
+
+	/** The base's transform the local probe results are relative to, identity without a base */
+	FTransform ClimbBaseTransform;
+
+	FVector LocalNormalVectorBodyWallFacing;
+	FVector LocalBodyWallContactPoint;
+	FVector LocalFootWallContactPoint;
+
+	/** Character location in the base's space when the wall was last probed */
+	FVector LocalClimbProbeLocation;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Movement Base")
+	float ClimbBaseRetraceTolerance;
+
+	/** False while the probe results on the base still hold, decided once per probe pass */
+	bool bClimbBaseRetrace;
+
+	/** Climbing::Hand & Foot IK (solved by the anim graph's two bone IK nodes on the animation thread) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb IK")
+	float ClimbIKHandHeight;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb IK")
+	float ClimbIKHandSpacing;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb IK")
+	float ClimbIKFootHeight;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb IK")
+	float ClimbIKFootSpacing;
+
+	/** Keeps the palms and soles this far off the wall surface */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb IK")
+	float ClimbIKWallOffset;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb IK")
+	float ClimbIKInterpSpeed;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climb IK")
+	FClimbIKTargets ClimbIKTargets;
+
+	/** Async hand rays (left, right), issued with the climbing probes and read back the next frame */
+	FTraceHandle ClimbIKHandTraceHandles[2];
+	FVector ClimbIKHandContacts[2];
+	bool bClimbIKHandContacts[2];
+
+	/** Climbing::Start Climb Prediction (while gliding & wall jumping) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Start Prediction")
+	float ClimbPredictionTime;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Start Prediction")
+	float ClimbPredictionLeadTime;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Start Prediction")
+	float ClimbPredictionVelocityTolerance;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Start Prediction")
+	float InitClimbPredictionRetraceTerm;
+	float ClimbPredictionRetraceTerm;
+
+	bool bHasPredictedClimbContact;
+	bool bIsClimbContactImminent;
+	float PredictedClimbContactTime;
+	FVector PredictedClimbVelocity;
+
+	/** Climbing::Turn Corner */
+	bool bIsTurnCornerRightEdge;
+	bool bIsTurnCornerLeftEdge;
+
+	/*** Inside Corner */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Turn Corner")
+	UAnimMontage* TurnCornerInsideRightAnimMontage;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Turn Corner")
+	UAnimMontage* TurnCornerInsideLeftAnimMontage;
+
+	bool bCanRightTurnInsideCorner;
+	bool bCanLeftTurnInsideCorner;
+
+	/*** Outside Corner */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Turn Corner")
+	UAnimMontage* TurnCornerOutsideRightAnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Turn Corner")
+	UAnimMontage* TurnCornerOutsideLeftAnimMontage;
+	
+	bool bCanRightTurnOutsideCorner;
+	bool bCanLeftTurnOutsideCorner;
+
+	/** Climbing::Dash Jump */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
+	UAnimMontage* ClimbingDash_U_AnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
+	UAnimMontage* ClimbingDash_D_AnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
+	UAnimMontage* ClimbingDash_R_AnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
+	UAnimMontage* ClimbingDash_L_AnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
+	UAnimMontage* ClimbingDash_UR_AnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
+	UAnimMontage* ClimbingDash_DR_AnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
+	UAnimMontage* ClimbingDash_UL_AnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
+	UAnimMontage* ClimbingDash_DL_AnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
+	float ClimbDashStaminaConsumption;	
+
+	bool bIsLeftDashing;
+	bool bIsRightDashing;
+
+	/* Climb Up Variable */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Up")
+	UAnimMontage* ClimbUpAnimMontage;
+
+	bool bClimbUpEnoughSpace;
+	bool bClimbUpTraceGround;
+	float ClimbUpGroundZ;
+
+	/* Climb Down Variable */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Down")
+	UAnimMontage* GrabWallFromTopAnimMontage;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climb Down") // using UPROPERTY for show message to player (ex: press F key for Climb Down)
+	bool bCanGrabWallFromTop;
+
+	FVector NormalVectorGrabWallFromTop;
+
+	/** Climb Down::Descent (frame-rate independent, swept). Without a grab montage to pace it, cm/s */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Down")
+	float ClimbDownSpeed;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Down")
+	float ClimbDownLedgeDepth;
+
+	float ClimbDownTargetZ;
+
+	/** Climb clock time the grab montage lets go of the ledge and the wall below can be grabbed, negative when not pending */
+	float ClimbDownGrabTime;
+
+	/* Sprinting Variable */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sprinting")
+	float SprintStaminaConsumption;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sprinting")
+	float InitSprintJumpStaminaConsumDuration;
+	float SprintJumpStaminaConsumDuration;
+	
+	bool bIsStaminaConsumSprinting;
+
+	/* Front Flip Variable */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Front Flip")
+	UAnimMontage* FrontFlipAnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Front Flip")
+	float FrontFlipStaminaConsumption;
+
+	/** Climb clock time the flip montage ends and the character falls, negative when not pending */
+	float FrontFlipEndTime;
+
+	bool bIsLowerRightEdge;
+	bool bIsLowerLeftEdge;
+
+	/** ClimbFrameCounter of the edge, foothold and wall facing probes last run by ClimbStartEnoughSpaceConditionForGround */
+	uint64 LastGroundProbeFrame;
+
+	/** ClimbFrameCounter of the ledge probe last granted in MovementStatusManager */
+	uint64 LastGrabFromTopProbeFrame;
+
+	/* Wall Jumping */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wall Jump")
+	UAnimMontage* WallJumpAnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wall Jump")
+	float WallJumpStaminaConsumption;
+
+	/** Wall jump is still allowed this long after falling off the wall */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wall Jump")
+	float ClimbCoyoteTime;
+	float LastClimbStopTime;
+
+	/** Climb clock time the jump's low gravity ends and a wall can be grabbed again, negative when not pending */
+	float WallJumpGravityEndTime;
+
+	/* Gliding */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding")
+	UAnimMontage* StartGlidingAnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding")
+	float GlidingStaminaConsumption;
+
+	UPROPERTY(EditAnywhere, BlueprintReadonly, Category = "Gliding")
+	float InitGlidingCoolTime;
+	float GlidingCoolTime;
+
+	// for debugging
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
+	bool bDrawDebugLine;
+
+	/* Climb LOD (probe frequency by significance, assigned by UClimbSignificanceSubsystem) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb LOD")
+	float ClimbLODMaxDistance;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb LOD")
+	float FullClimbLODSignificance;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb LOD", meta = (ClampMin = "1"))
+	int32 ReducedClimbProbeInterval;
+
+	EClimbLOD ClimbLOD;
+	int32 ClimbProbeFrameCounter;
+	float ClimbProbeDeltaTime;
+
+	/* Climb Probe Schedule (set by UClimbProbeSchedulerSubsystem) */
+	uint8 ClimbProbeGrantMask;
+
+	/** Frames each probe type has been deferred for, its flags are that old */
+	int32 ClimbProbeStaleFrames[(int32)EClimbProbeType::ECP_MAX];
+
+	/* Climb Clock (advanced by MovementManager, so rollback re-simulation runs the timers again) */
+	float ClimbTime;
+	uint64 ClimbFrameCounter;
+
+	/* Climb Probe Record & Replay */
+	/** How far a re-simulated probe may start or end from the recorded one and still reuse its result (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Rollback")
+	float ClimbProbeReplayTolerance;
+
+	FClimbProbeFrame* ClimbProbeRecordFrame;
+	const FClimbProbeFrame* ClimbProbeReplayFrame;
+	int32 ClimbProbeReplayTraceIndex;
+	int32 ClimbProbeReplayGateIndex;
+
+	/** Re-simulated probes that found no recorded match and hit physics, since BeginClimbProbeFrame */
+	int32 ClimbProbeReplayMisses;
+
+protected:
+	virtual void OnRegister() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Moves the cached wall contacts and targets with the world origin when it is rebased, called by the owner */
+	virtual void ApplyWorldOffset(const FVector& InOffset, bool bWorldShift) override;
+
+	/* Snapshot (AMain::SaveMovementSnapshot) */
+	void CaptureSnapshot(struct FMainMovementSnapshot& OutSnapshot) const;
+
+	/** Puts the character and the climbing state back without tracing */
+	void RestoreSnapshot(const struct FMainMovementSnapshot& Snapshot);
+
+	/** The snapshot's state as captured, shared by both restores */
+	void RestoreSnapshotState(const struct FMainMovementSnapshot& Snapshot);
+
+	/* Snapshot::Rollback (AMain rollback frames) */
+	void CaptureRollbackState(FClimbRollbackState& OutState) const;
+
+	/**
+	 * Rollback's restore : the snapshot exactly as captured, nothing landed as for a save game, with the montage sought
+	 * back to its position and the frame's deadlines, movement base and limb targets, so re-simulating carries them on
+	 */
+	void RestoreRollbackState(const struct FMainMovementSnapshot& Snapshot, const FClimbRollbackState& State);
+
+	/* Climb Clock */
+	FORCEINLINE float GetClimbTime() const { return ClimbTime; }
+
+	/** Rollback rewinds the clock to the restored frame's */
+	FORCEINLINE void SetClimbTime(float Time) { ClimbTime = Time; }
+
+	/** Ends the montage waits due by now. On the climb clock instead of timers, so a rollback rewinds and re-runs them */
+	void ClimbDeadlineManager();
+
+	/* Climb Probe Record & Replay (AMain rollback) */
+	/**
+	 * Until EndClimbProbeFrame, climbing traces and probe decisions are appended to RecordFrame and,
+	 * when ReplayFrame is set, answered from it. Hand IK doesn't trace while replaying.
+	 */
+	void BeginClimbProbeFrame(FClimbProbeFrame* RecordFrame, const FClimbProbeFrame* ReplayFrame);
+	void EndClimbProbeFrame();
+	FORCEINLINE bool IsReplayingClimbProbes() const { return ClimbProbeReplayFrame != nullptr; }
+	FORCEINLINE int32 GetClimbProbeReplayMisses() const { return ClimbProbeReplayMisses; }
+
+	bool ClimbLineTrace(FHitResult& OutHit, const FVector& Start, const FVector& End, const FCollisionQueryParams& Params);
+	bool ClimbSweep(FHitResult& OutHit, const FVector& Start, const FVector& End, const FQuat& Rotation, const FCollisionShape& Shape, const FCollisionQueryParams& Params);
+
+	/* AI Facing API */
+	UFUNCTION(BlueprintCallable)
+	void SetDesiredMoveDirection(FVector2D Direction, float ReferenceYaw);
+
+	/** World space direction, along the wall while climbing */
+	UFUNCTION(BlueprintCallable)
+	void SetDesiredWorldDirection(FVector WorldDirection);
+
+	UFUNCTION(BlueprintCallable)
+	void SetWantsToSprint(bool bSprint);
+
+	UFUNCTION(BlueprintCallable)
+	void SetBracing(bool bBrace);
+
+	/** Contextual jump : climb dash, wall jump, start or stop gliding, front flip or a plain jump */
+	EClimbActionResult JumpAction();
+	EClimbActionResult GrabWallFromTopAction();
+
+	/** Lets go of the wall */
+	UFUNCTION(BlueprintCallable)
+	void ReleaseWall();
+
+	/** Least stamina needed from here to climb to TargetLedge, against this character's MaxStamina */
+	UFUNCTION(BlueprintCallable)
+	EClimbStaminaQueryResult QueryRequiredStamina(FVector TargetLedge, float& RequiredStamina);
+
+	void Jump();
+
+	/* Managers (in this order every tick) */
+	void MovementManager(float DeltaTime);
+	void StaminaManager(float DeltaTime);
+
+	void SprintManager();
+	void ClimbMovementManager();
+
+	/** Without bRunProbes only the transitions that need no trace run, for a character at climb LOD None */
+	void MovementStatusManager(float DeltaTime, bool bRunProbes);
+	void StaminaStatusManager(float DeltaTime);
+	void StaminaDrainManager();
+	bool ClimbingStaminaDrainCondition();
+
+	/* Climb LOD */
+	UFUNCTION(BlueprintCallable)
+	EClimbLOD GetClimbLOD();
+
+	UFUNCTION(BlueprintCallable)
+	void SetClimbLOD(EClimbLOD LOD);
+
+	bool ClimbLODCondition(float DeltaTime);
+	float CalculateClimbSignificance(const FTransform& Viewpoint) const;
+
+	/* Climb Probe Schedule */
+	bool ClimbProbeCondition(EClimbProbeType Type);
+	bool IsClimbProbeStale(EClimbProbeType Type) const;
+
+	/** True when the replayed frame recorded a gate of this type, OutGranted is then its decision */
+	bool ReplayClimbProbeGate(EClimbProbeType Type, bool& bOutGranted);
+	void RecordClimbProbeGate(EClimbProbeType Type, bool bGranted);
+
+	/* Status */
+	UFUNCTION(BlueprintCallable)
+	EMovementStatus GetMovementStatus();
+
+	UFUNCTION(BlueprintCallable)
+	void SetMovementStatus(EMovementStatus Status);
+
+	UFUNCTION(BlueprintCallable)
+	EClimbStatus GetClimbStatus();
+
+	UFUNCTION(BlueprintCallable)
+	void SetClimbStatus(EClimbStatus Status);
+
+
+	/* Start Climb */
+	bool StartClimbAtNormalStatusCondition(float DeltaTime);
+	bool StartClimbWhileGlidingCondition(float DeltaTime);
+	bool StartClimbWhileWallJumpCondition(float DeltaTime);
+
+	/* Start Climb Prediction */
+	void PredictClimbContact();
+	bool ClimbContactPredictionCondition(float DeltaTime);
+	void ResetClimbContactPrediction();
+
+	/* Climbing */
+	void StartClimb();
+	void StopClimb();
+
+	/** Back upright, yaw kept. Every way off the wall goes through it, an overhang or a ceiling leaves pitch and roll */
+	void ResetUprightRotation();
+
+	bool ClimbStartEnoughSpaceConditionForGround();
+	bool ClimbStartInputDirectionCondition();
+	bool ClimbStartEnoughSpaceCondition();
+	bool ClimbMaintainCondition();
+	
+	void SetIsFoothold();
+	void SetIsTopEdge();
+	void SetIsBottomEdge();
+	void SetIsRightLeftEdgeAtNormal();
+	void SetIsRightLeftEdgeAtClimbing();
+	void SetIsGround();
+
+	void SetIsBodyWallFacingAndNormalVector();
+
+	/* Climbing::Wall Tangent Frame */
+	void UpdateClimbFrame();
+	FQuat GetClimbRotation(const FVector& WallNormal) const;
+	void AlignCharacterToWall(float DeltaTime);
+
+	/* Climbing::Movement Base */
+	void ClimbBaseManager();
+	void SetClimbBase(const FHitResult& Hit);
+	FTransform GetClimbBaseWorldTransform() const;
+	bool ClimbBaseRetraceCondition();
+
+	/* Climbing::Surface */
+	void UpdateClimbSurface(const FHitResult& Hit);
+
+	/* Climbing::Wetness */
+	bool WetSlipCondition(float DeltaTime);
+	void WetSlip();
+
+	UFUNCTION(BlueprintCallable)
+	bool IsWetSlipping() const;
+
+	/* Climbing::Hand & Foot IK */
+	void ClimbIKManager(float DeltaTime);
+	void RequestClimbIKTraces();
+	void ResetClimbIK();
+
+	/* Climbing Attach to wall*/
+	void AttachCharacterToWall();
+	void SetTooFarFromWall();
+
+	/* Climbing::Turn Corner */
+	void TurnCorner();
+	bool TurnCornerCondition();
+	// Variable Initialization
+	void TurnCornerVariableRenewal();
+	// Inside
+	void TurnCornerInsideRight();
+	void TurnCornerInsideLeft();
+	bool TurnCornerInsideRightCondition();
+	bool TurnCornerInsideLeftCondition();
+	void SetCanRightTurnInsideCorner();
+	void SetCanLeftTurnInsideCorner();
+	// Outside
+	void TurnCornerOutsideRight();
+	void TurnCornerOutsideLeft();
+	bool TurnCornerOutsideRightCondition();
+	bool TurnCornerOutsideLeftCondition();
+	void SetCanRightTurnOutsideCorner();
+	void SetCanLeftTurnOutsideCorner();
+
+	/* Climbing::Dash Jump*/
+
+	void ClimbDashJump();
+	bool ClimbDashJumpCondition();
+	UAnimMontage* GetClimbDashAnimMontage(EClimbDirection Direction) const;
+
+	/** Octant of the current climbing input, shared by dash, climb start and corner logic */
+	FORCEINLINE EClimbDirection GetClimbInputDirection() const { return ClimbDirection::Classify(ClimbMoveInput.X, ClimbMoveInput.Y); }
+
+	void ClimbDashJumpStaminaManage();
+
+	/* Climb Up */
+	void ClimbUp();
+	bool ClimbUpCondition();
+	void SetClimbUpEnoughSpace();
+	void SetClimbUpTraceGround();
+
+	void AttachCharacterToGround();
+
+	/* Climb Down */
+	void GrabWallFromTop();
+	bool GrabWallFromTopCondition();
+	void SetCanGrabWallFromTopAndNormalVector();
+	void SetClimbDownTargetZ();
+	void ClimbDownDescent(float DeltaTime);
+	float GetClimbDownSpeed() const;
+
+	/* Front Flip */
+	void FrontFlip();
+	bool FrontFlipCondition();
+	void SetIsLowerRightLeftEdgeAtGround();
+
+	void FrontFlipStaminaManage();
+
+	/* Wall Jump */
+	void WallJump();
+	bool WallJumpCondition();
+	void WallJumpStaminaManage();
+
+
+	/* Glidinig */
+	void StartGliding();
+	void StopGliding();
+	bool EnoughSpaceForGliding();
+	bool GlidingCondition();
+};
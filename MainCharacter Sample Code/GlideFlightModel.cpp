@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GlideFlightModel.h"
+
+FGlideFlightModel::FGlideFlightModel()
+{
+	LiftCoefficient = 0.7f;
+	DragCoefficient = 0.2f;
+	TerminalSinkRate = 200.f;
+	MaxBankAngle = 35.f;
+	BankRate = 90.f;
+	SubstepTime = 1.f / 120.f;
+}
+
+FVector FGlideFlightModel::Integrate(const FVector& Velocity, const FVector& AirVelocity, float& BankAngle, float& BankStepTime, float TargetBankAngle, float GravityZ, float DeltaTime) const
+{
+	if (DeltaTime <= 0.f)
+	{
+		return Velocity;
+	}
+
+	const float StepTime = FMath::Max(SubstepTime, 0.001f);
+	BankStepTime = FMath::Clamp(BankStepTime, 0.f, StepTime);
+
+	// Fast path : flying level without turn input, bank is constant so the closed form is exact.
+	// The bank steps keep their phase, a turn starting later steps on the same times
+	if (FMath::IsNearlyZero(BankAngle, 0.01f) && FMath::IsNearlyZero(TargetBankAngle, 0.01f))
+	{
+		BankAngle = 0.f;
+		BankStepTime -= DeltaTime;
+		if (BankStepTime <= 0.f)
+		{
+			BankStepTime = StepTime + FMath::Fmod(BankStepTime, StepTime);
+		}
+		return IntegrateClosedForm(Velocity, AirVelocity, 0.f, GravityZ, DeltaTime);
+	}
+
+	// Closed form between the bank steps, however the frame cuts them. No step cap, a hitch frame
+	// takes more steps instead of larger ones
+	FVector NewVelocity = Velocity;
+	float RemainingTime = DeltaTime;
+	while (RemainingTime > 0.f)
+	{
+		const float SegmentTime = FMath::Min(RemainingTime, BankStepTime);
+		NewVelocity = IntegrateClosedForm(NewVelocity, AirVelocity, BankAngle, GravityZ, SegmentTime);
+		RemainingTime -= SegmentTime;
+		BankStepTime -= SegmentTime;
+
+		if (BankStepTime <= 0.f)
+		{
+			BankAngle = FMath::FInterpConstantTo(BankAngle, TargetBankAngle, StepTime, BankRate);
+			BankStepTime += StepTime;
+		}
+	}
+
+	return NewVelocity;
+}
+
+FVector FGlideFlightModel::IntegrateClosedForm(const FVector& Velocity, const FVector& AirVelocity, float BankAngle, float GravityZ, float DeltaTime) const
+{
+	// dVz/dt = G * (1 - Lift * cos(Bank)) - K * (Vz - Wz)  ->  Vz(t) = Vt + (Vz0 - Vt) * exp(-K * t), Vt = Wz + G' / K
+	const float SinkDrag = GetSinkDragCoefficient(GravityZ);
+	if (SinkDrag <= 0.f)
+	{
+		return Velocity;
+	}
+
+	const float EffectiveGravityZ = GravityZ * (1.f - LiftCoefficient * FMath::Cos(FMath::DegreesToRadians(BankAngle)));
+	const float TerminalVelocityZ = AirVelocity.Z + EffectiveGravityZ / SinkDrag;
+
+	FVector NewVelocity;
+	NewVelocity.Z = TerminalVelocityZ + (Velocity.Z - TerminalVelocityZ) * FMath::Exp(-SinkDrag * DeltaTime);
+
+	// dVh/dt = -D * (Vh - Wh), turning at the coordinated turn rate G * tan(Bank) / |Vh - Wh|.
+	// The airspeed decays as exp(-D * t), so the heading change is G * tan(Bank) * (exp(D * t) - 1) / (D * |Vh0 - Wh|)
+	const FVector RelativeVelocity(Velocity.X - AirVelocity.X, Velocity.Y - AirVelocity.Y, 0.f);
+	FVector NewRelativeVelocity = RelativeVelocity * FMath::Exp(-DragCoefficient * DeltaTime);
+
+	const float Airspeed = RelativeVelocity.Size();
+	if (BankAngle != 0.f && Airspeed > 1.f)
+	{
+		const float TurnTime = DragCoefficient > KINDA_SMALL_NUMBER ? (FMath::Exp(DragCoefficient * DeltaTime) - 1.f) / DragCoefficient : DeltaTime;
+		const float TurnAngle = FMath::Abs(GravityZ) * FMath::Tan(FMath::DegreesToRadians(BankAngle)) * TurnTime / Airspeed;
+		NewRelativeVelocity = NewRelativeVelocity.RotateAngleAxis(FMath::RadiansToDegrees(TurnAngle), FVector::UpVector);
+	}
+
+	NewVelocity.X = AirVelocity.X + NewRelativeVelocity.X;
+	NewVelocity.Y = AirVelocity.Y + NewRelativeVelocity.Y;
+
+	return NewVelocity;
+}
+
+float FGlideFlightModel::GetTargetBankAngle(float LateralAcceleration, float GravityZ) const
+{
+	if (FMath::IsNearlyZero(GravityZ))
+	{
+		return 0.f;
+	}
+
+	const float Bank = FMath::RadiansToDegrees(FMath::Atan2(LateralAcceleration, FMath::Abs(GravityZ)));
+	return FMath::Clamp(Bank, -MaxBankAngle, MaxBankAngle);
+}
+
+float FGlideFlightModel::GetSinkDragCoefficient(float GravityZ) const
+{
+	if (TerminalSinkRate <= 0.f)
+	{
+		return 0.f;
+	}
+
+	return FMath::Abs(GravityZ * (1.f - LiftCoefficient)) / TerminalSinkRate;
+}
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GlideFlightModel.generated.h"
+
+/**
+ * Glider flight model used while gliding.
+ * Lift cancels part of gravity, linear drag settles the vertical speed at the terminal sink rate
+ * and banking turns the flight path at the coordinated turn rate, at the cost of lift. Drag acts
+ * relative to the air, so wind and updrafts (AirVelocity) carry the glider.
+ * For a constant bank the model has a closed-form solution. The bank only changes on fixed steps of
+ * SubstepTime carried over between frames, so the flight path doesn't depend on the frame time.
+ */
+USTRUCT(BlueprintType)
+struct SECOND_API FGlideFlightModel
+{
+	GENERATED_BODY()
+
+public:
+	FGlideFlightModel();
+
+	/** Fraction of gravity cancelled by the glider when flying level (0 = free fall) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding")
+	float LiftCoefficient;
+
+	/** Horizontal drag (1/s) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding")
+	float DragCoefficient;
+
+	/** Sink speed the glider settles at when flying level (cm/s) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding")
+	float TerminalSinkRate;
+
+	/** Degrees */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding")
+	float MaxBankAngle;
+
+	/** Degrees per second */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding")
+	float BankRate;
+
+	/** Time between two bank steps (s) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding")
+	float SubstepTime;
+
+	/**
+	 * Advance Velocity and BankAngle by DeltaTime. BankStepTime is the time left until the next bank step,
+	 * kept by the caller between frames. Uses the closed form for the whole frame when there is no banking
+	 */
+	FVector Integrate(const FVector& Velocity, const FVector& AirVelocity, float& BankAngle, float& BankStepTime, float TargetBankAngle, float GravityZ, float DeltaTime) const;
+
+	/** Exact solution for a constant bank angle, turning included */
+	FVector IntegrateClosedForm(const FVector& Velocity, const FVector& AirVelocity, float BankAngle, float GravityZ, float DeltaTime) const;
+
+	/** Bank angle of a coordinated turn with the given lateral acceleration (positive = right) */
+	float GetTargetBankAngle(float LateralAcceleration, float GravityZ) const;
+
+	/** Vertical drag (1/s) that makes the level sink speed equal TerminalSinkRate */
+	float GetSinkDragCoefficient(float GravityZ) const;
+};
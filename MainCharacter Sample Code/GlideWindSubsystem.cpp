@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GlideWindSubsystem.h"
+#include "Engine/World.h"
+
+UGlideWindSubsystem::UGlideWindSubsystem()
+{
+	CellSize = 5000.f;
+	Version = 0;
+}
+
+int32 UGlideWindSubsystem::RegisterVolume(const FBox& Bounds, const FVector& AirVelocity)
+{
+	int32 VolumeIndex;
+	if (FreeVolumeIndices.Num() > 0)
+	{
+		VolumeIndex = FreeVolumeIndices.Pop();
+	}
+	else
+	{
+		VolumeIndex = Volumes.AddDefaulted();
+	}
+
+	FGlideWindVolumeData& Volume = Volumes[VolumeIndex];
+	Volume.Bounds = Bounds.ShiftBy(GetOriginOffset());
+	Volume.AirVelocity = AirVelocity;
+	Volume.bIsValid = true;
+
+	FIntPoint Min;
+	FIntPoint Max;
+	GetCellRange(Volume.Bounds, Min, Max);
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			Cells.FindOrAdd(FIntPoint(X, Y)).VolumeIndices.Add(VolumeIndex);
+		}
+	}
+
+	++Version;
+	return VolumeIndex;
+}
+
+void UGlideWindSubsystem::UnregisterVolume(int32 VolumeIndex)
+{
+	if (!Volumes.IsValidIndex(VolumeIndex) || !Volumes[VolumeIndex].bIsValid)
+	{
+		return;
+	}
+
+	FGlideWindVolumeData& Volume = Volumes[VolumeIndex];
+
+	FIntPoint Min;
+	FIntPoint Max;
+	GetCellRange(Volume.Bounds, Min, Max);
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			const FIntPoint CellCoord(X, Y);
+			if (FGlideWindCell* Cell = Cells.Find(CellCoord))
+			{
+				Cell->VolumeIndices.RemoveSwap(VolumeIndex);
+				if (Cell->VolumeIndices.Num() == 0)
+				{
+					Cells.Remove(CellCoord);
+				}
+			}
+		}
+	}
+
+	Volume.bIsValid = false;
+	FreeVolumeIndices.Add(VolumeIndex);
+	++Version;
+}
+
+FIntPoint UGlideWindSubsystem::GetCellCoord(const FVector& Location) const
+{
+	return GetAbsoluteCellCoord(Location + GetOriginOffset());
+}
+
+const FGlideWindCell* UGlideWindSubsystem::FindCell(const FIntPoint& CellCoord) const
+{
+	return Cells.Find(CellCoord);
+}
+
+FVector UGlideWindSubsystem::SampleAirVelocity(const FGlideWindCell* Cell, const FVector& Location) const
+{
+	FVector AirVelocity(0.f, 0.f, 0.f);
+	if (Cell == nullptr)
+	{
+		return AirVelocity;
+	}
+
+	const FVector AbsoluteLocation = Location + GetOriginOffset();
+	for (const int32 VolumeIndex : Cell->VolumeIndices)
+	{
+		const FGlideWindVolumeData& Volume = Volumes[VolumeIndex];
+		if (Volume.Bounds.IsInsideOrOn(AbsoluteLocation))
+		{
+			AirVelocity += Volume.AirVelocity;
+		}
+	}
+
+	return AirVelocity;
+}
+
+void UGlideWindSubsystem::GetCellRange(const FBox& Bounds, FIntPoint& OutMin, FIntPoint& OutMax) const
+{
+	OutMin = GetAbsoluteCellCoord(Bounds.Min);
+	OutMax = GetAbsoluteCellCoord(Bounds.Max);
+}
+
+FIntPoint UGlideWindSubsystem::GetAbsoluteCellCoord(const FVector& AbsoluteLocation) const
+{
+	return FIntPoint(FMath::FloorToInt(AbsoluteLocation.X / CellSize), FMath::FloorToInt(AbsoluteLocation.Y / CellSize));
+}
+
+FVector UGlideWindSubsystem::GetOriginOffset() const
+{
+	const UWorld* World = GetWorld();
+	return World != nullptr ? FVector(World->OriginLocation) : FVector(0.f, 0.f, 0.f);
+}
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GlideWindSubsystem.generated.h"
+
+/** Wind zone or thermal updraft registered by AGlideWindVolume */
+struct FGlideWindVolumeData
+{
+	FBox Bounds;
+	FVector AirVelocity;
+	bool bIsValid;
+};
+
+/** Volumes overlapping one grid cell footprint */
+struct FGlideWindCell
+{
+	TArray<int32> VolumeIndices;
+};
+
+/**
+ * Static sparse grid of wind volumes.
+ * Volumes are bucketed into XY cells once when registered, so a glider only has to hash its cell
+ * and test the few volumes in it. Gliders cache the cell while they stay inside it.
+ * The grid is kept in absolute coordinates (world origin added), so cells and cached cell coords stay
+ * valid when the world origin is rebased. The API takes world locations.
+ */
+UCLASS()
+class SECOND_API UGlideWindSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGlideWindSubsystem();
+
+	/** Returns the handle used to unregister the volume */
+	int32 RegisterVolume(const FBox& Bounds, const FVector& AirVelocity);
+	void UnregisterVolume(int32 VolumeIndex);
+
+	FIntPoint GetCellCoord(const FVector& Location) const;
+
+	/** nullptr when no volume overlaps the cell. Valid until GetVersion() changes */
+	const FGlideWindCell* FindCell(const FIntPoint& CellCoord) const;
+
+	/** Sum of the air velocity of every volume in Cell containing Location */
+	FVector SampleAirVelocity(const FGlideWindCell* Cell, const FVector& Location) const;
+
+	/** Changes whenever the grid is modified */
+	FORCEINLINE int32 GetVersion() const { return Version; }
+
+	/** Width of a grid cell (cm) */
+	float CellSize;
+
+private:
+	void GetCellRange(const FBox& Bounds, FIntPoint& OutMin, FIntPoint& OutMax) const;
+	FIntPoint GetAbsoluteCellCoord(const FVector& AbsoluteLocation) const;
+
+	/** World origin location, world to absolute coordinates */
+	FVector GetOriginOffset() const;
+
+	TArray<FGlideWindVolumeData> Volumes;
+	TArray<int32> FreeVolumeIndices;
+	TMap<FIntPoint, FGlideWindCell> Cells;
+	int32 Version;
+};
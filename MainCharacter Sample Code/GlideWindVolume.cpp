@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GlideWindVolume.h"
+#include "GlideWindSubsystem.h"
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+
+AGlideWindVolume::AGlideWindVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	WindBox = CreateDefaultSubobject<UBoxComponent>(TEXT("WindBox"));
+	WindBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	WindBox->SetMobility(EComponentMobility::Static);
+	SetRootComponent(WindBox);
+
+	WindVelocity = FVector(0.f, 0.f, 0.f);
+	UpdraftSpeed = 0.f;
+	RegisteredVolumeIndex = INDEX_NONE;
+}
+
+void AGlideWindVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UGlideWindSubsystem* WindSubsystem = GetWorld()->GetSubsystem<UGlideWindSubsystem>())
+	{
+		const FVector AirVelocity(WindVelocity.X, WindVelocity.Y, UpdraftSpeed);
+		RegisteredVolumeIndex = WindSubsystem->RegisterVolume(WindBox->Bounds.GetBox(), AirVelocity);
+	}
+}
+
+void AGlideWindVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGlideWindSubsystem* WindSubsystem = GetWorld()->GetSubsystem<UGlideWindSubsystem>())
+	{
+		WindSubsystem->UnregisterVolume(RegisteredVolumeIndex);
+	}
+	RegisteredVolumeIndex = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
+}
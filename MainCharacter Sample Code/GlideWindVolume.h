@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "GlideWindVolume.generated.h"
+
+/**
+ * Static wind zone / thermal updraft affecting gliders inside its box.
+ * Registered once in the world's UGlideWindSubsystem grid, no overlap events are used.
+ */
+UCLASS()
+class SECOND_API AGlideWindVolume : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AGlideWindVolume();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Glide Wind")
+	class UBoxComponent* WindBox;
+
+	/** Horizontal wind (cm/s) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Glide Wind")
+	FVector WindVelocity;
+
+	/** Upward air speed of a thermal (cm/s) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Glide Wind")
+	float UpdraftSpeed;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	int32 RegisteredVolumeIndex;
+};
@@ -13,9 +13,24 @@
 #include "Math/Rotator.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Components/SceneComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "MainMovementComponent.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "ClimbingComponent.h"
+#include "StaminaComponent.h"
+#include "MainMovementSnapshot.h"
+#include "ClimbAnimInstance.h"
+
+DECLARE_STATS_GROUP(TEXT("Main"), STATGROUP_Main, STATCAT_Advanced);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Input To Montage Latency (ms)"), STAT_MainInputToMontageLatency, STATGROUP_Main);
+DECLARE_CYCLE_STAT(TEXT("Rollback Resimulate"), STAT_MainRollbackResimulate, STATGROUP_Main);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rollback Frames"), STAT_MainRollbackFrames, STATGROUP_Main);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rollback Probe Misses"), STAT_MainRollbackProbeMisses, STATGROUP_Main);
 
 // Sets default values
-AMain::AMain()
+AMain::AMain(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UMainMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
  	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
@@ -49,95 +64,34 @@ AMain::AMain()
 	bUseControllerRotationRoll = false;
 
 	// Configure character movement
+	MainMovementComponent = Cast<UMainMovementComponent>(GetCharacterMovement());
 	GetCharacterMovement()->bOrientRotationToMovement = true; // Character moves in the direction of input...
 	GetCharacterMovement()->RotationRate = FRotator(0.0f, 720.f, 0.0f);  // ...at this rotation rate
 	GetCharacterMovement()->JumpZVelocity = 400.f;
 	GetCharacterMovement()->AirControl = 0.0f;
 
-	/* Status */
-	MovementStatus = EMovementStatus::EMS_Normal;
-	StaminaStatus = EStaminaStatus::ESS_Normal;
-	ClimbStatus = EClimbStatus::ECS_NormalClimb;
-
-	/* Normal & Climbing */
-	bIsRightEdge = false;
-	bIsLeftEdge = false;
-	bIsFoothold = false;
-	bIsBottomEdge = false;
-	bIsTopEdge = false;
-	bIsGround = false;
-
-	/* for Start Climb */
-	bIsCanGrabWall = false;
-	ClimbStartTerm = 0.15f;
-	InitClimbStartTerm = 0.15f;
-
-	/* Climbing */
-	bIsBodyWallFacing = false;
-	NormalVectorBodyWallFacing = FVector(0.0f, 0.0f, 0.0f);
-	bTooFarFromWall = false;
-
-	/* Climbing::Turn Corner */
-	bIsTurnCornerRightEdge = false;
-	bIsTurnCornerLeftEdge = false;
-	bCanRightTurnInsideCorner = false;
-	bCanLeftTurnInsideCorner = false;
-
-	/* Climbing::Dash Jump*/
-	bIsLeftDashing = false;
-	bIsRightDashing = false;
-	ClimbDashInclination = 0.0f;
-
-
-	/* Climb Up*/
-	bClimbUpEnoughSpace = false;
-	bClimbUpTraceGround = false;
-
-	/* Climb Down*/
-	NormalVectorGrabWallFromTop = FVector(0.0f, 0.0f, 0.0f);
-	bCanGrabWallFromTop = false;
-
-	/* Front Flip */
-	bIsLowerRightEdge = false;
-	bIsLowerLeftEdge = false;
-
-	/* Jumping */
-	bIsJumping = false;
-
-	/* Gliding */
-	GlidingCoolTime = 0.3f;
-	InitGlidingCoolTime = 0.3f;
-
 	// Glider Mesh
 	GliderMeshComponent = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("GliderMeshComponent"));
 	GliderMeshComponent->SetupAttachment(GetRootComponent());
 
+	/* Climbing & Stamina */
+	// Ticked from AMain::Tick so input, probes, buffered actions and stamina keep one fixed order
+	ClimbingComponent = CreateDefaultSubobject<UClimbingComponent>(TEXT("ClimbingComponent"));
+	ClimbingComponent->PrimaryComponentTick.bStartWithTickEnabled = false;
+	ClimbingComponent->GliderMeshComponent = GliderMeshComponent;
 
-	/* for Stamina Status */
-	bIsStaminaConsumSprinting = false;
-	InitSprintJumpStaminaConsumDuration = 1.0f;
-	SprintJumpStaminaConsumDuration = 1.0f;
-
-	/* for current Stamina */
-	SprintStaminaConsumption = 20.f;
-	ClimbingStaminaConsumption = 5.f;
-	GlidingStaminaConsumption = 5.f;
-	FrontFlipStaminaConsumption = 10.f;
-	ClimbDashStaminaConsumption = 15.f;
-	WallJumpStaminaConsumption = 20.f;
-
-	MaxStamina = 150.f;
-	CurrentStamina = 150.f;
-
-	InitStaminaRecoverTerm = 0.5f;
-	StaminaRecoverTerm = 0.5f;
+	StaminaComponent = CreateDefaultSubobject<UStaminaComponent>(TEXT("StaminaComponent"));
+	StaminaComponent->PrimaryComponentTick.bStartWithTickEnabled = false;
 
 
 	/* only for Stamina Bar */
 	StaminaConsumption = 0.0f;
 	FadedStamina = 0.0f;
 	FadedStaminaDiminishTerm = 0.3f;
+	InitFadedStaminaDiminishTerm = 0.3f;
+	FadedStaminaDiminishRate = 0.5f;
 	bIsStaminaFilledFull = false;
+	StaminaBarQuantization = 256;
 
 	/* Input */
 	MoveForwardInputValue = 0.0f;
@@ -153,11 +107,35 @@ AMain::AMain()
 	bIsAKeyDown = false;
 	bIsSKeyDown = false;
 	bIsDKeyDown = false;
-	
 
-	/* Debug */
-	AngleDegree = 0.f;
-	bDrawDebugLine = false;
+	/* Input Record & Replay */
+	bIsInputRecordReplayInitialized = false;
+	bIsRecordingInput = false;
+	bIsReplayingInput = false;
+	InputFrameIndex = 0;
+	ReplayInputEventIndex = 0;
+	for (int32 AxisIndex = 0; AxisIndex < MainInputAxisCount; ++AxisIndex)
+	{
+		InputAxisValues[AxisIndex] = 0.f;
+	}
+
+	/* Input Action Buffer */
+	ActionInputBufferHead = 0;
+	ActionInputBufferNum = 0;
+	SpaceBarBufferTime = 0.15f;
+	FKeyBufferTime = 0.1f;
+
+	/* Rollback */
+	bRollbackEnabled = false;
+	MaxRollbackFrames = 8;
+	RollbackFrameHead = 0;
+	RollbackFrameNum = 0;
+	RollbackOpenedFrameCounter = MAX_uint64;
+	for (int32 AxisIndex = 0; AxisIndex < MainInputAxisCount; ++AxisIndex)
+	{
+		RollbackAxisValues[AxisIndex] = 0.f;
+	}
+	bIsResimulating = false;
 }
 
 // Called when the game starts or when spawned
@@ -165,441 +143,136 @@ void AMain::BeginPlay()
 {
 	Super::BeginPlay();
 	GliderMeshComponent->SetVisibility(false);
-}
-
-// Called every frame
-void AMain::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-	
-	// Managing MovementStatus Transition
-	MovementStatusManager(DeltaTime);
-
-	// Managing StaminaStatus Transition
-	StaminaStatusManager(DeltaTime);
-
-	// Managing Current Stamina
-	CurrentStaminaManager(DeltaTime);
-
-	// Managing Variable that related to Stamina Bar only
-	StaminaBarManager(DeltaTime);
-
-}
-
-void AMain::MovementStatusManager(float DeltaTime)
-{
-	if (GetMovementStatus() == EMovementStatus::EMS_Climbing)
-	{
-		if (GetClimbStatus() == EClimbStatus::ECS_NormalClimb && GetMesh()->GetAnimInstance()->Montage_IsPlaying(NULL))
-		{
-			StopAnimMontage();
-		}
-
-		if (GetStaminaStatus() == EStaminaStatus::ESS_Exhausted && GetClimbStatus() == EClimbStatus::ECS_NormalClimb)
-		{
-			bCanGrabWallFromTop = false;
-			StopClimb();
-		}
-		else
-		{
-			if (ClimbMaintainCondition())
-			{
-				if (!(GetClimbStatus() == EClimbStatus::ECS_TurnCorner))
-				{
-					if (ClimbUpCondition())
-					{
-						// Start Climb Up
-						ClimbUp();
-					}
-					else if(TurnCornerCondition())
-					{
-						// Start Turn Corner
-						TurnCorner();
-					}
-				}
-			}
-			else
-			{
-				StopClimb();
-			}
 
-			AttachCharacterToWall();
-		}
-
-
-		if (GlidingCoolTime > 0)
-		{
-			GlidingCoolTime -= DeltaTime;
-		}
+	StaminaComponent->OnStaminaConsumed.AddUObject(this, &AMain::OnStaminaConsumed);
+	ClimbingComponent->OnClimbStarted.AddUObject(this, &AMain::OnClimbStarted);
 
-		if (bIsJumping)
-		{
-			bIsJumping = false;
-		}
-	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_HaltClimbing)
-	{
-		if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Walking)
-		{
-			SetMovementStatus(EMovementStatus::EMS_Normal);
-		}
-	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_ClimbUp)
+	// The climbing poses only update off the game thread with the native anim instance as the anim blueprint's parent
+	UClass* AnimClass = GetMesh()->AnimClass;
+	if (AnimClass != nullptr && !AnimClass->IsChildOf(UClimbAnimInstance::StaticClass()))
 	{
-		AttachCharacterToGround();
+		UE_LOG(LogTemp, Warning, TEXT("%s anim blueprint %s isn't based on UClimbAnimInstance, its climbing update runs on the game thread"), *GetName(), *AnimClass->GetName());
 	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_WallJumping)
-	{
-		if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Walking)
-		{
-			StopAnimMontage();
-			SetMovementStatus(EMovementStatus::EMS_Normal);
-			bIsCanGrabWall = false;
-		}
-		else
-		{
-			if (StartClimbWhileWallJumpCondition())
-			{
-				StartClimb();
-			}
 
-		}
-	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_Gliding)
-	{
-		if (GetStaminaStatus() != EStaminaStatus::ESS_Exhausted)
-		{
-			if (EnoughSpaceForGliding())
-			{
-				GlidingVelocityManger();
+	// Also without an input component : dedicated server, -nullrhi automation, AI possession
+	InitInputRecordReplay();
 
-				if (StartClimbWhileGlidingCondition(DeltaTime))
-				{
-					StopGliding();
-					StartClimb();
-				}
-			}
-			else
-			{
-				StopGliding();
-			}
-		}
-		else
-		{
-			StopGliding();
-		}
-	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_ClimbDown)
+	if (bRollbackEnabled)
 	{
-		const FVector Direction = -GetActorUpVector();
-		FVector Position = GetActorLocation();
-		Position.Z = Position.Z - 0.1f;
-		SetActorLocation(Position);
-
-		if (bIsCanGrabWall)
-		{
-			if (ClimbStartEnoughSpaceCondition())
-			{
-				StartClimb();
-				bIsCanGrabWall = false;
-			}
-		}
+		RollbackFrames.SetNum(FMath::Max(MaxRollbackFrames, 1));
 	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_FrontFlip)
-	{
+}
 
-	}
-	else
+void AMain::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bIsRecordingInput)
 	{
-		if (GetStaminaStatus() == EStaminaStatus::ESS_Exhausted)
-		{
-			GetCharacterMovement()->MaxWalkSpeed = 100.f;
-		}
-		else
-		{
-			if (GetMovementStatus() == EMovementStatus::EMS_Sprinting)
-			{
-				GetCharacterMovement()->MaxWalkSpeed = 1000.f;
-			}
-			else
-			{
-				GetCharacterMovement()->MaxWalkSpeed = 500.f;
-			}
-
-			if (StartClimbAtNormalStatusCondition(DeltaTime))
-			{
-				StartClimb();
-			}
-
-
-			SetCanGrabWallFromTopAndNormalVector();
-
-		}
-
-		if (GlidingCoolTime > 0)
-		{
-			GlidingCoolTime -= DeltaTime;
-		}
+		// Golden values to check replays against
+		InputRecording.NumFrames = InputFrameIndex;
+		InputRecording.FinalMovementStatus = (uint8)GetMovementStatus();
+		InputRecording.FinalCurrentStamina = StaminaComponent->CurrentStamina;
 
-		if (bIsJumping)
+		if (!InputRecording.SaveToFile(InputRecordFilePath))
 		{
-			if (!GetCharacterMovement()->IsFalling())
-			{
-				bIsJumping = false;
-			}
+			UE_LOG(LogTemp, Error, TEXT("Failed to save input recording %s"), *InputRecordFilePath);
 		}
+		bIsRecordingInput = false;
 	}
 
+	Super::EndPlay(EndPlayReason);
 }
 
-void AMain::StaminaStatusManager(float DeltaTime)
+void AMain::PossessedBy(AController* NewController)
 {
-	// Managing Stamina Status by referring to Movement and Stamina Status
-
-	if ((CurrentStamina <= 0.0f) &&
-		(GetClimbStatus() == EClimbStatus::ECS_NormalClimb) &&
-		(GetMovementStatus() != EMovementStatus::EMS_ClimbUp) &&
-		(GetMovementStatus() != EMovementStatus::EMS_WallJumping) &&
-		(GetMovementStatus() != EMovementStatus::EMS_FrontFlip))
-	{
-		CurrentStamina = 0.0f;
-		StaminaConsumption = 0.0f;
+	Super::PossessedBy(NewController);
 
-		SetStaminaStatus(EStaminaStatus::ESS_Exhausted);
-	}
-	else if (GetStaminaStatus() == EStaminaStatus::ESS_Exhausted)
+	// Record & replay started in BeginPlay before there was a controller, the camera starts with them
+	if (InputFrameIndex == 0 && NewController != nullptr)
 	{
-		if (CurrentStamina == MaxStamina)
+		if (bIsReplayingInput)
 		{
-			SetStaminaStatus(EStaminaStatus::ESS_Normal);
+			NewController->SetControlRotation(InputRecording.StartControlRotation);
 		}
-	}
-	else if (
-		bIsStaminaConsumSprinting && (GetStaminaStatus() != EStaminaStatus::ESS_Exhausted) 
-		&& GetMovementStatus() != EMovementStatus::EMS_FrontFlip)
-	{
-		SetStaminaStatus(EStaminaStatus::ESS_Sprinting);
-
-	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_Climbing)
-	{
-		SetStaminaStatus(EStaminaStatus::ESS_Climbing);
-	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_Gliding)
-	{
-		SetStaminaStatus(EStaminaStatus::ESS_Gliding);
-	}
-	else if (!this->GetMovementComponent()->IsFalling() && GetMovementStatus() == EMovementStatus::EMS_Normal)
-	{
-		SetStaminaStatus(EStaminaStatus::ESS_Normal);
-	}
-	else if (
-		(this->GetMovementComponent()->IsFalling() && GetMovementStatus() == EMovementStatus::EMS_Normal) ||
-		(GetMovementStatus() == EMovementStatus::EMS_ClimbUp) ||
-		(GetMovementStatus() == EMovementStatus::EMS_HaltClimbing) ||
-		(GetMovementStatus() == EMovementStatus::EMS_WallJumping) ||
-		(GetMovementStatus() == EMovementStatus::EMS_ClimbDown) ||
-		(GetMovementStatus() == EMovementStatus::EMS_FrontFlip)
-		)
-	{
-		SetStaminaStatus(EStaminaStatus::ESS_Pause);
-		if (GetMovementStatus() == EMovementStatus::EMS_FrontFlip)
+		else if (bIsRecordingInput)
 		{
-			bIsStaminaFilledFull = false;
+			InputRecording.StartControlRotation = NewController->GetControlRotation();
 		}
 	}
+}
 
+void AMain::ApplyWorldOffset(const FVector& InOffset, bool bWorldShift)
+{
+	Super::ApplyWorldOffset(InOffset, bWorldShift);
 
-	if (GetStaminaStatus() == EStaminaStatus::ESS_Sprinting && GetCharacterMovement()->Velocity.Size() > 300.f)
+	if (ClimbingComponent != nullptr)
 	{
-		if (this->GetMovementComponent()->IsFalling() && bIsJumping && !(GetMovementStatus() == EMovementStatus::EMS_Gliding))
-		{
-			SprintJumpStaminaConsumDuration -= DeltaTime;
-			if (SprintJumpStaminaConsumDuration <= 0.f)
-			{
-				bIsStaminaConsumSprinting = false;
-				SprintJumpStaminaConsumDuration = InitSprintJumpStaminaConsumDuration;
-			}
-		}
-		else if (this->GetMovementComponent()->IsFalling() && !bIsJumping)
-		{
-			SprintJumpStaminaConsumDuration = 0.f;
-			bIsStaminaConsumSprinting = false;
-
-		}
-		else
-		{
-			bIsJumping = false;
-			SprintJumpStaminaConsumDuration = InitSprintJumpStaminaConsumDuration;
-		}
+		ClimbingComponent->ApplyWorldOffset(InOffset, bWorldShift);
 	}
-
 }
 
-void AMain::CurrentStaminaManager(float DeltaTime)
+// Called every frame
+void AMain::Tick(float DeltaTime)
 {
-	// Managing Current Stamina by referring to Movement and Stamina Status
-	if (GetStaminaStatus() == EStaminaStatus::ESS_Sprinting && GetCharacterMovement()->Velocity.Size() > 300.f)
-	{
-		CurrentStamina -= DeltaTime * SprintStaminaConsumption;
-		StaminaRecoverTerm = InitStaminaRecoverTerm;
-	}
-	else if (GetStaminaStatus() == EStaminaStatus::ESS_Climbing)
-	{
-		StaminaRecoverTerm = InitStaminaRecoverTerm;
+	Super::Tick(DeltaTime);
 
-		if (MoveForwardInputValue != 0.f || MoveRightInputValue != 0.f || (GetClimbStatus() == EClimbStatus::ECS_TurnCorner))
-		{
-			if (!(MoveRightInputValue > 0 && MoveForwardInputValue == 0 && bIsRightEdge)
-				&& !(MoveRightInputValue < 0 && MoveForwardInputValue == 0 && bIsLeftEdge)
-				&& !(MoveForwardInputValue > 0 && MoveRightInputValue == 0 && bIsTopEdge)
-				&& !(MoveForwardInputValue < 0 && MoveRightInputValue == 0 && bIsBottomEdge))
-			{
-				if (GetClimbStatus() != EClimbStatus::ECS_DashJump)
-				{
-					CurrentStamina -= DeltaTime * ClimbingStaminaConsumption;
-				}
-				else
-				{
-
-				}
-			}
-			else if (GetClimbStatus() == EClimbStatus::ECS_TurnCorner)
-			{
-				CurrentStamina -= DeltaTime * ClimbingStaminaConsumption;
-			}
-			else
-			{
-	
-			}
+	// Frames without any input handler call open their rollback frame here
+	OpenRollbackFrame();
 
-		}
-	}
-	else if (GetStaminaStatus() == EStaminaStatus::ESS_Gliding)
+	// Feeding recorded input before anything reads it
+	if (bIsReplayingInput)
 	{
-		StaminaRecoverTerm = InitStaminaRecoverTerm;
-		CurrentStamina -= DeltaTime * GlidingStaminaConsumption;
+		DispatchReplayInput();
 	}
-	else if (GetStaminaStatus() == EStaminaStatus::ESS_Pause)
-	{
-		StaminaRecoverTerm = InitStaminaRecoverTerm;
 
-	}
-	else if (GetStaminaStatus() == EStaminaStatus::ESS_Normal)
+	// This frame's climbing probes are kept with its rollback frame
+	FMainRollbackFrame* RollbackFrame = RollbackFrameNum > 0 ? &GetRollbackFrame(RollbackFrameNum - 1) : nullptr;
+	if (RollbackFrame != nullptr)
 	{
-
-		StaminaRecoverTerm -= DeltaTime;
-		if (CurrentStamina < MaxStamina && StaminaRecoverTerm <= 0.f)
-		{
-			StaminaRecoverTerm = 0.f;
-			CurrentStamina += DeltaTime * 40;
-			if (CurrentStamina >= MaxStamina)
-			{
-				CurrentStamina = MaxStamina;
-			}
-		}
+		RollbackFrame->DeltaTime = DeltaTime;
+		ClimbingComponent->BeginClimbProbeFrame(&RollbackFrame->Probes, nullptr);
 	}
-	else if (GetStaminaStatus() == EStaminaStatus::ESS_Exhausted && GetCharacterMovement()->MovementMode != EMovementMode::MOVE_Falling)
-	{
 
-		StaminaRecoverTerm -= DeltaTime;
-		if (CurrentStamina < MaxStamina && StaminaRecoverTerm <= 0.f)
-		{
-			StaminaRecoverTerm = 0.f;
-			CurrentStamina += DeltaTime * 40;
-			if (CurrentStamina >= MaxStamina)
-			{
-				CurrentStamina = MaxStamina;
-			}
-		}
-	}
-	else
+	SimulateMovementFrame(DeltaTime);
+
+	if (RollbackFrame != nullptr)
 	{
+		ClimbingComponent->EndClimbProbeFrame();
+	}
 
+	++InputFrameIndex;
+	if (bIsReplayingInput && InputFrameIndex >= InputRecording.NumFrames)
+	{
+		FinishInputReplay();
 	}
 }
 
-void AMain::StaminaBarManager(float DeltaTime)
+void AMain::SimulateMovementFrame(float DeltaTime)
 {
-	// Managing stamina bar variable by referring to Movement and Stamina Status
+	// Managing MovementStatus Transition
+	ClimbingComponent->MovementManager(DeltaTime);
 
-	// Managing StaminaConsumption
-	if (GetStaminaStatus() == EStaminaStatus::ESS_Sprinting && GetCharacterMovement()->Velocity.Size() > 300.f)
-	{
-		StaminaConsumption = SprintStaminaConsumption / MaxStamina * 0.5f;
+	// Action inputs of this frame, decided with the probes MovementStatusManager just ran
+	ProcessActionInputs(DeltaTime);
 
-		if (StaminaConsumption > (CurrentStamina / MaxStamina))
-		{
-			StaminaConsumption = (CurrentStamina / MaxStamina);
-		}
-	}
-	else if (GetStaminaStatus() == EStaminaStatus::ESS_Climbing)
-	{
-		if (MoveForwardInputValue != 0.f || MoveRightInputValue != 0.f || (GetClimbStatus() == EClimbStatus::ECS_TurnCorner))
-		{
-			if (!(MoveRightInputValue > 0 && MoveForwardInputValue == 0 && bIsRightEdge)
-				&& !(MoveRightInputValue < 0 && MoveForwardInputValue == 0 && bIsLeftEdge)
-				&& !(MoveForwardInputValue > 0 && MoveRightInputValue == 0 && bIsTopEdge)
-				&& !(MoveForwardInputValue < 0 && MoveRightInputValue == 0 && bIsBottomEdge))
-			{
-				if (GetClimbStatus() != EClimbStatus::ECS_DashJump)
-				{
-					StaminaConsumption = ClimbingStaminaConsumption / MaxStamina * 0.5f;
-					if (StaminaConsumption > (CurrentStamina / MaxStamina))
-					{
-						StaminaConsumption = (CurrentStamina / MaxStamina);
-					}
-				}
-				else
-				{
-					StaminaConsumption = 0.f;
-				}
-			}
-			else if (GetClimbStatus() == EClimbStatus::ECS_TurnCorner)
-			{
-				StaminaConsumption = ClimbingStaminaConsumption / MaxStamina * 0.5f;
-				if (StaminaConsumption > (CurrentStamina / MaxStamina))
-				{
-					StaminaConsumption = (CurrentStamina / MaxStamina);
-				}
-			}
-			else
-			{
-				StaminaConsumption = 0.f;
-			}
+	// Managing StaminaStatus Transition and the drain rate
+	ClimbingComponent->StaminaManager(DeltaTime);
 
-		}
+	// Managing Current Stamina
+	StaminaComponent->CurrentStaminaManager(DeltaTime);
 
-		if (MoveForwardInputValue == 0.f && MoveRightInputValue == 0.f && !(GetClimbStatus() == EClimbStatus::ECS_TurnCorner))
-		{
-			StaminaConsumption = 0.f;
-		}
+	// Managing Variable that related to Stamina Bar only
+	StaminaBarManager(DeltaTime);
+}
 
+void AMain::StaminaBarManager(float DeltaTime)
+{
+	// Managing stamina bar variable by referring to Movement and Stamina Status
 
-	}
-	else if (GetStaminaStatus() == EStaminaStatus::ESS_Gliding)
-	{
-		StaminaConsumption = GlidingStaminaConsumption / MaxStamina * 0.5f;
-		if (StaminaConsumption > (CurrentStamina / MaxStamina))
-		{
-			StaminaConsumption = (CurrentStamina / MaxStamina);
-		}
-	}
-	else if (GetStaminaStatus() == EStaminaStatus::ESS_Pause)
-	{
-		StaminaConsumption = 0.f;
-	}
-	else if (GetStaminaStatus() == EStaminaStatus::ESS_Normal)
-	{
-		StaminaConsumption = 0.f;
-	}
-	else if (GetStaminaStatus() == EStaminaStatus::ESS_Exhausted && GetCharacterMovement()->MovementMode != EMovementMode::MOVE_Falling)
+	// Managing StaminaConsumption, the part of the bar the current movement drains
+	StaminaConsumption = StaminaComponent->StaminaDrainRate / StaminaComponent->MaxStamina * 0.5f;
+	if (StaminaConsumption > (StaminaComponent->CurrentStamina / StaminaComponent->MaxStamina))
 	{
-		StaminaConsumption = 0.f;
-	}
-	else
-	{
-		StaminaConsumption = 0.f;
+		StaminaConsumption = (StaminaComponent->CurrentStamina / StaminaComponent->MaxStamina);
 	}
 
 	// Managing Faded Stamina
@@ -607,7 +280,7 @@ void AMain::StaminaBarManager(float DeltaTime)
 	{
 		if (FadedStaminaDiminishTerm <= 0.f)
 		{
-			FadedStamina -= DeltaTime / 2.f;
+			FadedStamina -= DeltaTime * FadedStaminaDiminishRate;
 		}
 		else
 		{
@@ -618,11 +291,11 @@ void AMain::StaminaBarManager(float DeltaTime)
 	else
 	{
 		FadedStamina = 0.f;
-		FadedStaminaDiminishTerm = 0.3f;
+		FadedStaminaDiminishTerm = InitFadedStaminaDiminishTerm;
 	}
 
 	// Stamina Full Charge Check
-	if (CurrentStamina >= MaxStamina)
+	if (StaminaComponent->IsStaminaFilledFull())
 	{
 		bIsStaminaFilledFull = true;
 	}
@@ -630,6 +303,47 @@ void AMain::StaminaBarManager(float DeltaTime)
 	{
 		bIsStaminaFilledFull = false;
 	}
+
+	// Push to the stamina bar widget only when a quantized value changed.
+	// The faded segment keeps its start value, the material diminishes it from FadedStaminaStartTime
+	FStaminaBarState NewState = StaminaBarState;
+	NewState.CurrentStamina = QuantizeStaminaBarValue(StaminaComponent->CurrentStamina / StaminaComponent->MaxStamina);
+	NewState.StaminaConsumption = QuantizeStaminaBarValue(StaminaConsumption);
+	NewState.bIsStaminaFilledFull = bIsStaminaFilledFull;
+
+	if (NewState != StaminaBarState)
+	{
+		BroadcastStaminaBarState(NewState);
+	}
+}
+
+void AMain::SetFadedStamina(float Value)
+{
+	FadedStamina = Value;
+	FadedStaminaDiminishTerm = InitFadedStaminaDiminishTerm;
+
+	FStaminaBarState NewState = StaminaBarState;
+	NewState.FadedStamina = QuantizeStaminaBarValue(FadedStamina);
+	NewState.FadedStaminaStartTime = GetWorld()->GetTimeSeconds();
+	BroadcastStaminaBarState(NewState);
+}
+
+void AMain::OnStaminaConsumed(float Amount)
+{
+	SetFadedStamina(Amount / StaminaComponent->MaxStamina);
+}
+
+int32 AMain::QuantizeStaminaBarValue(float Ratio) const
+{
+	const int32 Quantization = FMath::Max(StaminaBarQuantization, 1);
+	return FMath::Clamp(FMath::RoundToInt(Ratio * Quantization), 0, Quantization);
+}
+
+void AMain::BroadcastStaminaBarState(const FStaminaBarState& NewState)
+{
+	StaminaBarState = NewState;
+	OnStaminaBarChanged.Broadcast(StaminaBarState);
+	OnStaminaBarChangedDynamic.Broadcast(StaminaBarState);
 }
 
 // Called to bind functionality to input
@@ -639,6 +353,13 @@ void AMain::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 	
 	check(PlayerInputComponent);
 
+	// Replayed input is fed from Tick, don't mix it with the real input. Input can be set up before BeginPlay
+	InitInputRecordReplay();
+	if (bIsReplayingInput)
+	{
+		return;
+	}
+
 	PlayerInputComponent->BindAxis("MoveForward", this, &AMain::MoveForward);
 	PlayerInputComponent->BindAxis("MoveRight", this, &AMain::MoveRight);
 
@@ -658,1684 +379,668 @@ void AMain::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 	PlayerInputComponent->BindAction("F_Keyboard", IE_Released, this, &AMain::FKeyReleased);
 }
 
-void AMain::Jump()
-{
-	Super::Jump();
-	bIsJumping = true;
-}
-
 void AMain::MoveForward(float Value)
 {
-	if (Value < 0.1f && Value > -0.1f)
-	{
-		Value = 0.f;
-	}
-
-	MoveForwardInputValue = Value;
-	if (GetMovementStatus() == EMovementStatus::EMS_Sprinting)
-	{
-		SetMovementStatus(EMovementStatus::EMS_Normal);
-	}
-
-	if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Flying)
-	{
-		
-		if (GetMovementStatus() == EMovementStatus::EMS_Climbing)
-		{
-			bIsStaminaConsumSprinting = false;
-			if (bIsQKeyDown)
-			{
-				if (Value != 0)
-				{
-					MoveForwardInputValue = 0.0f;
-				}
-				Value = 0.0f;
-				
-			}
-
-			if (bIsTopEdge)
-			{
-				if (Value > 0)
-				{
-					Value = 0;
-					MoveForwardInputValue = 0.0f;
-				}
-
-			}
-
-			if (bIsBottomEdge)
-			{
-				if (Value < 0)
-				{
-					Value = 0;
-				}
-			}
+	RecordInput(EMainInputType::MoveForward, Value);
 
-			const FVector Direction = GetActorUpVector();
-			AddMovementInput(Direction, Value);
-		}
-		else
-		{
-
-		}
-		
-	}
-	else
-	{
-		if (!this->GetMovementComponent()->IsFalling())
-		{
-
-			if (!(GetMovementStatus() == EMovementStatus::EMS_Sprinting))
-			{
-				bIsStaminaConsumSprinting = false;
-			}
-
-			if ((Controller != nullptr) && (Value != 0.0f))
-			{
-				// find out which way is forward
-				if (bIsLeftShiftKeyDown && !(GetStaminaStatus() == EStaminaStatus::ESS_Exhausted))
-				{
-					if (Value >= 0.3f)
-					{
-						Value = 1.f;
-						SetMovementStatus(EMovementStatus::EMS_Sprinting);
-						bIsStaminaConsumSprinting = true;
-					}
-					else if (Value <= -0.3f)
-					{
-						Value = -1.f;
-						SetMovementStatus(EMovementStatus::EMS_Sprinting);
-						bIsStaminaConsumSprinting = true;
-					}
-					else if (MoveRightInputValue <= 0.3f && MoveRightInputValue >= -0.3f)
-					{
-						Value = 0;
-						SetMovementStatus(EMovementStatus::EMS_Normal);
-						bIsStaminaConsumSprinting = false;
-					}
-				}
-
-				const FRotator Rotation = Controller->GetControlRotation();
-				const FRotator YawRoatation(0.f, Rotation.Yaw, 0.f);
-
-				const FVector Direction = FRotationMatrix(YawRoatation).GetUnitAxis(EAxis::X);
-				AddMovementInput(Direction, Value);
-			}
-		}
-		else
-		{
-			if (GetMovementStatus() == EMovementStatus::EMS_Gliding)
-			{
-				const FRotator Rotation = Controller->GetControlRotation();
-				const FRotator YawRoatation(0.f, Rotation.Yaw, 0.f);
-
-				const FVector Direction = FRotationMatrix(YawRoatation).GetUnitAxis(EAxis::X);
-				AddMovementInput(Direction, Value);
-			}
-		}
-		
-	}
-}
-
-
-void AMain::MoveRight(float Value)
-{
 	if (Value < 0.1f && Value > -0.1f)
 	{
-		Value = 0.f;
-	}
-	
-
-	MoveRightInputValue = Value;
-	if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Flying)
-	{
-		if (GetMovementStatus() == EMovementStatus::EMS_Climbing)
-		{
-			bIsStaminaConsumSprinting = false;
-			if (bIsQKeyDown)
-			{
-				Value = 0.0f;
-				MoveRightInputValue = 0.0f;
-			}
-
-			if (bIsRightEdge)
-			{
-				if (Value > 0.0f)
-				{
-					Value = 0.0f;
-				}
-			}
-
-			if (bIsLeftEdge)
-			{
-				if (Value < 0.0f)
-				{
-					Value = 0.0f;
-				}
-			}
-
-			const FVector Direction = GetActorRightVector();
-			AddMovementInput(Direction, Value);
-		}
-	}
-	else
-	{
-		if (!this->GetMovementComponent()->IsFalling())
-		{
-			if (!(GetMovementStatus() == EMovementStatus::EMS_Sprinting))
-			{
-				bIsStaminaConsumSprinting = false;
-			}
-
-			if ((Controller != nullptr) && (Value != 0.0f))
-			{
-				
-				if (bIsLeftShiftKeyDown && !(GetStaminaStatus() == EStaminaStatus::ESS_Exhausted))
-				{
-					if (Value >= 0.3f)
-					{
-						Value = 1.f;
-						SetMovementStatus(EMovementStatus::EMS_Sprinting);
-						bIsStaminaConsumSprinting = true;
-					}
-					else if (Value <= -0.3f)
-					{
-						Value = -1.f;
-						SetMovementStatus(EMovementStatus::EMS_Sprinting);
-						bIsStaminaConsumSprinting = true;
-					}
-					else if (MoveForwardInputValue <= 0.3f && MoveForwardInputValue >= -0.3f)
-					{
-						Value = 0;
-						SetMovementStatus(EMovementStatus::EMS_Normal);
-						bIsStaminaConsumSprinting = false;
-					}
-				}
-
-				// find out which way is forward
-				const FRotator Rotation = Controller->GetControlRotation();
-				const FRotator YawRoatation(0.f, Rotation.Yaw, 0.f);
-
-				const FVector Direction = FRotationMatrix(YawRoatation).GetUnitAxis(EAxis::Y);
-				AddMovementInput(Direction, Value);
-			}
-		}
-		else
-		{
-			if (GetMovementStatus() == EMovementStatus::EMS_Gliding)
-			{
-				const FRotator Rotation = Controller->GetControlRotation();
-				const FRotator YawRoatation(0.f, Rotation.Yaw, 0.f);
-
-				const FVector Direction = FRotationMatrix(YawRoatation).GetUnitAxis(EAxis::Y);
-				AddMovementInput(Direction, Value);
-			}
-		}
-	}
-
-	
-}
-
-void AMain::TurnAtRate(float Rate)
-{
-	if (Rate < 0.1f && Rate > -0.1f)
-	{
-		Rate = 0.f;
-	}
-
-	TurnValue = Rate;
-
-	AddControllerYawInput(Rate * BaseTurnRate * GetWorld()->GetDeltaSeconds());
-}
-
-void AMain::LookUpAtRate(float Rate)
-{
-	if (Rate < 0.1f && Rate > -0.1f)
-	{
-		Rate = 0.f;
-	}
-
-	LookUpValue = Rate;
-
-	AddControllerPitchInput(Rate * BaseLookUpRate * GetWorld()->GetDeltaSeconds());
-}
-
-void AMain::SpaceBarPressed()
-{
-	bIsSpacebarDown = true;
-	if (ClimbDashJumpCondition())
-	{
-		ClimbDashJump();
-	}
-	else if (WallJumpCondition())
-	{
-		WallJump();
-	}
-	else if (GlidingCondition() && GetMovementStatus() != EMovementStatus::EMS_Gliding && CurrentStamina > 0)
-	{
-		if (GlidingCoolTime <= 0)
-		{
-			StartGliding();
-		}
-	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_Gliding)
-	{
-		StopGliding();
-	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_ClimbUp)
-	{
-
-	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_ClimbDown)
-	{
-
-	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_FrontFlip)
-	{
-
-	}
-	else if (GetMovementStatus() == EMovementStatus::EMS_Climbing && GetClimbStatus() != EClimbStatus::ECS_NormalClimb)
-	{
-
-	}
-	else 
-	{
-		if (FrontFlipCondition())
-		{
-			FrontFlip();
-		}
-		else
-		{
-			Jump();
-		}
-	}
-}
-
-void AMain::SpaceBarReleased()
-{
-	bIsSpacebarDown = false;
-	StopJumping();
-}
-
-void AMain::LeftShiftPressed()
-{
-	bIsLeftShiftKeyDown = true;
-	if (GetMovementStatus() == EMovementStatus::EMS_Climbing && !(GetClimbStatus() == EClimbStatus::ECS_DashJump) && !(GetClimbStatus() == EClimbStatus::ECS_TurnCorner))
-	{
-		GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Falling);
-		GetCharacterMovement()->bOrientRotationToMovement = true;
-		SetMovementStatus(EMovementStatus::EMS_HaltClimbing);
-	}
-}
-
-void AMain::LeftShiftReleased()
-{
-	bIsLeftShiftKeyDown = false;
-}
-
-void AMain::QKeyPressed()
-{
-	bIsQKeyDown = true;
-}
-
-void AMain::QKeyReleased()
-{
-	bIsQKeyDown = false;
-}
-
-void AMain::FKeyPressed()
-{
-	bIsFKeyDown = true;
-	if (GrabWallFromTopCondition())
-	{
-		GrabWallFromTop();
-	}
-}
-
-void AMain::FKeyReleased()
-{
-	bIsFKeyDown = false;
-}
-
-
-
-
-EMovementStatus AMain::GetMovementStatus()
-{
-	return MovementStatus;
-}
-
-
-void AMain::SetMovementStatus(EMovementStatus Status)
-{
-	MovementStatus = Status;
-}
-
-EClimbStatus AMain::GetClimbStatus()
-{
-	return ClimbStatus;
-}
-
-EStaminaStatus AMain::GetStaminaStatus()
-{
-	return StaminaStatus;
-}
-
-
-void AMain::SetStaminaStatus(EStaminaStatus Status)
-{
-	StaminaStatus = Status;
-}
-
-
-
-void AMain::SetClimbStatus(EClimbStatus Status)
-{
-	ClimbStatus = Status;
-}
-
-bool AMain::EnoughSpaceForGliding()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	bool Enough = true;
-
-	FVector Start = GetActorLocation() - GetActorUpVector() * 100.f;
-	FVector End = Start;
-	FQuat Rot{};
-	FHitResult OutHit{};
-	FCollisionShape Shape;
-	Shape.SetSphere(40.0f);
-	
-	Enough = !GetWorld()->SweepSingleByChannel(OutHit, Start, End, Rot, ECollisionChannel::ECC_Visibility, Shape, CollisionParams);
-	return Enough;
-}
-
-void AMain::SetIsRightLeftEdgeAtNormal()
-{
-
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	FHitResult OutHit{};
-	FVector RightStart = GetActorLocation() + FVector(0.f, 0.f, 60.f) + GetActorRightVector() * 50.f;
-	FVector RightEnd = RightStart + GetActorForwardVector() * 100.f;
-	
-	bIsRightEdge = !GetWorld()->LineTraceSingleByChannel(OutHit, RightStart, RightEnd, ECollisionChannel::ECC_Visibility, CollisionParams);
-	
-	FVector LeftStart = GetActorLocation() + FVector(0.f, 0.f, 60.f) - GetActorRightVector() * 50.f;
-	FVector LeftEnd = LeftStart + GetActorForwardVector() * 100.f;
-
-	bIsLeftEdge = !GetWorld()->LineTraceSingleByChannel(OutHit, LeftStart, LeftEnd, ECollisionChannel::ECC_Visibility, CollisionParams);
-}
-
-void AMain::SetIsLowerRightLeftEdgeAtGround()
-{
-
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	FHitResult OutHit{};
-	FVector RightStart = GetActorLocation() + FVector(0.f, 0.f, -30.f) + GetActorRightVector() * 50.f;
-	FVector RightEnd = RightStart + GetActorForwardVector() * 60.f;
-
-	bIsLowerRightEdge = !GetWorld()->LineTraceSingleByChannel(OutHit, RightStart, RightEnd, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	FVector LeftStart = GetActorLocation() + FVector(0.f, 0.f, -30.f) - GetActorRightVector() * 50.f;
-	FVector LeftEnd = LeftStart + GetActorForwardVector() * 60.f;
-
-	bIsLowerLeftEdge = !GetWorld()->LineTraceSingleByChannel(OutHit, LeftStart, LeftEnd, ECollisionChannel::ECC_Visibility, CollisionParams);
-}
-
-void AMain::SetIsFoothold()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation() + FVector(0.f, 0.f, -80.f);
-	FVector End = Start + GetActorForwardVector() * 70.f;
-
-	bIsFoothold = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-}
-
-void AMain::SetIsTopEdge()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation() + FVector(0.f, 0.f, 90.f);
-	FVector End = Start + GetActorForwardVector() * 70.f;
-
-	bIsTopEdge = !GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-}
-
-
-void AMain::SetCanGrabWallFromTopAndNormalVector()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	bool bDeepEnoughSpace = false;
-	bool bCloserGroundCheck = false;
-	
-	bool bSpaceCheckRight = false;
-	bool bSpaceCheckLeft = false;
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation() + GetActorForwardVector() * 42.f;
-	FVector End = Start + GetActorUpVector() * (-276.f);
-
-
-
-	bDeepEnoughSpace = !GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	Start = GetActorLocation() + GetActorForwardVector() * 15.f;
-	End = Start + GetActorUpVector() * (-100.f);
-	bCloserGroundCheck = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-
-	Start = GetActorLocation() + GetActorForwardVector() * 42.f + GetActorUpVector() * (-184.f) + GetActorRightVector() * 42.f;
-	End = Start + GetActorForwardVector() * (-35.f);
-	bSpaceCheckRight = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	Start = GetActorLocation() + GetActorForwardVector() * 42.f + GetActorUpVector() * (-184.f) + GetActorRightVector() * (-42.f);
-	End = Start + GetActorForwardVector() * (-35.f);
-	bSpaceCheckLeft = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	Start = GetActorLocation() + GetActorForwardVector() * 42.f + GetActorUpVector() * (-184.f);
-	End = Start + GetActorForwardVector() * (-35.f);
-	GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	if (bDeepEnoughSpace && bCloserGroundCheck && bSpaceCheckRight && bSpaceCheckLeft)
-	{
-		bCanGrabWallFromTop = true;
-		NormalVectorGrabWallFromTop = OutHit.Normal;
-	}
-	else
-	{
-		bCanGrabWallFromTop = false;
-	}
-
-}
-
-
-void AMain::SetTooFarFromWall()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation();
-	FVector End = Start + GetActorForwardVector() * 45.f;
-
-	bTooFarFromWall = !GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-}
-
-void AMain::SetClimbUpTraceGround()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation();
-	FVector End = Start + GetActorUpVector() * (-130.f);
-
-	bClimbUpTraceGround = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-}
-
-void AMain::SetIsGround()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation();
-	FVector End = Start + GetActorUpVector() * (-100.f);
-
-	bIsGround = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-}
-
-void AMain::SetIsBottomEdge()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation() + FVector(0.f, 0.f, -80.f);
-	FVector End = Start + GetActorForwardVector() * 80.f;
-
-	bIsBottomEdge = !GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-}
-
-void AMain::SetCanRightTurnInsideCorner()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	bool Condition_1 = false;
-	bool Condition_2 = false;
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation() + GetActorForwardVector() * 40.f;
-	FVector End = Start + GetActorRightVector() * 45.f;
-
-	Condition_1 = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	Start = GetActorLocation() + GetActorForwardVector() * (-40.f);
-	End = Start + GetActorRightVector() * 45.f;
-
-	Condition_2 = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	if (Condition_1 && Condition_2)
-	{
-		bCanRightTurnInsideCorner = true;
-	}
-	else
-	{
-		bCanRightTurnInsideCorner = false;
-	}
-
-}
-
-void AMain::SetCanLeftTurnInsideCorner()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	bool Condition_1 = false;
-	bool Condition_2 = false;
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation() + GetActorForwardVector() * 40.f;
-	FVector End = Start + GetActorRightVector() * (-45.f);
-
-	Condition_1 = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	Start = GetActorLocation() + GetActorForwardVector() * (-40.f);
-	End = Start + GetActorRightVector() * (-45.f);
-
-	Condition_2 = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	if (Condition_1 && Condition_2)
-	{
-		bCanLeftTurnInsideCorner = true;
-	}
-	else
-	{
-		bCanLeftTurnInsideCorner = false;
-	}
-
-}
-
-void AMain::SetIsRightLeftEdgeAtClimbing()
-{
-
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	FHitResult OutHit{};
-	FVector RightStart = GetActorLocation() + GetActorRightVector() * 50.f;
-	FVector RightEnd = RightStart + GetActorForwardVector() * 60.f;
-
-	bIsRightEdge = !GetWorld()->LineTraceSingleByChannel(OutHit, RightStart, RightEnd, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	FVector LeftStart = GetActorLocation() + GetActorRightVector() * (-50.f);
-	FVector LeftEnd = LeftStart + GetActorForwardVector() * 60.f;
-
-	bIsLeftEdge = !GetWorld()->LineTraceSingleByChannel(OutHit, LeftStart, LeftEnd, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-}
-
-
-void AMain::SetCanRightTurnOutsideCorner()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	bool Condition_1 = false;
-	bool Condition_2 = false;
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation() + GetActorRightVector() * 84.f + GetActorForwardVector() * 50.f;
-	FVector End = Start + GetActorRightVector() * (-70.f);
-
-	Condition_1 = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	Start = GetActorLocation() + GetActorRightVector() * 84.f + GetActorForwardVector() * 126.f;
-	End = Start + GetActorRightVector() * (-70.f);
-
-	Condition_2 = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	if (Condition_1 && Condition_2)
-	{
-		bCanRightTurnOutsideCorner = true;
-	}
-	else
-	{
-		bCanRightTurnOutsideCorner = false;
-	}
-
-}
-
-void AMain::SetCanLeftTurnOutsideCorner()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	bool Condition_1 = false;
-	bool Condition_2 = false;
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation() + GetActorRightVector() * (-84.f) + GetActorForwardVector() * 50.f;
-	FVector End = Start + GetActorRightVector() * (70.f);
-
-	Condition_1 = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	Start = GetActorLocation() + GetActorRightVector() * (-84.f) + GetActorForwardVector() * 126.f;
-	End = Start + GetActorRightVector() * (70.f);
-
-	Condition_2 = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	if (Condition_1 && Condition_2)
-	{
-		bCanLeftTurnOutsideCorner = true;
-	}
-	else
-	{
-		bCanLeftTurnOutsideCorner = false;
-	}
-
-}
-
-void AMain::SetClimbUpEnoughSpace()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	bool Condition_1 = false;
-	bool Condition_2 = false;
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation() + FVector(0.f, 0.f, 96.f);
-	FVector End = Start + GetActorForwardVector() * 70.f;
-
-	Condition_1 = !GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	Start = GetActorLocation() + FVector(0.f, 0.f, 300.f);
-	End = Start + GetActorForwardVector() * 70.f;
-	Condition_2 = !GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	if (Condition_1 && Condition_2)
-	{
-		bClimbUpEnoughSpace = true;
-	}
-	else
-	{
-		bClimbUpEnoughSpace = false;
-	}
-}
-
-void AMain::SetIsBodyWallFacingAndNormalVector()
-{
-	const FName TraceTag("MyTraceTag");
-	GetWorld()->DebugDrawTraceTag = TraceTag;
-	FCollisionQueryParams CollisionParams;
-	if (bDrawDebugLine)
-	{
-		CollisionParams.TraceTag = TraceTag;
-	}
-
-	bool bDeepEnoughSpace = false;
-	bool bCloserGroundCheck = false;
-
-	bool bSpaceCheckRight = false;
-	bool bSpaceCheckLeft = false;
-
-	FHitResult OutHit{};
-	FVector Start = GetActorLocation();
-	FVector End = Start + GetActorForwardVector() * (70.f);
-
-	bIsBodyWallFacing = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECollisionChannel::ECC_Visibility, CollisionParams);
-
-	if (bIsBodyWallFacing)
-	{
-		NormalVectorBodyWallFacing = OutHit.Normal;
-	}
-}
-
-
-
-void AMain::StopClimb()
-{
-	GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Falling);
-	SetMovementStatus(EMovementStatus::EMS_Normal);
-	GetCharacterMovement()->bOrientRotationToMovement = true;
-}
-
-
-void AMain::StartClimb()
-{
-	StopAnimMontage();
-	FRotator MovementRotation = NormalVectorBodyWallFacing.Rotation();
-	MovementRotation.Yaw = MovementRotation.Yaw + 180.f;
-	SetActorRotation(MovementRotation);
-	ClimbStartTerm = InitClimbStartTerm;
-	SetMovementStatus(EMovementStatus::EMS_Climbing);
-	bIsCanGrabWall = false;
-	GetCharacterMovement()->Velocity = FVector(0.f, 0.f, 0.f);
-	GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Flying);
-	GetCharacterMovement()->bOrientRotationToMovement = false;
-	bIsJumping = false;
-}
-
-bool AMain::StartClimbAtNormalStatusCondition(float DeltaTime)
-{
-	if (ClimbStartEnoughSpaceConditionForGround())
-	{
-		if (ClimbStartInputDirectionCondition())
-		{
-			ClimbStartTerm -= DeltaTime;
-			//UE_LOG(LogTemp, Warning, TEXT("I'm in air~"));
-		}
-		else
-		{
-			ClimbStartTerm = InitClimbStartTerm;
-		}
-
-		if (ClimbStartTerm <= 0.0)
-		{
-			return true;
-		}
-
-	}
-	return false;
-}
-
-bool AMain::StartClimbWhileGlidingCondition(float DeltaTime)
-{
-	if (ClimbStartEnoughSpaceCondition())
-	{
-		if (ClimbStartInputDirectionCondition())
-		{
-			ClimbStartTerm -= DeltaTime;
-			//UE_LOG(LogTemp, Warning, TEXT("I'm in air~"));
-		}
-		else
-		{
-			ClimbStartTerm = InitClimbStartTerm;
-		}
-
-		if (ClimbStartTerm <= 0.f)
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
-
-bool AMain::ClimbStartInputDirectionCondition()
-{
-	GetActorLocation();
-	FVector Vec = FVector(MoveForwardInputValue, MoveRightInputValue, 0.f);
-
-	Vec = UKismetMathLibrary::GetDirectionUnitVector(FVector(0.f, 0.f, 0.f), Vec);
-	FRotator Rot = FRotator(0.f, Controller->GetControlRotation().Yaw, 0.f);
-	FVector ControlDirection = Rot.RotateVector(Vec);
-
-	FVector ForwardVec = GetActorForwardVector();
-	float DotProd = UKismetMathLibrary::Dot_VectorVector(ControlDirection, ForwardVec);
-	float degree1 = UKismetMathLibrary::DegAcos(DotProd);
-	AngleDegree = degree1;
-	DotProd = UKismetMathLibrary::Dot_VectorVector(-NormalVectorBodyWallFacing, ForwardVec);
-	float degree2 = UKismetMathLibrary::DegAcos(DotProd);
-	AngleDegree = degree2;
-	if (degree1 <= 45.f && degree2 <= 30.f)
-	{
-		return true;
-	}
-
-	return false;
-}
-
-bool AMain::ClimbMaintainCondition()
-{
-	SetIsBodyWallFacingAndNormalVector();
-	SetIsGround();
-
-	if ((bIsBodyWallFacing || !(GetClimbStatus() == EClimbStatus::ECS_NormalClimb)) && !((bIsGround) && (MoveForwardInputValue < 0.0)))
-	{
-		return true;
-	}
-
-	return false;
-}
-
-bool AMain::ClimbUpCondition()
-{
-	SetIsBottomEdge();
-	SetIsLowerRightLeftEdgeAtGround();
-	SetIsTopEdge();
-	SetClimbUpEnoughSpace();
-
-	if ( 
-		( bIsTopEdge && bClimbUpEnoughSpace && !(GetClimbStatus() == EClimbStatus::ECS_DashJump)  || ((GetClimbStatus() == EClimbStatus::ECS_DashJump) && !bIsBottomEdge)) &&
-		(!bIsRightEdge || !bIsLeftEdge) && 
-		bIsTopEdge && 
-		bClimbUpEnoughSpace 
-		)
-	{
-		return true;
-	}
-	return false;
-}
-
-bool AMain::FrontFlipCondition()
-{
-	SetIsRightLeftEdgeAtNormal();
-	SetIsLowerRightLeftEdgeAtGround();
-	SetIsFoothold();
-	SetIsTopEdge();
-	SetIsBodyWallFacingAndNormalVector();
-	SetCanGrabWallFromTopAndNormalVector();
-
-	if ( bIsRightEdge && bIsLeftEdge & !bIsLowerLeftEdge && !bIsLowerRightEdge && bIsFoothold && bIsTopEdge && !GetCharacterMovement()->IsFalling())
-	{
-		return true;
-	}
-	return false;
-}
-
-
-
-bool AMain::TurnCornerInsideRightCondition()
-{
-	if (bCanRightTurnInsideCorner && ( ( MoveRightInputValue > 0.0f )  || (GetClimbStatus() == EClimbStatus::ECS_DashJump && bIsRightDashing) ) )
-	{
-		return true;
-	}
-
-	return false;
-}
-
-bool AMain::TurnCornerInsideLeftCondition()
-{
-	if (bCanLeftTurnInsideCorner && ((MoveRightInputValue < 0.0f) || (GetClimbStatus() == EClimbStatus::ECS_DashJump && bIsLeftDashing)))
-	{
-		return true;
-	}
-
-	return false;
-}
-
-bool AMain::TurnCornerOutsideRightCondition()
-{
-	if (bCanRightTurnOutsideCorner && bIsRightEdge && ((MoveRightInputValue > 0.0f) || (GetClimbStatus() == EClimbStatus::ECS_DashJump && bIsRightDashing)))
-	{
-		return true;
-	}
-
-	return false;
-}
-
-bool AMain::TurnCornerOutsideLeftCondition()
-{
-	if (bCanLeftTurnOutsideCorner && bIsLeftEdge && ((MoveRightInputValue < 0.0f) || (GetClimbStatus() == EClimbStatus::ECS_DashJump && bIsLeftDashing)))
-	{
-		return true;
-	}
-
-	
-
-	return false;
-}
-
-bool AMain::TurnCornerCondition()
-{
-	// Can do Turn Corner Check
-	TurnCornerVariableRenewal();
-
-	if (TurnCornerInsideRightCondition())
-	{
-		return true;
-	}
-	else if (TurnCornerInsideLeftCondition())
-	{
-		return true;
-	}
-	else if (TurnCornerOutsideRightCondition())
-	{
-		return true;
-	}
-	else if (TurnCornerOutsideLeftCondition())
-	{
-		return true;
-	}
-
-	return false;
-}
-
-void AMain::TurnCorner()
-{
-	if (TurnCornerInsideRightCondition())
-	{
-		TurnCornerInsideRight();
-	}
-	else if (TurnCornerInsideLeftCondition())
-	{
-		TurnCornerInsideLeft();
-	}
-	else if (TurnCornerOutsideRightCondition())
-	{
-		TurnCornerOutsideRight();
-	}
-	else if (TurnCornerOutsideLeftCondition())
-	{
-		TurnCornerOutsideLeft();
+		Value = 0.f;
 	}
-}
 
+	MoveForwardInputValue = Value;
+	UpdateDesiredMoveDirection();
+	AddCameraRelativeMovementInput(EAxis::X, Value, MoveRightInputValue);
+}
 
-void AMain::StartGliding()
+void AMain::MoveRight(float Value)
 {
-	SetMovementStatus(EMovementStatus::EMS_Gliding);
-
-	// Gliding start macro
-	GetCharacterMovement()->GravityScale = 0.2f;
-	GetCharacterMovement()->AirControl = 1.0f;
-	FVector CurrentVelocity = GetCharacterMovement()->Velocity;
-	GetCharacterMovement()->Velocity = FVector(CurrentVelocity.X, CurrentVelocity.Y, 0.f);
-
-	LaunchCharacter(FVector(0.0f, 0.0f, 150.f), false, false);
-
-	GetCharacterMovement()->RotationRate = FRotator(0.0f, 120.f, 0.0f);
-	GetCharacterMovement()->bOrientRotationToMovement = true;
-	GetCharacterMovement()->BrakingDecelerationFalling = 500.f;
-	GetCharacterMovement()->MaxWalkSpeed = 750.f;
+	RecordInput(EMainInputType::MoveRight, Value);
 
-	// Play anim montage part
-	if (StartGlidingAnimMontage)
+	if (Value < 0.1f && Value > -0.1f)
 	{
-		FTimerHandle WaitHandle;
-		float WaitTime = PlayAnimMontage(StartGlidingAnimMontage);
-		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-			{
-
-
-			}), WaitTime, false); //ݺ ⼭ ߰   
+		Value = 0.f;
 	}
 
-	bIsJumping = false;
-	GliderMeshComponent->SetVisibility(true);
-
+	MoveRightInputValue = Value;
+	UpdateDesiredMoveDirection();
+	AddCameraRelativeMovementInput(EAxis::Y, Value, MoveForwardInputValue);
 }
 
-void AMain::StopGliding()
+void AMain::UpdateDesiredMoveDirection()
 {
-	bIsJumping = false;
-	StopAnimMontage();
-	GetCharacterMovement()->GravityScale = 1.0f;
-	GetCharacterMovement()->AirControl = 0.0f;
-	GetCharacterMovement()->RotationRate = FRotator(0.f, 720.f, 0.f);
-	SetMovementStatus(EMovementStatus::EMS_Normal);
-	GetCharacterMovement()->BrakingDecelerationFalling = 0.f;
-	GetCharacterMovement()->MaxWalkSpeed = 500.f;
-
-	GlidingCoolTime = InitGlidingCoolTime;
-	
-	GliderMeshComponent->SetVisibility(false);
+	// Climbing moves along the wall from this, the component decides the sprint and climbing movement
+	const float ReferenceYaw = Controller ? Controller->GetControlRotation().Yaw : GetActorRotation().Yaw;
+	ClimbingComponent->SetDesiredMoveDirection(FVector2D(MoveForwardInputValue, MoveRightInputValue), ReferenceYaw);
 }
 
-void AMain::ClimbDashJump()
+void AMain::AddCameraRelativeMovementInput(EAxis::Type Axis, float Value, float OtherAxisValue)
 {
-	ClimbDashJumpStaminaManage();
-
-	if (!(MoveForwardInputValue == 0.f || MoveRightInputValue == 0.f))
+	if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Flying || Controller == nullptr || Value == 0.0f)
 	{
-		ClimbDashInclination = MoveForwardInputValue / MoveRightInputValue;
+		return;
 	}
 
-	if (ClimbDashCondition_U())
+	if (GetMovementComponent()->IsFalling() && ClimbingComponent->GetMovementStatus() != EMovementStatus::EMS_Gliding)
 	{
-		if (ClimbingDash_U_AnimMontage)
-		{
-			FTimerHandle WaitHandle;
-			float WaitTime = PlayAnimMontage(ClimbingDash_U_AnimMontage);
-			GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-				{
-
-
-				}), WaitTime, false); //ݺ ⼭ ߰   
-		}
-
-		bIsRightDashing = false;
-		bIsLeftDashing = false;
+		return;
 	}
-	else if (ClimbDashCondition_D())
-	{
-		if (ClimbingDash_D_AnimMontage)
-		{
-			FTimerHandle WaitHandle;
-			float WaitTime = PlayAnimMontage(ClimbingDash_D_AnimMontage);
-			GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-				{
-
 
-				}), WaitTime, false); //ݺ ⼭ ߰   
-		}
-
-		bIsRightDashing = false;
-		bIsLeftDashing = false;
-	}
-	else if (ClimbDashCondition_R())
+	// Sprinting runs at full speed along the dominant axis
+	if (!GetMovementComponent()->IsFalling() && bIsLeftShiftKeyDown && !StaminaComponent->IsExhausted())
 	{
-		if (ClimbingDash_R_AnimMontage)
+		if (Value >= 0.3f)
 		{
-			FTimerHandle WaitHandle;
-			float WaitTime = PlayAnimMontage(ClimbingDash_R_AnimMontage);
-			GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-				{
-
-
-				}), WaitTime, false); //ݺ ⼭ ߰   
+			Value = 1.f;
 		}
-
-		bIsRightDashing = true;
-	}
-	else if (ClimbDashCondition_L())
-	{
-		if (ClimbingDash_L_AnimMontage)
+		else if (Value <= -0.3f)
 		{
-			FTimerHandle WaitHandle;
-			float WaitTime = PlayAnimMontage(ClimbingDash_L_AnimMontage);
-			GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-				{
-
-
-				}), WaitTime, false); //ݺ ⼭ ߰   
+			Value = -1.f;
 		}
-
-		bIsLeftDashing = true;
-	}
-	else if (ClimbDashCondition_UR())
-	{
-		if (ClimbingDash_UR_AnimMontage)
+		else if (OtherAxisValue <= 0.3f && OtherAxisValue >= -0.3f)
 		{
-			FTimerHandle WaitHandle;
-			float WaitTime = PlayAnimMontage(ClimbingDash_UR_AnimMontage);
-			GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-				{
-
-
-				}), WaitTime, false); //ݺ ⼭ ߰   
+			Value = 0;
 		}
-
-		bIsRightDashing = true;
 	}
-	else if (ClimbDashCondition_DR())
-	{
-		if (ClimbingDash_DR_AnimMontage)
-		{
-			FTimerHandle WaitHandle;
-			float WaitTime = PlayAnimMontage(ClimbingDash_DR_AnimMontage);
-			GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-				{
-
-
-				}), WaitTime, false); //ݺ ⼭ ߰   
-		}
 
-		bIsRightDashing = true;
-	}
-	else if (ClimbDashCondition_UL())
-	{
-		if (ClimbingDash_UL_AnimMontage)
-		{
-			FTimerHandle WaitHandle;
-			float WaitTime = PlayAnimMontage(ClimbingDash_UL_AnimMontage);
-			GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-				{
+	const FRotator Rotation = Controller->GetControlRotation();
+	const FRotator YawRoatation(0.f, Rotation.Yaw, 0.f);
 
+	const FVector Direction = FRotationMatrix(YawRoatation).GetUnitAxis(Axis);
+	AddMovementInput(Direction, Value);
+}
 
-				}), WaitTime, false); //ݺ ⼭ ߰   
-		}
+void AMain::TurnAtRate(float Rate)
+{
+	RecordInput(EMainInputType::TurnAtRate, Rate);
 
-		bIsLeftDashing = true;
-	}
-	else if (ClimbDashCondition_DL())
+	if (Rate < 0.1f && Rate > -0.1f)
 	{
-		if (ClimbingDash_DL_AnimMontage)
-		{
-			FTimerHandle WaitHandle;
-			float WaitTime = PlayAnimMontage(ClimbingDash_DL_AnimMontage);
-			GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-				{
-
-
-				}), WaitTime, false); //ݺ ⼭ ߰   
-		}
-
-		bIsLeftDashing = true;
+		Rate = 0.f;
 	}
-	SetClimbStatus(EClimbStatus::ECS_DashJump);
 
+	TurnValue = Rate;
+
+	AddControllerYawInput(Rate * BaseTurnRate * GetWorld()->GetDeltaSeconds());
 }
 
-bool AMain::ClimbDashJumpCondition()
+void AMain::LookUpAtRate(float Rate)
 {
-	if (GetMovementStatus() == EMovementStatus::EMS_Climbing && (GetClimbStatus() == EClimbStatus::ECS_NormalClimb) && !bIsQKeyDown && !(TurnCornerOutsideLeftCondition() && MoveRightInputValue < 0) && !(TurnCornerOutsideRightCondition() && MoveRightInputValue > 0))
+	RecordInput(EMainInputType::LookUpAtRate, Rate);
+
+	if (Rate < 0.1f && Rate > -0.1f)
 	{
-		return true;
+		Rate = 0.f;
 	}
 
-	return false;
+	LookUpValue = Rate;
+
+	AddControllerPitchInput(Rate * BaseLookUpRate * GetWorld()->GetDeltaSeconds());
 }
 
-void AMain::ClimbDashJumpStaminaManage()
+void AMain::SpaceBarPressed()
 {
-	if (CurrentStamina > ClimbDashStaminaConsumption)
-	{
-		FadedStamina = ClimbDashStaminaConsumption / MaxStamina;
-		CurrentStamina -= ClimbDashStaminaConsumption;
-	}
-	else
-	{
-		FadedStamina = CurrentStamina / MaxStamina;
-		CurrentStamina = 0.f;
-	}
-	
-	
+	RecordInput(EMainInputType::SpaceBarPressed, 0.f);
+	bIsSpacebarDown = true;
+	BufferActionInput(EMainInputType::SpaceBarPressed);
 }
 
+void AMain::SpaceBarReleased()
+{
+	RecordInput(EMainInputType::SpaceBarReleased, 0.f);
+	bIsSpacebarDown = false;
+	BufferActionInput(EMainInputType::SpaceBarReleased);
+}
 
-bool AMain::ClimbDashCondition_U()
+void AMain::LeftShiftPressed()
 {
-	if ((MoveRightInputValue == 0.0f && MoveForwardInputValue == 0.0f) || 
-		(MoveForwardInputValue > 0.0f && MoveRightInputValue == 0.0f) ||
-		(MoveForwardInputValue > 0.0f && ClimbDashInclination >= 2.414f) ||
-		(MoveForwardInputValue > 0.0f && ClimbDashInclination < -2.414f) )
-	{
-		return true;
-	}
+	RecordInput(EMainInputType::LeftShiftPressed, 0.f);
+	bIsLeftShiftKeyDown = true;
+	ClimbingComponent->SetWantsToSprint(true);
+	ClimbingComponent->ReleaseWall();
+}
 
-	return false;
+void AMain::LeftShiftReleased()
+{
+	RecordInput(EMainInputType::LeftShiftReleased, 0.f);
+	bIsLeftShiftKeyDown = false;
+	ClimbingComponent->SetWantsToSprint(false);
 }
 
-bool AMain::ClimbDashCondition_D()
+void AMain::QKeyPressed()
 {
-	if ((MoveForwardInputValue < 0.f && MoveRightInputValue == 0.f) ||
-		(MoveForwardInputValue < 0.f && ClimbDashInclination >= 2.414f) ||
-		(MoveForwardInputValue < 0.f && ClimbDashInclination < -2.414f))
-	{
-		return true;
-	}
+	RecordInput(EMainInputType::QKeyPressed, 0.f);
+	bIsQKeyDown = true;
+	ClimbingComponent->SetBracing(true);
+}
 
-	return false;
+void AMain::QKeyReleased()
+{
+	RecordInput(EMainInputType::QKeyReleased, 0.f);
+	bIsQKeyDown = false;
+	ClimbingComponent->SetBracing(false);
 }
 
-bool AMain::ClimbDashCondition_R()
+void AMain::FKeyPressed()
 {
-	if ((MoveForwardInputValue == 0.f && MoveRightInputValue > 0.f) ||
-		(MoveRightInputValue > 0.f && ClimbDashInclination < 0.414f  && ClimbDashInclination > 0.f) ||
-		(MoveRightInputValue > 0.f && ClimbDashInclination < 0.f && ClimbDashInclination >= -0.414f))
-	{
-		return true;
-	}
+	RecordInput(EMainInputType::FKeyPressed, 0.f);
+	bIsFKeyDown = true;
+	BufferActionInput(EMainInputType::FKeyPressed);
+}
 
-	return false;
+void AMain::FKeyReleased()
+{
+	RecordInput(EMainInputType::FKeyReleased, 0.f);
+	bIsFKeyDown = false;
 }
 
-bool AMain::ClimbDashCondition_L()
+void AMain::BufferActionInput(EMainInputType Type)
 {
-	if ((MoveForwardInputValue == 0.f && MoveRightInputValue < 0.f) ||
-		(MoveRightInputValue < 0.f && ClimbDashInclination < 0.414f && ClimbDashInclination > 0.f) ||
-		(MoveRightInputValue < 0.f && ClimbDashInclination < 0.f && ClimbDashInclination >= -0.414f))
+	const double Timestamp = FPlatformTime::Seconds();
+	const float PressTime = ClimbingComponent->GetClimbTime();
+
+	// Spamming the key refreshes the pending press instead of queueing another one
+	for (int32 Offset = 0; Offset < ActionInputBufferNum; ++Offset)
 	{
-		return true;
+		FMainActionInput& Buffered = ActionInputBuffer[(ActionInputBufferHead + Offset) % MainActionInputBufferSize];
+		if (!Buffered.bIsConsumed && Buffered.Type == Type && Type != EMainInputType::SpaceBarReleased)
+		{
+			Buffered.Timestamp = Timestamp;
+			Buffered.PressTime = PressTime;
+			return;
+		}
 	}
 
-	return false;
-}
-
-bool AMain::ClimbDashCondition_UR()
-{
-	if (MoveForwardInputValue > 0.f && ClimbDashInclination >= 0.414f && ClimbDashInclination < 2.414f)
+	// Full : drop the oldest
+	if (ActionInputBufferNum == MainActionInputBufferSize)
 	{
-		return true;
+		ActionInputBufferHead = (ActionInputBufferHead + 1) % MainActionInputBufferSize;
+		--ActionInputBufferNum;
 	}
 
-	return false;
+	FMainActionInput& ActionInput = ActionInputBuffer[(ActionInputBufferHead + ActionInputBufferNum) % MainActionInputBufferSize];
+	ActionInput.Type = Type;
+	ActionInput.Timestamp = Timestamp;
+	ActionInput.PressTime = PressTime;
+	ActionInput.bIsConsumed = false;
+	++ActionInputBufferNum;
 }
 
-bool AMain::ClimbDashCondition_DR()
+void AMain::OnClimbStarted()
 {
-	if (MoveForwardInputValue < 0.f && ClimbDashInclination < -0.414f && ClimbDashInclination >= -2.414f)
+	// A jump or grab pressed just before the wall grab was for the ground or the glide, not a climb dash or a release.
+	// Releases still go through
+	for (int32 Offset = 0; Offset < ActionInputBufferNum; ++Offset)
 	{
-		return true;
+		FMainActionInput& Buffered = ActionInputBuffer[(ActionInputBufferHead + Offset) % MainActionInputBufferSize];
+		if (Buffered.Type == EMainInputType::SpaceBarPressed || Buffered.Type == EMainInputType::FKeyPressed)
+		{
+			Buffered.bIsConsumed = true;
+		}
 	}
-
-	return false;
 }
 
-bool AMain::ClimbDashCondition_UL()
+float AMain::GetActionInputBufferTime(EMainInputType Type) const
 {
-	if (MoveForwardInputValue > 0.f && ClimbDashInclination < -0.414f && ClimbDashInclination >= -2.414f)
+	switch (Type)
 	{
-		return true;
+	case EMainInputType::SpaceBarPressed:
+		return SpaceBarBufferTime;
+	case EMainInputType::FKeyPressed:
+		return FKeyBufferTime;
+	default:
+		return 0.f;
 	}
-
-	return false;
 }
 
-bool AMain::ClimbDashCondition_DL()
+void AMain::ProcessActionInputs(float DeltaTime)
 {
-	if (MoveForwardInputValue < 0.f && ClimbDashInclination >= 0.414f && ClimbDashInclination < 2.414f)
-	{
-		return true;
-	}
+	// Presses were buffered before MovementManager advanced the climb clock by this frame
+	const float FrameStartTime = ClimbingComponent->GetClimbTime() - DeltaTime;
+	bool bEvaluatedSpaceBar = false;
+	bool bEvaluatedFKey = false;
 
-	return false;
-}
+	for (int32 Offset = 0; Offset < ActionInputBufferNum; ++Offset)
+	{
+		FMainActionInput& ActionInput = ActionInputBuffer[(ActionInputBufferHead + Offset) % MainActionInputBufferSize];
+		if (ActionInput.bIsConsumed)
+		{
+			continue;
+		}
 
+		EClimbActionResult Result = EClimbActionResult::None;
 
+		switch (ActionInput.Type)
+		{
+		case EMainInputType::SpaceBarPressed:
+			// One condition chain evaluation per tick however many presses are waiting
+			if (!bEvaluatedSpaceBar)
+			{
+				bEvaluatedSpaceBar = true;
+				Result = ClimbingComponent->JumpAction();
+			}
+			break;
+		case EMainInputType::SpaceBarReleased:
+			StopJumping();
+			Result = EClimbActionResult::Performed;
+			break;
+		case EMainInputType::FKeyPressed:
+			if (!bEvaluatedFKey)
+			{
+				bEvaluatedFKey = true;
+				Result = ClimbingComponent->GrabWallFromTopAction();
+			}
+			break;
+		default:
+			Result = EClimbActionResult::Performed;
+			break;
+		}
 
+		if (Result == EClimbActionResult::PerformedMontage && !bIsResimulating)
+		{
+			SET_FLOAT_STAT(STAT_MainInputToMontageLatency, (FPlatformTime::Seconds() - ActionInput.Timestamp) * 1000.0);
+		}
 
-void AMain::WallJump()
-{
-	WallJumpStaminaManage();
+		// Consumed, or the grace window ran out
+		if (Result != EClimbActionResult::None || FrameStartTime - ActionInput.PressTime > GetActionInputBufferTime(ActionInput.Type))
+		{
+			ActionInput.bIsConsumed = true;
+		}
+	}
 
-	if (WallJumpAnimMontage)
+	// Drop consumed inputs from the front of the ring
+	while (ActionInputBufferNum > 0 && ActionInputBuffer[ActionInputBufferHead].bIsConsumed)
 	{
-		FTimerHandle WaitHandle;
-		float WaitTime = PlayAnimMontage(WallJumpAnimMontage);
-		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-			{
-
+		ActionInputBufferHead = (ActionInputBufferHead + 1) % MainActionInputBufferSize;
+		--ActionInputBufferNum;
+	}
+}
 
-			}), WaitTime, false); //ݺ ⼭ ߰   
+void AMain::InitInputRecordReplay()
+{
+	if (bIsInputRecordReplayInitialized)
+	{
+		return;
 	}
+	bIsInputRecordReplayInitialized = true;
 
-	GetCharacterMovement()->bOrientRotationToMovement = true;
-	SetMovementStatus(EMovementStatus::EMS_WallJumping);
-	GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Falling);
-	FTimerHandle WaitHandle;
-	float WaitTime = 0.3f;
-	GetCharacterMovement()->GravityScale = 0.1f;
-	GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
+	FString FilePath;
+	if (FMainInputRecording::GetReplayPathFromCommandLine(FilePath))
+	{
+		if (!InputRecording.LoadFromFile(FilePath))
 		{
-			GetCharacterMovement()->GravityScale = 1.0f;
-			bIsCanGrabWall = true;
+			UE_LOG(LogTemp, Error, TEXT("Failed to load input recording %s"), *FilePath);
+			return;
+		}
 
-		}), WaitTime, false);
+		bIsReplayingInput = true;
+		InputFrameIndex = 0;
+		ReplayInputEventIndex = 0;
 
-}
+		// Replay under the same fixed timestep the recording used
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(InputRecording.FixedDeltaTime);
 
-bool AMain::WallJumpCondition()
-{
-	if (GetMovementStatus() == EMovementStatus::EMS_Climbing && bIsQKeyDown && !(GetClimbStatus() == EClimbStatus::ECS_DashJump) && !(GetClimbStatus() == EClimbStatus::ECS_TurnCorner))
+		SetActorLocationAndRotation(InputRecording.StartLocation, InputRecording.StartRotation);
+		if (Controller != nullptr)
+		{
+			Controller->SetControlRotation(InputRecording.StartControlRotation);
+		}
+	}
+	else if (FMainInputRecording::GetRecordPathFromCommandLine(FilePath))
 	{
-		return true;
+		bIsRecordingInput = true;
+		InputRecordFilePath = FilePath;
+		InputFrameIndex = 0;
+
+		InputRecording.FixedDeltaTime = FMainInputRecording::GetFixedDeltaTimeFromCommandLine();
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(InputRecording.FixedDeltaTime);
+
+		InputRecording.StartLocation = GetActorLocation();
+		InputRecording.StartRotation = GetActorRotation();
+		if (Controller != nullptr)
+		{
+			InputRecording.StartControlRotation = Controller->GetControlRotation();
+		}
 	}
-	
-	return false;
 }
 
-void AMain::WallJumpStaminaManage()
+void AMain::RecordInput(EMainInputType Type, float Value)
 {
-	if (CurrentStamina > WallJumpStaminaConsumption)
+	RecordRollbackInput(Type, Value);
+
+	// Re-simulated input was recorded when it first ran
+	if (!bIsRecordingInput || bIsResimulating)
 	{
-		FadedStamina = WallJumpStaminaConsumption / MaxStamina;
-		CurrentStamina -= WallJumpStaminaConsumption;
+		return;
 	}
-	else
+
+	// Axis input is called every frame, only store it when the value changes
+	if (FMainInputRecording::IsAxisInput(Type))
 	{
-		FadedStamina = CurrentStamina / MaxStamina;
-		CurrentStamina = 0.f;
+		float& AxisValue = InputAxisValues[(int32)Type];
+		if (AxisValue == Value)
+		{
+			return;
+		}
+		AxisValue = Value;
 	}
 
-
+	FMainInputEvent Event;
+	Event.FrameIndex = InputFrameIndex;
+	Event.Type = Type;
+	Event.Value = Value;
+	InputRecording.Events.Add(Event);
 }
 
-bool AMain::StartClimbWhileWallJumpCondition()
+void AMain::DispatchReplayInput()
 {
-	if (!(GetStaminaStatus() == EStaminaStatus::ESS_Exhausted) && bIsCanGrabWall && (ClimbStartEnoughSpaceCondition()))
+	// Actions in recorded order first, then every axis with its latest value like the input component does
+	while (InputRecording.Events.IsValidIndex(ReplayInputEventIndex) && InputRecording.Events[ReplayInputEventIndex].FrameIndex <= InputFrameIndex)
 	{
-		return true;
+		const FMainInputEvent& Event = InputRecording.Events[ReplayInputEventIndex];
+		++ReplayInputEventIndex;
+
+		DispatchInputEvent(Event, InputAxisValues);
 	}
 
-	return false;
+	MoveForward(InputAxisValues[(int32)EMainInputType::MoveForward]);
+	MoveRight(InputAxisValues[(int32)EMainInputType::MoveRight]);
+	TurnAtRate(InputAxisValues[(int32)EMainInputType::TurnAtRate]);
+	LookUpAtRate(InputAxisValues[(int32)EMainInputType::LookUpAtRate]);
 }
 
-bool AMain::GlidingCondition()
+void AMain::DispatchInputEvent(const FMainInputEvent& Event, float* AxisValues)
 {
-	if ((GetMovementStatus() == EMovementStatus::EMS_Normal || 
-		GetMovementStatus() == EMovementStatus::EMS_Sprinting || 
-		GetMovementStatus() == EMovementStatus::EMS_HaltClimbing || 
-		GetMovementStatus() == EMovementStatus::EMS_WallJumping)
-		&&
-		EnoughSpaceForGliding() &&
-		(GetStaminaStatus() != EStaminaStatus::ESS_Exhausted)
-		)
+	switch (Event.Type)
 	{
-
-		return true;
+	case EMainInputType::SpaceBarPressed: SpaceBarPressed(); break;
+	case EMainInputType::SpaceBarReleased: SpaceBarReleased(); break;
+	case EMainInputType::LeftShiftPressed: LeftShiftPressed(); break;
+	case EMainInputType::LeftShiftReleased: LeftShiftReleased(); break;
+	case EMainInputType::QKeyPressed: QKeyPressed(); break;
+	case EMainInputType::QKeyReleased: QKeyReleased(); break;
+	case EMainInputType::FKeyPressed: FKeyPressed(); break;
+	case EMainInputType::FKeyReleased: FKeyReleased(); break;
+	default:
+		AxisValues[(int32)Event.Type] = Event.Value;
+		break;
 	}
-
-	return false;
 }
 
-void AMain::GlidingVelocityManger()
+void AMain::FinishInputReplay()
 {
-	if (this->GetVelocity().Z < -200.f)
+	bIsReplayingInput = false;
+
+	const bool bMatchMovementStatus = (uint8)GetMovementStatus() == InputRecording.FinalMovementStatus;
+	const bool bMatchStamina = FMath::IsNearlyEqual(StaminaComponent->CurrentStamina, InputRecording.FinalCurrentStamina, 0.01f);
+	if (bMatchMovementStatus && bMatchStamina)
 	{
-		GetCharacterMovement()->GravityScale = 0.0f;
-		GetMovementComponent()->Velocity.Z = -200.f;
+		UE_LOG(LogTemp, Display, TEXT("Input replay finished after %u frames, golden values match"), InputFrameIndex);
 	}
 	else
 	{
-		GetCharacterMovement()->GravityScale = 0.3f;
+		UE_LOG(LogTemp, Error, TEXT("Input replay finished after %u frames, golden values differ : MovementStatus %d (expected %d), CurrentStamina %f (expected %f)"),
+			InputFrameIndex, (int32)GetMovementStatus(), (int32)InputRecording.FinalMovementStatus, StaminaComponent->CurrentStamina, InputRecording.FinalCurrentStamina);
 	}
-}
 
+	if (FParse::Param(FCommandLine::Get(), TEXT("MainInputReplayExit")))
+	{
+		FGenericPlatformMisc::RequestExit(false);
+	}
+}
 
-void AMain::GrabWallFromTop()
+EMovementStatus AMain::GetMovementStatus()
 {
-	bCanGrabWallFromTop = false;
-	FRotator Rot = NormalVectorGrabWallFromTop.Rotation();
-	SetActorRotation(FRotator(0.f, Rot.Yaw, 0.f));
-	SetMovementStatus(EMovementStatus::EMS_ClimbDown);
-	GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Flying);
-	if(GrabWallFromTopAnimMontage)
-	{
-		FTimerHandle WaitHandle;
-		float WaitTime = PlayAnimMontage(GrabWallFromTopAnimMontage) - 0.3f;
-		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-			{
-				bIsCanGrabWall = true;
+	return ClimbingComponent->GetMovementStatus();
+}
 
-			}), WaitTime, false);
-	}
+EClimbStatus AMain::GetClimbStatus()
+{
+	return ClimbingComponent->GetClimbStatus();
 }
 
+EStaminaStatus AMain::GetStaminaStatus()
+{
+	return StaminaComponent->GetStaminaStatus();
+}
 
-bool AMain::GrabWallFromTopCondition()
+void AMain::CaptureMovementSnapshot(FMainMovementSnapshot& OutSnapshot) const
 {
+	ClimbingComponent->CaptureSnapshot(OutSnapshot);
+	StaminaComponent->CaptureSnapshot(OutSnapshot);
 
-	if (GetMovementStatus() == EMovementStatus::EMS_Normal && !GetCharacterMovement()->IsFalling() && bCanGrabWallFromTop)
-	{
-		return true;
-	}
+	OutSnapshot.StaminaConsumption = StaminaConsumption;
+	OutSnapshot.FadedStamina = FadedStamina;
+	OutSnapshot.FadedStaminaDiminishTerm = FadedStaminaDiminishTerm;
+	OutSnapshot.bIsStaminaFilledFull = bIsStaminaFilledFull;
+}
 
-	return false;
+void AMain::RestoreMovementSnapshot(const FMainMovementSnapshot& Snapshot)
+{
+	ClimbingComponent->RestoreSnapshot(Snapshot);
+	RestoreStaminaSnapshot(Snapshot);
+
+	// Presses buffered before the restore belong to the old state
+	ActionInputBufferNum = 0;
 }
 
-bool AMain::ClimbStartEnoughSpaceCondition()
+void AMain::RestoreStaminaSnapshot(const FMainMovementSnapshot& Snapshot)
 {
-	SetIsRightLeftEdgeAtNormal();
-	SetIsFoothold();
-	SetIsBodyWallFacingAndNormalVector();
-	SetIsTopEdge();
+	StaminaComponent->RestoreSnapshot(Snapshot);
+
+	StaminaConsumption = Snapshot.StaminaConsumption;
+	FadedStaminaDiminishTerm = Snapshot.FadedStaminaDiminishTerm;
+	bIsStaminaFilledFull = Snapshot.bIsStaminaFilledFull;
 
-	if (!bIsRightEdge && !bIsLeftEdge && !bIsTopEdge && bIsFoothold && bIsBodyWallFacing)
+	// The widget is pushed the restored bar right away, but only when a quantized value changed.
+	// A rollback restores nearly the bar it shows, the faded segment keeps animating from its start then
+	FStaminaBarState NewState = StaminaBarState;
+	FadedStamina = Snapshot.FadedStamina;
+	NewState.FadedStamina = QuantizeStaminaBarValue(FadedStamina);
+	if (NewState.FadedStamina != StaminaBarState.FadedStamina)
 	{
-		return true;
+		NewState.FadedStaminaStartTime = GetWorld()->GetTimeSeconds();
 	}
+	NewState.CurrentStamina = QuantizeStaminaBarValue(StaminaComponent->CurrentStamina / StaminaComponent->MaxStamina);
+	NewState.StaminaConsumption = QuantizeStaminaBarValue(StaminaConsumption);
+	NewState.bIsStaminaFilledFull = bIsStaminaFilledFull;
 
-	return false;
+	if (NewState != StaminaBarState)
+	{
+		BroadcastStaminaBarState(NewState);
+	}
 }
 
-bool AMain::ClimbStartEnoughSpaceConditionForGround()
+void AMain::SaveMovementSnapshot(TArray<uint8>& OutBytes) const
 {
-	SetIsRightLeftEdgeAtNormal();
-	SetIsFoothold();
-	SetIsTopEdge();
-	SetIsBodyWallFacingAndNormalVector();
+	FMainMovementSnapshot Snapshot;
+	CaptureMovementSnapshot(Snapshot);
+	Snapshot.SaveToBytes(OutBytes);
+}
 
-	if (!bIsRightEdge && !bIsLeftEdge && bIsFoothold && bIsBodyWallFacing)
+bool AMain::LoadMovementSnapshot(const TArray<uint8>& Bytes)
+{
+	FMainMovementSnapshot Snapshot;
+	if (!Snapshot.LoadFromBytes(Bytes))
 	{
-		return true;
+		return false;
 	}
 
-	return false;
+	RestoreMovementSnapshot(Snapshot);
+	return true;
 }
 
-void AMain::FrontFlip()
+bool AMain::CorrectRollbackInput(uint32 FrameIndex, const TArray<FMainInputEvent>& Events)
 {
-	FrontFlipStaminaManage();
-	GetCharacterMovement()->Velocity = FVector(0.0f, 0.0f, 0.0f);
-	GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Flying);
-	SetMovementStatus(EMovementStatus::EMS_FrontFlip);
-	GetCharacterMovement()->bOrientRotationToMovement = false;
-	if (FrontFlipAnimMontage)
+	if (RollbackFrameNum == 0 || GetRollbackFrame(RollbackFrameNum - 1).DeltaTime <= 0.f)
 	{
-		FTimerHandle WaitHandle;
-		float WaitTime = PlayAnimMontage(FrontFlipAnimMontage);
-
-		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-			{
-				GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Falling);
-				SetMovementStatus(EMovementStatus::EMS_Normal);
-				GetCharacterMovement()->bOrientRotationToMovement = true;
+		return false;
+	}
 
-			}), WaitTime, false); //ݺ ⼭ ߰   
+	for (int32 Offset = 0; Offset < RollbackFrameNum; ++Offset)
+	{
+		FMainRollbackFrame& Frame = GetRollbackFrame(Offset);
+		if (Frame.FrameIndex == FrameIndex)
+		{
+			Frame.Events = Events;
+			ResimulateRollbackFrames(Offset);
+			return true;
+		}
 	}
+
+	return false;
 }
 
-void AMain::FrontFlipStaminaManage()
+void AMain::OpenRollbackFrame()
 {
-	if (CurrentStamina > FrontFlipStaminaConsumption)
+	if (RollbackFrames.Num() == 0 || bIsResimulating || RollbackOpenedFrameCounter == GFrameCounter)
 	{
-		FadedStamina = FrontFlipStaminaConsumption / MaxStamina;
-		CurrentStamina -= FrontFlipStaminaConsumption;
+		return;
 	}
-	else
+	RollbackOpenedFrameCounter = GFrameCounter;
+
+	// Full : the oldest frame is reused
+	if (RollbackFrameNum == RollbackFrames.Num())
 	{
-		FadedStamina = CurrentStamina / MaxStamina;
-		CurrentStamina = 0.f;
+		RollbackFrameHead = (RollbackFrameHead + 1) % RollbackFrames.Num();
+		--RollbackFrameNum;
 	}
+	++RollbackFrameNum;
 
-	
+	FMainRollbackFrame& Frame = GetRollbackFrame(RollbackFrameNum - 1);
+	Frame.FrameIndex = InputFrameIndex;
+	Frame.DeltaTime = 0.f;
+	Frame.Events.Reset();
+	Frame.Probes.Reset();
+	CaptureRollbackFrame(Frame);
 }
 
-void AMain::ClimbUp()
+void AMain::RecordRollbackInput(EMainInputType Type, float Value)
 {
-	GetCharacterMovement()->Velocity = FVector(0.0f, 0.0f, 0.0f);
-	SetMovementStatus(EMovementStatus::EMS_ClimbUp);
-	SetClimbStatus(EClimbStatus::ECS_NormalClimb);
-	if (ClimbUpAnimMontage)
+	if (RollbackFrames.Num() == 0 || bIsResimulating)
 	{
-		FTimerHandle WaitHandle;
-		float WaitTime = PlayAnimMontage(ClimbUpAnimMontage);
-		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-			{
+		return;
+	}
 
+	// Input is handled before Tick, the first handler of a frame opens it with the state the input applies to
+	OpenRollbackFrame();
 
-			}), WaitTime, false); //ݺ ⼭ ߰   
+	// Axis input is called every frame, only keep it when the value changes
+	if (FMainInputRecording::IsAxisInput(Type))
+	{
+		float& AxisValue = RollbackAxisValues[(int32)Type];
+		if (AxisValue == Value)
+		{
+			return;
+		}
+		AxisValue = Value;
 	}
+
+	FMainInputEvent Event;
+	Event.FrameIndex = InputFrameIndex;
+	Event.Type = Type;
+	Event.Value = Value;
+	GetRollbackFrame(RollbackFrameNum - 1).Events.Add(Event);
 }
 
-void AMain::TurnCornerInsideRight()
+void AMain::CaptureRollbackFrame(FMainRollbackFrame& Frame)
 {
-	if (TurnCornerInsideRightAnimMontage)
-	{
-		FTimerHandle WaitHandle;
-		float WaitTime = PlayAnimMontage(TurnCornerInsideRightAnimMontage);
-		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-			{
+	CaptureMovementSnapshot(Frame.State);
+	ClimbingComponent->CaptureRollbackState(Frame.ClimbState);
 
+	FMemory::Memcpy(Frame.AxisValues, RollbackAxisValues, sizeof(RollbackAxisValues));
+	Frame.bIsLeftShiftKeyDown = bIsLeftShiftKeyDown;
+	Frame.bIsSpacebarDown = bIsSpacebarDown;
+	Frame.bIsQKeyDown = bIsQKeyDown;
+	Frame.bIsFKeyDown = bIsFKeyDown;
 
-			}), WaitTime, false); //ݺ ⼭ ߰   
-
-		SetClimbStatus(EClimbStatus::ECS_TurnCorner);
-	}
+	FMemory::Memcpy(Frame.ActionInputBuffer, ActionInputBuffer, sizeof(ActionInputBuffer));
+	Frame.ActionInputBufferHead = ActionInputBufferHead;
+	Frame.ActionInputBufferNum = ActionInputBufferNum;
+	Frame.ClimbTime = ClimbingComponent->GetClimbTime();
 }
 
-void AMain::TurnCornerInsideLeft()
+void AMain::RestoreRollbackFrame(const FMainRollbackFrame& Frame)
 {
-	if (TurnCornerInsideLeftAnimMontage)
-	{
-		FTimerHandle WaitHandle;
-		float WaitTime = PlayAnimMontage(TurnCornerInsideLeftAnimMontage);
-		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-			{
+	// Rewind the clock first, the snapshot's ages, the deadlines and the buffered presses are relative to it.
+	// Not the save game restore, montage driven states carry on from where the frame was instead of landing
+	ClimbingComponent->SetClimbTime(Frame.ClimbTime);
+	ClimbingComponent->RestoreRollbackState(Frame.State, Frame.ClimbState);
+	RestoreStaminaSnapshot(Frame.State);
 
+	FMemory::Memcpy(RollbackAxisValues, Frame.AxisValues, sizeof(RollbackAxisValues));
+	bIsLeftShiftKeyDown = Frame.bIsLeftShiftKeyDown;
+	bIsSpacebarDown = Frame.bIsSpacebarDown;
+	bIsQKeyDown = Frame.bIsQKeyDown;
+	bIsFKeyDown = Frame.bIsFKeyDown;
 
-			}), WaitTime, false); //ݺ ⼭ ߰   
-
-		SetClimbStatus(EClimbStatus::ECS_TurnCorner);
-	}
+	FMemory::Memcpy(ActionInputBuffer, Frame.ActionInputBuffer, sizeof(ActionInputBuffer));
+	ActionInputBufferHead = Frame.ActionInputBufferHead;
+	ActionInputBufferNum = Frame.ActionInputBufferNum;
 }
 
-void AMain::TurnCornerOutsideRight()
+void AMain::ResimulateRollbackFrames(int32 FirstOffset)
 {
-	if (TurnCornerOutsideRightAnimMontage)
-	{
-		FTimerHandle WaitHandle;
-		float WaitTime = PlayAnimMontage(TurnCornerOutsideRightAnimMontage);
-		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-			{
+	SCOPE_CYCLE_COUNTER(STAT_MainRollbackResimulate);
 
+	bIsResimulating = true;
 
-			}), WaitTime, false); //ݺ ⼭ ߰   
-
-		SetClimbStatus(EClimbStatus::ECS_TurnCorner);
-	}		
-}
+	// The camera isn't rolled back, re-simulated frames move relative to the present one
+	const FRotator ControlRotation = GetControlRotation();
+	RestoreRollbackFrame(GetRollbackFrame(FirstOffset));
+	if (Controller != nullptr)
+	{
+		Controller->SetControlRotation(ControlRotation);
+	}
 
-void AMain::TurnCornerOutsideLeft()
-{
-	if (TurnCornerOutsideLeftAnimMontage)
+	int32 ProbeReplayMisses = 0;
+	for (int32 Offset = FirstOffset; Offset < RollbackFrameNum; ++Offset)
 	{
-		FTimerHandle WaitHandle;
-		float WaitTime = PlayAnimMontage(TurnCornerOutsideLeftAnimMontage);
-		GetWorld()->GetTimerManager().SetTimer(WaitHandle, FTimerDelegate::CreateLambda([&]()
-			{
+		FMainRollbackFrame& Frame = GetRollbackFrame(Offset);
 
-			}), WaitTime, false); //ݺ ⼭ ߰   
+		// Later frames start from the corrected state now
+		if (Offset > FirstOffset)
+		{
+			CaptureRollbackFrame(Frame);
+		}
 
-		SetClimbStatus(EClimbStatus::ECS_TurnCorner);
+		// Actions in handler order, then the movement axes like the input component gives them
+		for (const FMainInputEvent& Event : Frame.Events)
+		{
+			DispatchInputEvent(Event, RollbackAxisValues);
+		}
+		MoveForward(RollbackAxisValues[(int32)EMainInputType::MoveForward]);
+		MoveRight(RollbackAxisValues[(int32)EMainInputType::MoveRight]);
+
+		// Climbing probes are answered from the frame's record and recorded again for the next rollback
+		ClimbingComponent->BeginClimbProbeFrame(&RollbackProbeScratch, &Frame.Probes);
+		SimulateMovementFrame(Frame.DeltaTime);
+		ClimbingComponent->EndClimbProbeFrame();
+		ProbeReplayMisses += ClimbingComponent->GetClimbProbeReplayMisses();
+		Swap(Frame.Probes, RollbackProbeScratch);
+
+		// The character movement ticks after this actor, move the character here too. Not through its
+		// TickComponent, that would send the past frame to the server as a new move
+		MainMovementComponent->SimulateMovement(Frame.DeltaTime);
+
+		// The montages play on as they did, their notifies end dashes, corner turns and climb ups on the same frame.
+		// A root motion montage was already ticked by the move
+		if (!IsPlayingRootMotion())
+		{
+			GetMesh()->TickAnimation(Frame.DeltaTime, false);
+		}
+		GetMesh()->ConditionallyDispatchQueuedAnimEvents();
 	}
-}
 
-void AMain::TurnCornerVariableRenewal()
-{
-	SetIsRightLeftEdgeAtClimbing();
-	SetCanLeftTurnInsideCorner();
-	SetCanRightTurnInsideCorner();
-	SetCanLeftTurnOutsideCorner();
-	SetCanRightTurnOutsideCorner();
-}
+	bIsResimulating = false;
 
-void AMain::AttachCharacterToWall()
-{
-	SetTooFarFromWall();
-	if (bTooFarFromWall)
-	{
-		const FVector Direction = GetActorForwardVector();
-		AddMovementInput(Direction, 1.0f);
-	}
+	INC_DWORD_STAT_BY(STAT_MainRollbackFrames, RollbackFrameNum - FirstOffset);
+	INC_DWORD_STAT_BY(STAT_MainRollbackProbeMisses, ProbeReplayMisses);
 }
 
-void AMain::AttachCharacterToGround()
+FMainRollbackFrame& AMain::GetRollbackFrame(int32 Offset)
 {
-	SetClimbUpTraceGround();
-	SetIsBodyWallFacingAndNormalVector();
-	if (bClimbUpTraceGround && !bIsBodyWallFacing)
-	{
-		GetCharacterMovement()->bOrientRotationToMovement = true;
-		GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Falling);
-		const FVector Direction = -GetActorUpVector();
-		FVector Position = GetActorLocation();
-		Position.Z = Position.Z - 1.f;
-		SetActorLocation(Position);
-		SetMovementStatus(EMovementStatus::EMS_Normal);
-
-	}
-}
\ No newline at end of file
+	return RollbackFrames[(RollbackFrameHead + Offset) % RollbackFrames.Num()];
+}
@@ -4,59 +4,114 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "MainInputRecording.h"
+#include "ClimbingComponent.h"
+#include "MainMovementSnapshot.h"
 #include "Main.generated.h"
 
-UENUM(BlueprintType)
-enum class EMovementStatus : uint8
+/** Stamina bar values pushed to the stamina bar widget, quantized to 1 / StaminaBarQuantization of the bar */
+USTRUCT(BlueprintType)
+struct FStaminaBarState
 {
-	EMS_Normal UMETA(DisplayName = "Normal"),
-	EMS_Sprinting UMETA(DisplayName = "Sprinting"),
-	EMS_Climbing UMETA(DisplayName = "Climbing"),
-	EMS_Gliding UMETA(DisplayName = "Gliding"),
-	EMS_ClimbUp UMETA(DisplayName = "Climb Up"),
-	EMS_ClimbDown UMETA(DisplayName = "Climb Down"),
-	EMS_WallJumping UMETA(DisplayName = "Wall Jumping"),
-	EMS_HaltClimbing UMETA(DisplayName = "Halt Climbing"),
-	EMS_FrontFlip UMETA(DisplayName = "Front Flip"),
-	EMS_MAX UMETA(DisplayName = "DefaultMAX")
-};
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Stamina Bar")
+	int32 CurrentStamina;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Stamina Bar")
+	int32 StaminaConsumption;
+
+	/** Faded segment at FadedStaminaStartTime. The bar material animates it from there */
+	UPROPERTY(BlueprintReadOnly, Category = "Stamina Bar")
+	int32 FadedStamina;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Stamina Bar")
+	float FadedStaminaStartTime;
 
+	UPROPERTY(BlueprintReadOnly, Category = "Stamina Bar")
+	bool bIsStaminaFilledFull;
+
+	FStaminaBarState()
+	{
+		CurrentStamina = 0;
+		StaminaConsumption = 0;
+		FadedStamina = 0;
+		FadedStaminaStartTime = 0.f;
+		bIsStaminaFilledFull = false;
+	}
+
+	bool operator==(const FStaminaBarState& Other) const
+	{
+		return CurrentStamina == Other.CurrentStamina &&
+			StaminaConsumption == Other.StaminaConsumption &&
+			FadedStamina == Other.FadedStamina &&
+			FadedStaminaStartTime == Other.FadedStaminaStartTime &&
+			bIsStaminaFilledFull == Other.bIsStaminaFilledFull;
+	}
+
+	bool operator!=(const FStaminaBarState& Other) const
+	{
+		return !(*this == Other);
+	}
+};
 
-UENUM(BlueprintType)
-enum class EStaminaStatus : uint8
+/** Action input waiting to be processed at the fixed point of the tick */
+struct FMainActionInput
 {
-	ESS_Normal UMETA(DisplayName = "Normal"),
-	ESS_Exhausted UMETA(DispayName = "Exhausted"),
-	ESS_Sprinting UMETA(DispayName = "Sprinting"),
-	ESS_Climbing UMETA(DispayName = "Climbing"),
-	ESS_Gliding UMETA(DispayName = "Gliding"),
-	ESS_Pause UMETA(DispayName = "Pause"),
-	ESS_MAX UMETA(DisplayName = "DefaultMax")
+	EMainInputType Type;
+	/** Platform time of the key press, for latency stats */
+	double Timestamp;
+	/** Climb clock time of the key press, for the grace window */
+	float PressTime;
+	bool bIsConsumed;
 };
 
-UENUM(BlueprintType)
-enum class EClimbStatus : uint8
+/** Capacity of the action input ring buffer */
+static const int32 MainActionInputBufferSize = 8;
+
+/** One simulated frame kept for rollback : the state it started from, its input and its climbing probes */
+struct FMainRollbackFrame
 {
-	ECS_NormalClimb UMETA(DisplayName = "Normal Climb"),
-	ECS_DashJump UMETA(DispayName = "Dash Jump"),
-	ECS_TurnCorner UMETA(DispayName = "Turn Corner"),
-	ESS_MAX UMETA(DisplayName = "DefaultMax")
+	uint32 FrameIndex;
+
+	/** Zero until the frame has been simulated */
+	float DeltaTime;
+
+	/* State before this frame's input */
+	FMainMovementSnapshot State;
+	/** The playing montage, its deadlines and the movement base, which the snapshot lands instead of keeping */
+	FClimbRollbackState ClimbState;
+	float AxisValues[MainInputAxisCount];
+	bool bIsLeftShiftKeyDown;
+	bool bIsSpacebarDown;
+	bool bIsQKeyDown;
+	bool bIsFKeyDown;
+
+	FMainActionInput ActionInputBuffer[MainActionInputBufferSize];
+	int32 ActionInputBufferHead;
+	int32 ActionInputBufferNum;
+
+	/** Climb clock the buffered presses and the snapshot's ages are relative to, rollback rewinds it */
+	float ClimbTime;
+
+	/** In handler order, axis input only when its value changed */
+	TArray<FMainInputEvent> Events;
+
+	FClimbProbeFrame Probes;
 };
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnStaminaBarChanged, const FStaminaBarState&);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStaminaBarChangedDynamic, const FStaminaBarState&, StaminaBarState);
+
 
 UCLASS()
 class SECOND_API AMain : public ACharacter
 {
 	GENERATED_BODY()
 
-private:
-	EMovementStatus MovementStatus;
-	EStaminaStatus StaminaStatus;
-	EClimbStatus ClimbStatus;
-
 public:
 	// Sets default values for this character's properties
-	AMain();
+	AMain(const FObjectInitializer& ObjectInitializer);
 
 	/* Camera Settings */
 
@@ -82,158 +137,20 @@ public:
 	float LookUpValue;
 
 
-	/* Normal */
-	/** Jump */
-	bool bIsJumping;
-
-	/* Climbing Variable */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Climbing)
-	float ClimbingStaminaConsumption;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Climbing)
-	float InitClimbStartTerm;
-	float ClimbStartTerm;
-
-	bool bTooFarFromWall;
-	bool bIsRightEdge;
-	bool bIsLeftEdge;
-	bool bIsBottomEdge;
-	bool bIsFoothold;
-	bool bIsGround;
-	bool bIsTopEdge;
-	bool bIsCanGrabWall;
-
-	bool bIsBodyWallFacing;
-	FVector NormalVectorBodyWallFacing;
-
-	/** Climbing::Turn Corner */
-	bool bIsTurnCornerRightEdge;
-	bool bIsTurnCornerLeftEdge;
-
-	/*** Inside Corner */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Turn Corner")
-	UAnimMontage* TurnCornerInsideRightAnimMontage;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Turn Corner")
-	UAnimMontage* TurnCornerInsideLeftAnimMontage;
-
-	bool bCanRightTurnInsideCorner;
-	bool bCanLeftTurnInsideCorner;
-
-	/*** Outside Corner */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Turn Corner")
-	UAnimMontage* TurnCornerOutsideRightAnimMontage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Turn Corner")
-	UAnimMontage* TurnCornerOutsideLeftAnimMontage;
-	
-	bool bCanRightTurnOutsideCorner;
-	bool bCanLeftTurnOutsideCorner;
-
-	/** Climbing::Dash Jump */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
-	UAnimMontage* ClimbingDash_U_AnimMontage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
-	UAnimMontage* ClimbingDash_D_AnimMontage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
-	UAnimMontage* ClimbingDash_R_AnimMontage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
-	UAnimMontage* ClimbingDash_L_AnimMontage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
-	UAnimMontage* ClimbingDash_UR_AnimMontage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
-	UAnimMontage* ClimbingDash_DR_AnimMontage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
-	UAnimMontage* ClimbingDash_UL_AnimMontage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
-	UAnimMontage* ClimbingDash_DL_AnimMontage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Dash Jump")
-	float ClimbDashStaminaConsumption;	
-
-	float ClimbDashInclination;
-
-	bool bIsLeftDashing;
-	bool bIsRightDashing;
-
-	/* Climb Up Variable */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Up")
-	UAnimMontage* ClimbUpAnimMontage;
-
-	bool bClimbUpEnoughSpace;
-	bool bClimbUpTraceGround;
+	/* Climbing & Stamina (AMain drives both from Tick) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Climbing)
+	class UClimbingComponent* ClimbingComponent;
 
-	/* Climb Down Variable */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Climb Down")
-	UAnimMontage* GrabWallFromTopAnimMontage;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climb Down") // using UPROPERTY for show message to player (ex: press F key for Climb Down)
-	bool bCanGrabWallFromTop;
-
-	FVector NormalVectorGrabWallFromTop;
-
-	/* Sprinting Variable */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sprinting")
-	float SprintStaminaConsumption;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sprinting")
-	float InitSprintJumpStaminaConsumDuration;
-	float SprintJumpStaminaConsumDuration;
-	
-	bool bIsStaminaConsumSprinting;
-	
-	
-
-	/* Front Flip Variable */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Front Flip")
-	UAnimMontage* FrontFlipAnimMontage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Front Flip")
-	float FrontFlipStaminaConsumption;
-
-	bool bIsLowerRightEdge;
-	bool bIsLowerLeftEdge;
-
-	/* Wall Jumping */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wall Jump")
-	UAnimMontage* WallJumpAnimMontage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wall Jump")
-	float WallJumpStaminaConsumption;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stamina")
+	class UStaminaComponent* StaminaComponent;
 
 	/* Gliding */
 	UPROPERTY(EditAnywhere, Category = "Gliding")
 	class USkeletalMeshComponent* GliderMeshComponent;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding")
-	UAnimMontage* StartGlidingAnimMontage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding")
-	float GlidingStaminaConsumption;
-
-	UPROPERTY(EditAnywhere, BlueprintReadonly, Category = "Gliding")
-	float InitGlidingCoolTime;
-	float GlidingCoolTime;
-	
-
-	/* Stamina Variable */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stamina")
-	float MaxStamina;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stamina")
-	float CurrentStamina;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stamina")
-	float InitStaminaRecoverTerm;
-	float StaminaRecoverTerm;
-	
+	/** Movement component integrating the glider flight model */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Gliding")
+	class UMainMovementComponent* MainMovementComponent;
 
 
 	/* Only for Stamina Bar variable*/
@@ -249,6 +166,25 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stamina Bar") // Using UPROPERTY for Stamina Bar widget
 	bool bIsStaminaFilledFull;
 
+	/** Stamina Bar::Push model (broadcast only when a quantized value changes, no per-frame widget bindings) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stamina Bar", meta = (ClampMin = "1"))
+	int32 StaminaBarQuantization;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stamina Bar")
+	float InitFadedStaminaDiminishTerm;
+
+	/** Bar ratio per second */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stamina Bar")
+	float FadedStaminaDiminishRate;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stamina Bar")
+	FStaminaBarState StaminaBarState;
+
+	FOnStaminaBarChanged OnStaminaBarChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Stamina Bar")
+	FOnStaminaBarChangedDynamic OnStaminaBarChangedDynamic;
+
 	/* Player Stats */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Player Stats")
 	int32 Coins;
@@ -286,19 +222,65 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
 	bool bIsDKeyDown;
 
-	// for debugging
-	float AngleDegree;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
-	bool bDrawDebugLine;
+	/* Input Record & Replay (for performance captures) */
+	bool bIsInputRecordReplayInitialized;
+	bool bIsRecordingInput;
+	bool bIsReplayingInput;
+	uint32 InputFrameIndex;
+	int32 ReplayInputEventIndex;
+	FString InputRecordFilePath;
+	FMainInputRecording InputRecording;
+	float InputAxisValues[MainInputAxisCount];
+
+	/* Input Action Buffer (processed in Tick after this frame's probes) */
+	FMainActionInput ActionInputBuffer[MainActionInputBufferSize];
+	int32 ActionInputBufferHead;
+	int32 ActionInputBufferNum;
+
+	/** Grace window a space bar press waits for its action to become possible */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
+	float SpaceBarBufferTime;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
+	float FKeyBufferTime;
+
+	/* Rollback (re-simulating frames under corrected input, for rollback netcode) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Rollback")
+	bool bRollbackEnabled;
+
+	/** Frames kept to roll back to */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Rollback")
+	int32 MaxRollbackFrames;
+
+	/** Ring of the last MaxRollbackFrames frames, oldest at RollbackFrameHead */
+	TArray<FMainRollbackFrame> RollbackFrames;
+	int32 RollbackFrameHead;
+	int32 RollbackFrameNum;
+
+	/** Engine frame the newest rollback frame was opened in */
+	uint64 RollbackOpenedFrameCounter;
+	float RollbackAxisValues[MainInputAxisCount];
+	FClimbProbeFrame RollbackProbeScratch;
+	bool bIsResimulating;
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void PossessedBy(AController* NewController) override;
+
 public:	
+	/** The engine only shifts scene components, the climbing component is handed the offset from here */
+	virtual void ApplyWorldOffset(const FVector& InOffset, bool bWorldShift) override;
+
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+	/** Climbing, buffered actions and stamina of one frame, in this order. Live from Tick, and again by rollback */
+	void SimulateMovementFrame(float DeltaTime);
+
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
@@ -308,17 +290,25 @@ public:
 	/** Called for side to side input */
 	void MoveRight(float Value);
 
-	virtual void Jump() override;
+	/** Hands the move input to the climbing component, and moves relative to the camera on the ground or gliding */
+	void UpdateDesiredMoveDirection();
+	void AddCameraRelativeMovementInput(EAxis::Type Axis, float Value, float OtherAxisValue);
 
-	void MovementStatusManager(float DeltaTime);
-	void StaminaStatusManager(float DeltaTime);
-	void CurrentStaminaManager(float DeltaTime);
 	void StaminaBarManager(float DeltaTime);
 
+	/* Stamina Bar */
+	void SetFadedStamina(float Value);
+	void OnStaminaConsumed(float Amount);
+	int32 QuantizeStaminaBarValue(float Ratio) const;
+	void BroadcastStaminaBarState(const FStaminaBarState& NewState);
+
 
 	/* Camera */
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
 	FORCEINLINE class UCameraComponent* GetFollowCamera() const { return FollowCamera; }
+	FORCEINLINE class UMainMovementComponent* GetMainMovementComponent() const { return MainMovementComponent; }
+	FORCEINLINE class UClimbingComponent* GetClimbingComponent() const { return ClimbingComponent; }
+	FORCEINLINE class UStaminaComponent* GetStaminaComponent() const { return StaminaComponent; }
 	void TurnAtRate(float Rate);
 	void LookUpAtRate(float Rate);
 
@@ -326,117 +316,25 @@ public:
 	UFUNCTION(BlueprintCallable)
 	EStaminaStatus GetStaminaStatus();
 
-	UFUNCTION(BlueprintCallable)
-	void SetStaminaStatus(EStaminaStatus Status);
-
 	UFUNCTION(BlueprintCallable)
 	EMovementStatus GetMovementStatus();
 
-	UFUNCTION(BlueprintCallable)
-	void SetMovementStatus(EMovementStatus Status);
-
 	UFUNCTION(BlueprintCallable)
 	EClimbStatus GetClimbStatus();
 
-	UFUNCTION(BlueprintCallable)
-	void SetClimbStatus(EClimbStatus Status);
-
+	/* Movement Snapshot (save games, server handoff, rollback) */
+	void CaptureMovementSnapshot(struct FMainMovementSnapshot& OutSnapshot) const;
+	void RestoreMovementSnapshot(const struct FMainMovementSnapshot& Snapshot);
 
-	/* Start Climb */
-	bool StartClimbAtNormalStatusCondition(float DeltaTime);
-	bool StartClimbWhileGlidingCondition(float DeltaTime);
-	bool StartClimbWhileWallJumpCondition();
+	/** Stamina and the bar the widget shows, shared by the snapshot and the rollback restores */
+	void RestoreStaminaSnapshot(const struct FMainMovementSnapshot& Snapshot);
 
-	/* Climbing */
-	void StartClimb();
-	void StopClimb();
+	UFUNCTION(BlueprintCallable, Category = "Snapshot")
+	void SaveMovementSnapshot(TArray<uint8>& OutBytes) const;
 
-	bool ClimbStartEnoughSpaceConditionForGround();
-	bool ClimbStartInputDirectionCondition();
-	bool ClimbStartEnoughSpaceCondition();
-	bool ClimbMaintainCondition();
-	
-	void SetIsFoothold();
-	void SetIsTopEdge();
-	void SetIsBottomEdge();
-	void SetIsRightLeftEdgeAtNormal();
-	void SetIsRightLeftEdgeAtClimbing();
-	void SetIsGround();
-
-	void SetIsBodyWallFacingAndNormalVector();
-
-	/* Climbing Attach to wall*/
-	void AttachCharacterToWall();
-	void SetTooFarFromWall();
-
-	/* Climbing::Turn Corner */
-	void TurnCorner();
-	bool TurnCornerCondition();
-	// Variable Initialization
-	void TurnCornerVariableRenewal();
-	// Inside
-	void TurnCornerInsideRight();
-	void TurnCornerInsideLeft();
-	bool TurnCornerInsideRightCondition();
-	bool TurnCornerInsideLeftCondition();
-	void SetCanRightTurnInsideCorner();
-	void SetCanLeftTurnInsideCorner();
-	// Outside
-	void TurnCornerOutsideRight();
-	void TurnCornerOutsideLeft();
-	bool TurnCornerOutsideRightCondition();
-	bool TurnCornerOutsideLeftCondition();
-	void SetCanRightTurnOutsideCorner();
-	void SetCanLeftTurnOutsideCorner();
-
-	/* Climbing::Dash Jump*/
-
-	void ClimbDashJump();
-	bool ClimbDashJumpCondition();
-	bool ClimbDashCondition_U();
-	bool ClimbDashCondition_D();
-	bool ClimbDashCondition_R();
-	bool ClimbDashCondition_L();
-	bool ClimbDashCondition_UR();
-	bool ClimbDashCondition_DR();
-	bool ClimbDashCondition_UL();
-	bool ClimbDashCondition_DL();
-
-	void ClimbDashJumpStaminaManage();
-
-	/* Climb Up */
-	void ClimbUp();
-	bool ClimbUpCondition();
-	void SetClimbUpEnoughSpace();
-	void SetClimbUpTraceGround();
-
-	void AttachCharacterToGround();
-
-	/* Climb Down */
-	void GrabWallFromTop();
-	bool GrabWallFromTopCondition();
-	void SetCanGrabWallFromTopAndNormalVector();
-
-	/* Front Flip */
-	void FrontFlip();
-	bool FrontFlipCondition();
-	void SetIsLowerRightLeftEdgeAtGround();
-
-	void FrontFlipStaminaManage();
-
-	/* Wall Jump */
-	void WallJump();
-	bool WallJumpCondition();
-	void WallJumpStaminaManage();
-
-
-	/* Glidinig */
-	void StartGliding();
-	void StopGliding();
-	bool EnoughSpaceForGliding();
-	bool GlidingCondition();
-
-	void GlidingVelocityManger();
+	/** False when Bytes isn't a snapshot of this version, nothing is restored then */
+	UFUNCTION(BlueprintCallable, Category = "Snapshot")
+	bool LoadMovementSnapshot(const TArray<uint8>& Bytes);
 
 	/* input */
 	void SpaceBarPressed();
@@ -448,5 +346,36 @@ public:
 	void FKeyPressed();
 	void FKeyReleased();
 
-};
+	/* input::Action Buffer */
+	void BufferActionInput(EMainInputType Type);
+	void ProcessActionInputs(float DeltaTime);
+	void OnClimbStarted();
+	float GetActionInputBufferTime(EMainInputType Type) const;
+
+	/* input::Record & Replay */
+	/** Once, from BeginPlay or SetupPlayerInputComponent, whichever comes first */
+	void InitInputRecordReplay();
+	void RecordInput(EMainInputType Type, float Value);
+	void DispatchReplayInput();
+	void FinishInputReplay();
+
+	/** Calls the handler of an action event, or stores an axis event's value in AxisValues */
+	void DispatchInputEvent(const FMainInputEvent& Event, float* AxisValues);
+
+	/* Rollback */
+	/**
+	 * Replaces the input of a kept frame and re-simulates from its state up to the present, without waiting a frame.
+	 * Call between frames, after the character moved and before the next frame's input (net receive).
+	 * False when the frame isn't kept anymore or the newest frame hasn't been simulated yet.
+	 */
+	bool CorrectRollbackInput(uint32 FrameIndex, const TArray<FMainInputEvent>& Events);
+
+	/** Starts this frame's rollback frame from the current state, once per engine frame before its input applies */
+	void OpenRollbackFrame();
+	void RecordRollbackInput(EMainInputType Type, float Value);
+	void CaptureRollbackFrame(FMainRollbackFrame& Frame);
+	void RestoreRollbackFrame(const FMainRollbackFrame& Frame);
+	void ResimulateRollbackFrames(int32 FirstOffset);
+	FMainRollbackFrame& GetRollbackFrame(int32 Offset);
 
+};
@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MainInputRecording.h"
+#include "Misc/FileHelper.h"
+#include "Misc/CommandLine.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+const uint32 FMainInputRecording::Magic = 0x4D495243; // 'MIRC'
+const uint32 FMainInputRecording::Version = 1;
+
+FArchive& operator<<(FArchive& Ar, FMainInputEvent& Event)
+{
+	uint8 Type = (uint8)Event.Type;
+	Ar << Event.FrameIndex;
+	Ar << Type;
+	Event.Type = (EMainInputType)Type;
+
+	// Actions don't carry a value
+	if (FMainInputRecording::IsAxisInput(Event.Type))
+	{
+		Ar << Event.Value;
+	}
+	else if (Ar.IsLoading())
+	{
+		Event.Value = 0.f;
+	}
+	return Ar;
+}
+
+FMainInputRecording::FMainInputRecording()
+{
+	FixedDeltaTime = 1.f / 60.f;
+	StartLocation = FVector(0.f, 0.f, 0.f);
+	StartRotation = FRotator(0.f, 0.f, 0.f);
+	StartControlRotation = FRotator(0.f, 0.f, 0.f);
+	NumFrames = 0;
+	FinalMovementStatus = 0;
+	FinalCurrentStamina = 0.f;
+}
+
+void FMainInputRecording::Serialize(FArchive& Ar)
+{
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	Ar << FileMagic;
+	Ar << FileVersion;
+	if (Ar.IsLoading() && (FileMagic != Magic || FileVersion != Version))
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Ar << FixedDeltaTime;
+	Ar << StartLocation;
+	Ar << StartRotation;
+	Ar << StartControlRotation;
+	Ar << Events;
+	Ar << NumFrames;
+	Ar << FinalMovementStatus;
+	Ar << FinalCurrentStamina;
+}
+
+bool FMainInputRecording::SaveToFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Serialize(Writer);
+
+	return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FMainInputRecording::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	Serialize(Reader);
+
+	return !Reader.IsError();
+}
+
+bool FMainInputRecording::GetRecordPathFromCommandLine(FString& OutFilePath)
+{
+	return FParse::Value(FCommandLine::Get(), TEXT("MainInputRecord="), OutFilePath);
+}
+
+bool FMainInputRecording::GetReplayPathFromCommandLine(FString& OutFilePath)
+{
+	return FParse::Value(FCommandLine::Get(), TEXT("MainInputReplay="), OutFilePath);
+}
+
+float FMainInputRecording::GetFixedDeltaTimeFromCommandLine()
+{
+	float DeltaTime = 1.f / 60.f;
+	FParse::Value(FCommandLine::Get(), TEXT("MainInputFixedDeltaTime="), DeltaTime);
+	return DeltaTime;
+}
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** AMain input callbacks captured by FMainInputRecording */
+enum class EMainInputType : uint8
+{
+	MoveForward,
+	MoveRight,
+	TurnAtRate,
+	LookUpAtRate,
+	SpaceBarPressed,
+	SpaceBarReleased,
+	LeftShiftPressed,
+	LeftShiftReleased,
+	QKeyPressed,
+	QKeyReleased,
+	FKeyPressed,
+	FKeyReleased,
+	MAX
+};
+
+/** Number of axis inputs, they come first in EMainInputType */
+static const int32 MainInputAxisCount = 4;
+
+struct FMainInputEvent
+{
+	uint32 FrameIndex;
+	EMainInputType Type;
+	float Value;
+
+	friend FArchive& operator<<(FArchive& Ar, FMainInputEvent& Event);
+};
+
+/**
+ * Compact binary capture of AMain input for repeatable performance captures.
+ * Axis inputs are stored only when their value changes, actions when they happen.
+ * The final movement status and stamina are stored as golden values to check a replay against.
+ *
+ * Record : -MainInputRecord=<File> [-MainInputFixedDeltaTime=<Seconds>]
+ * Replay : -nullrhi -MainInputReplay=<File> [-MainInputReplayExit]
+ */
+class SECOND_API FMainInputRecording
+{
+public:
+	FMainInputRecording();
+
+	static const uint32 Magic;
+	static const uint32 Version;
+
+	float FixedDeltaTime;
+	FVector StartLocation;
+	FRotator StartRotation;
+	FRotator StartControlRotation;
+	TArray<FMainInputEvent> Events;
+
+	/** Golden values */
+	uint32 NumFrames;
+	uint8 FinalMovementStatus;
+	float FinalCurrentStamina;
+
+	void Serialize(FArchive& Ar);
+	bool SaveToFile(const FString& FilePath);
+	bool LoadFromFile(const FString& FilePath);
+
+	static bool GetRecordPathFromCommandLine(FString& OutFilePath);
+	static bool GetReplayPathFromCommandLine(FString& OutFilePath);
+	static float GetFixedDeltaTimeFromCommandLine();
+
+	static FORCEINLINE bool IsAxisInput(EMainInputType Type) { return (int32)Type < MainInputAxisCount; }
+};
@@ -0,0 +1,313 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MainMovementComponent.h"
+#include "GlideWindSubsystem.h"
+#include "ContentStreaming.h"
+#include "Engine/World.h"
+#include "Engine/WorldComposition.h"
+#include "Engine/LevelStreaming.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_STATS_GROUP(TEXT("MainMovement"), STATGROUP_MainMovement, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Glide Streaming Hitches"), STAT_GlideStreamingHitches, STATGROUP_MainMovement);
+
+UMainMovementComponent::UMainMovementComponent()
+{
+	bIsGliding = false;
+	GlideBankAngle = 0.f;
+	GlideBankStepTime = 0.f;
+
+	bPrefetchGlidePath = true;
+	GlidePrefetchTime = 6.f;
+	GlidePrefetchStepTime = 0.5f;
+	GlidePrefetchInterval = 0.25f;
+	GlidePrefetchMaxBoost = 4.f;
+	GlidePrefetchMaxLevelPriority = 10;
+	GlidePrefetchVisibleTime = 2.f;
+	GlideHitchTime = 0.05f;
+	GlidePrefetchTimer = 0.f;
+	GlideStreamingHitches = 0;
+
+	CachedWindCellCoord = FIntPoint(0, 0);
+	CachedWindVersion = INDEX_NONE;
+	CachedWindCell = nullptr;
+}
+
+void UMainMovementComponent::SetGliding(bool bGliding)
+{
+	if (bIsGliding && !bGliding && GlideStreamingHitches > 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("Glide ended with %d streaming hitches (path prefetch %s)"), GlideStreamingHitches, bPrefetchGlidePath ? TEXT("on") : TEXT("off"));
+	}
+
+	if (!bGliding)
+	{
+		ReleaseGlidePrefetchLevels(true);
+	}
+
+	bIsGliding = bGliding;
+	GlideBankAngle = 0.f;
+	GlideBankStepTime = 0.f;
+
+	// Predict right away when the glide starts
+	GlidePrefetchTimer = 0.f;
+	GlideStreamingHitches = 0;
+}
+
+bool UMainMovementComponent::IsGliding() const
+{
+	return bIsGliding;
+}
+
+float UMainMovementComponent::GetGlideBankAngle() const
+{
+	return GlideBankAngle;
+}
+
+float UMainMovementComponent::GetGlideBankStepTime() const
+{
+	return GlideBankStepTime;
+}
+
+void UMainMovementComponent::SetGlideBankAngle(float BankAngle, float BankStepTime)
+{
+	GlideBankAngle = BankAngle;
+	GlideBankStepTime = BankStepTime;
+}
+
+void UMainMovementComponent::SimulateMovement(float DeltaTime)
+{
+	if (!HasValidData() || DeltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	// The input part of ControlledCharacterMove, jump state first so the acceleration respects falling
+	const FVector InputVector = ConsumeInputVector();
+	CharacterOwner->CheckJumpInput(DeltaTime);
+	Acceleration = ScaleInputAcceleration(ConstrainInputAcceleration(InputVector));
+	AnalogInputModifier = ComputeAnalogInputModifier();
+
+	PerformMovement(DeltaTime);
+}
+
+void UMainMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Tiles held for a glide still in the air go back to distance streaming
+	ReleaseGlidePrefetchLevels(true);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UMainMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+	if (!bIsGliding || MovementMode != EMovementMode::MOVE_Falling)
+	{
+		return;
+	}
+
+	// Turn input perpendicular to the flight direction banks the glider
+	float LateralAcceleration = 0.f;
+	const FVector HorizontalDirection = FVector(Velocity.X, Velocity.Y, 0.f).GetSafeNormal();
+	if (!HorizontalDirection.IsZero())
+	{
+		const FVector RightDirection = FVector::CrossProduct(FVector::UpVector, HorizontalDirection);
+		LateralAcceleration = FVector::DotProduct(Acceleration, RightDirection) * AirControl;
+	}
+
+	// World gravity, GravityScale is not used while gliding
+	const float WorldGravityZ = GetWorld()->GetGravityZ();
+	const float TargetBankAngle = GlideFlightModel.GetTargetBankAngle(LateralAcceleration, WorldGravityZ);
+
+	Velocity = GlideFlightModel.Integrate(Velocity, GetGlideAirVelocity(), GlideBankAngle, GlideBankStepTime, TargetBankAngle, WorldGravityZ, DeltaSeconds);
+
+	CountGlideStreamingHitch(DeltaSeconds);
+	PrefetchGlidePath(DeltaSeconds);
+}
+
+void UMainMovementComponent::PrefetchGlidePath(float DeltaSeconds)
+{
+	GlidePrefetchTimer -= DeltaSeconds;
+	if (!bPrefetchGlidePath || GlidePrefetchTimer > 0.f || GlidePrefetchStepTime <= 0.f)
+	{
+		return;
+	}
+	GlidePrefetchTimer = GlidePrefetchInterval;
+
+	ReleaseGlidePrefetchLevels(false);
+
+	const UGlideWindSubsystem* WindSubsystem = GetWorld()->GetSubsystem<UGlideWindSubsystem>();
+	const float WorldGravityZ = GetWorld()->GetGravityZ();
+	IStreamingManager& StreamingManager = IStreamingManager::Get();
+
+	// Outlive the interval a little so the path never drops out between two predictions
+	const float PointDuration = GlidePrefetchInterval * 2.f;
+
+	TArray<FVector, TInlineAllocator<16>> PathLocations;
+	TArray<float, TInlineAllocator<16>> PathTimes;
+
+	FVector PathLocation = UpdatedComponent->GetComponentLocation();
+	FVector PathVelocity = Velocity;
+	for (float PathTime = GlidePrefetchStepTime; PathTime <= GlidePrefetchTime; PathTime += GlidePrefetchStepTime)
+	{
+		FVector AirVelocity(0.f, 0.f, 0.f);
+		if (WindSubsystem != nullptr)
+		{
+			AirVelocity = WindSubsystem->SampleAirVelocity(WindSubsystem->FindCell(WindSubsystem->GetCellCoord(PathLocation)), PathLocation);
+		}
+
+		// Trapezoid step on the closed form velocity, exact enough at this spacing
+		const FVector NewPathVelocity = GlideFlightModel.IntegrateClosedForm(PathVelocity, AirVelocity, GlideBankAngle, WorldGravityZ, GlidePrefetchStepTime);
+		PathLocation += (PathVelocity + NewPathVelocity) * (0.5f * GlidePrefetchStepTime);
+		PathVelocity = NewPathVelocity;
+
+		const float Boost = FMath::Lerp(GlidePrefetchMaxBoost, 1.f, PathTime / GlidePrefetchTime);
+		StreamingManager.AddViewSlaveLocation(PathLocation, Boost, false, PointDuration);
+
+		PathLocations.Add(PathLocation);
+		PathTimes.Add(PathTime);
+	}
+
+	// Level streaming is the player's, AI and remote gliders would load the map around themselves
+	if (CharacterOwner->IsLocallyControlled() && CharacterOwner->IsPlayerControlled())
+	{
+		StreamGlidePathLevels(PathLocations, PathTimes, PointDuration);
+	}
+}
+
+void UMainMovementComponent::StreamGlidePathLevels(const TArray<FVector, TInlineAllocator<16>>& PathLocations, const TArray<float, TInlineAllocator<16>>& PathTimes, float HoldTime)
+{
+	UWorld* World = GetWorld();
+	UWorldComposition* WorldComposition = World->WorldComposition;
+	if (WorldComposition == nullptr || !World->IsGameWorld())
+	{
+		return;
+	}
+
+	const float Time = World->GetTimeSeconds();
+	const UWorldComposition::FTilesList& Tiles = WorldComposition->GetTilesList();
+	for (int32 TileIndex = 0; TileIndex < Tiles.Num() && TileIndex < WorldComposition->TilesStreaming.Num(); ++TileIndex)
+	{
+		const FWorldCompositionTile& Tile = Tiles[TileIndex];
+		ULevelStreaming* StreamingLevel = WorldComposition->TilesStreaming[TileIndex];
+		if (StreamingLevel == nullptr || !Tile.Info.Layer.DistanceStreamingEnabled)
+		{
+			continue;
+		}
+
+		// Tile bounds are relative to its absolute position, as world composition tests them against the views
+		const FBox LevelBounds = Tile.Info.Bounds.ShiftBy(FVector(Tile.Info.AbsolutePosition - World->OriginLocation));
+		const float StreamingDistance = (float)Tile.Info.Layer.StreamingDistance;
+
+		// The first path point in range is when the glider gets there
+		int32 PointIndex = 0;
+		while (PointIndex < PathLocations.Num() && !FMath::SphereAABBIntersection(FSphere(PathLocations[PointIndex], StreamingDistance), LevelBounds))
+		{
+			++PointIndex;
+		}
+		if (PointIndex == PathLocations.Num())
+		{
+			continue;
+		}
+
+		FGlidePrefetchLevel* PrefetchLevel = GlidePrefetchLevels.FindByPredicate([StreamingLevel](const FGlidePrefetchLevel& Level) { return Level.StreamingLevel.Get() == StreamingLevel; });
+		if (PrefetchLevel == nullptr)
+		{
+			// Taken off distance streaming by something else, that one decides
+			if (StreamingLevel->bDisableDistanceStreaming)
+			{
+				continue;
+			}
+
+			PrefetchLevel = &GlidePrefetchLevels.AddDefaulted_GetRef();
+			PrefetchLevel->StreamingLevel = StreamingLevel;
+			PrefetchLevel->OriginalPriority = StreamingLevel->GetPriority();
+			StreamingLevel->bDisableDistanceStreaming = true;
+		}
+		PrefetchLevel->ReleaseTime = Time + HoldTime;
+
+		const float ArrivalTime = PathTimes[PointIndex];
+		StreamingLevel->SetShouldBeLoaded(true);
+		if (ArrivalTime <= GlidePrefetchVisibleTime)
+		{
+			StreamingLevel->SetShouldBeVisible(true);
+		}
+		StreamingLevel->SetPriority(FMath::Max(PrefetchLevel->OriginalPriority, FMath::RoundToInt(GlidePrefetchMaxLevelPriority * (1.f - ArrivalTime / GlidePrefetchTime))));
+	}
+}
+
+void UMainMovementComponent::ReleaseGlidePrefetchLevels(bool bReleaseAll)
+{
+	if (GlidePrefetchLevels.Num() == 0)
+	{
+		return;
+	}
+
+	const float Time = GetWorld()->GetTimeSeconds();
+	for (int32 Index = GlidePrefetchLevels.Num() - 1; Index >= 0; --Index)
+	{
+		const FGlidePrefetchLevel& PrefetchLevel = GlidePrefetchLevels[Index];
+		if (!bReleaseAll && PrefetchLevel.ReleaseTime > Time && PrefetchLevel.StreamingLevel.IsValid())
+		{
+			continue;
+		}
+
+		// Loaded and visible as it is, world composition's next update unloads it if the views are out of range
+		if (ULevelStreaming* StreamingLevel = PrefetchLevel.StreamingLevel.Get())
+		{
+			StreamingLevel->bDisableDistanceStreaming = false;
+			StreamingLevel->SetPriority(PrefetchLevel.OriginalPriority);
+		}
+		GlidePrefetchLevels.RemoveAtSwap(Index);
+	}
+}
+
+void UMainMovementComponent::CountGlideStreamingHitch(float DeltaSeconds)
+{
+	if (DeltaSeconds <= GlideHitchTime)
+	{
+		return;
+	}
+
+	// Only long frames spent loading or making levels visible are streaming's fault
+	if (IsAsyncLoading() || GetWorld()->IsVisibilityRequestPending())
+	{
+		++GlideStreamingHitches;
+		INC_DWORD_STAT(STAT_GlideStreamingHitches);
+	}
+}
+
+FVector UMainMovementComponent::GetGlideAirVelocity()
+{
+	const UGlideWindSubsystem* WindSubsystem = GetWorld()->GetSubsystem<UGlideWindSubsystem>();
+	if (WindSubsystem == nullptr)
+	{
+		return FVector(0.f, 0.f, 0.f);
+	}
+
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const FIntPoint CellCoord = WindSubsystem->GetCellCoord(Location);
+
+	// Only look the cell up again when entering a new cell or when volumes were (un)registered
+	if (CellCoord != CachedWindCellCoord || CachedWindVersion != WindSubsystem->GetVersion())
+	{
+		CachedWindCellCoord = CellCoord;
+		CachedWindVersion = WindSubsystem->GetVersion();
+		CachedWindCell = WindSubsystem->FindCell(CellCoord);
+	}
+
+	return WindSubsystem->SampleAirVelocity(CachedWindCell, Location);
+}
+
+FVector UMainMovementComponent::NewFallingVelocity(const FVector& InitialVelocity, const FVector& Gravity, float DeltaTime) const
+{
+	// Vertical velocity is owned by the flight model while gliding
+	if (bIsGliding)
+	{
+		return InitialVelocity;
+	}
+
+	return Super::NewFallingVelocity(InitialVelocity, Gravity, DeltaTime);
+}
@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GlideFlightModel.h"
+#include "MainMovementComponent.generated.h"
+
+class ULevelStreaming;
+
+/** World composition tile the predicted glide path reaches, held loaded until the path leaves it */
+struct FGlidePrefetchLevel
+{
+	TWeakObjectPtr<ULevelStreaming> StreamingLevel;
+
+	/** World time after which the tile goes back to distance streaming */
+	float ReleaseTime;
+
+	/** Priority the tile had before the prefetch raised it */
+	int32 OriginalPriority;
+};
+
+/**
+ * Character movement for AMain. Integrates the glider flight model while gliding.
+ */
+UCLASS()
+class SECOND_API UMainMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	UMainMovementComponent();
+
+	/* Gliding */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding")
+	FGlideFlightModel GlideFlightModel;
+
+	UFUNCTION(BlueprintCallable)
+	void SetGliding(bool bGliding);
+
+	UFUNCTION(BlueprintCallable)
+	bool IsGliding() const;
+
+	UFUNCTION(BlueprintCallable)
+	float GetGlideBankAngle() const;
+
+	float GetGlideBankStepTime() const;
+
+	/** Restores a snapshot's bank and bank step phase, SetGliding levels the glider */
+	void SetGlideBankAngle(float BankAngle, float BankStepTime);
+
+	/* Rollback */
+	/**
+	 * One frame of movement from the pending input, for rollback re-simulation. PerformMovement right away
+	 * without the networking TickComponent does : an autonomous proxy sends no ServerMove and a remote
+	 * character on the server moves too
+	 */
+	void SimulateMovement(float DeltaTime);
+
+	/* Gliding::Streaming Prefetch */
+	/** Off to measure streaming hitches without the prefetch */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding|Streaming")
+	bool bPrefetchGlidePath;
+
+	/** How far ahead the glide path is predicted (s) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding|Streaming")
+	float GlidePrefetchTime;
+
+	/** Time between predicted path points (s) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding|Streaming")
+	float GlidePrefetchStepTime;
+
+	/** How often the path is predicted again (s), the points are kept streaming until the next one */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding|Streaming")
+	float GlidePrefetchInterval;
+
+	/** Streaming boost of the point reached next, falling to 1 at GlidePrefetchTime */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding|Streaming")
+	float GlidePrefetchMaxBoost;
+
+	/** Level streaming priority of the tile reached next, falling to 0 at GlidePrefetchTime */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding|Streaming")
+	int32 GlidePrefetchMaxLevelPriority;
+
+	/** Tiles reached within this (s) are made visible as well, their collision is only in the world once visible */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding|Streaming")
+	float GlidePrefetchVisibleTime;
+
+	/** A gliding frame longer than this (s) while packages or levels are still streaming in counts as a streaming hitch */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gliding|Streaming")
+	float GlideHitchTime;
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+	virtual FVector NewFallingVelocity(const FVector& InitialVelocity, const FVector& Gravity, float DeltaTime) const override;
+
+private:
+	bool bIsGliding;
+	float GlideBankAngle;
+
+	/** Time left until the flight model's next bank step */
+	float GlideBankStepTime;
+
+	/* Gliding::Wind (cached while staying in the same grid cell) */
+	FVector GetGlideAirVelocity();
+
+	/**
+	 * Predicts the glide path with the flight model, holding the current bank, and adds its points
+	 * as streaming view locations. Texture and mesh LOD streaming load around those, so the ground ahead
+	 * is sharp when the glider gets there. Points reached sooner get the higher boost.
+	 * The player's own glider also streams in the world composition tiles along the path, see StreamGlidePathLevels.
+	 */
+	void PrefetchGlidePath(float DeltaSeconds);
+
+	/**
+	 * Loads the world composition tiles whose streaming distance a path point is within, the tile reached sooner
+	 * at the higher priority, and makes the ones reached within GlidePrefetchVisibleTime visible so their collision
+	 * is there for the climb and landing probes. World composition sets every distance streamed tile from the
+	 * players' views once per frame, so a prefetched tile is taken off distance streaming until the path leaves it.
+	 * Streaming volume levels aren't prefetched, the volumes reset them from the views every frame with no way out.
+	 */
+	void StreamGlidePathLevels(const TArray<FVector, TInlineAllocator<16>>& PathLocations, const TArray<float, TInlineAllocator<16>>& PathTimes, float HoldTime);
+
+	/** Hands the prefetched tiles released by now, or all of them, back to distance streaming */
+	void ReleaseGlidePrefetchLevels(bool bReleaseAll);
+
+	void CountGlideStreamingHitch(float DeltaSeconds);
+
+	float GlidePrefetchTimer;
+	int32 GlideStreamingHitches;
+	TArray<FGlidePrefetchLevel> GlidePrefetchLevels;
+
+	FIntPoint CachedWindCellCoord;
+	int32 CachedWindVersion;
+	const struct FGlideWindCell* CachedWindCell;
+};
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MainMovementSnapshot.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+const uint32 FMainMovementSnapshot::Magic = 0x4D4D534E; // 'MMSN'
+const uint32 FMainMovementSnapshot::Version = 3;
+
+static_assert(sizeof(FMainMovementSnapshot) == 236, "FMainMovementSnapshot layout changed, bump its Version");
+
+FMainMovementSnapshot::FMainMovementSnapshot()
+{
+	// Padding and unused flag bits too, the same state always gives the same bytes
+	FMemory::Memzero(this, sizeof(FMainMovementSnapshot));
+
+	ClimbSpeedMultiplier = 1.f;
+	ClimbStaminaMultiplier = 1.f;
+	StaminaDrainMultiplier = 1.f;
+	WetSlipAge = -1.f;
+	ClimbStopAge = -1.f;
+}
+
+void FMainMovementSnapshot::Serialize(FArchive& Ar)
+{
+	uint32 SnapshotMagic = Magic;
+	uint32 SnapshotVersion = Version;
+	uint32 SnapshotSize = sizeof(FMainMovementSnapshot);
+	Ar << SnapshotMagic;
+	Ar << SnapshotVersion;
+	Ar << SnapshotSize;
+	if (Ar.IsLoading() && (SnapshotMagic != Magic || SnapshotVersion != Version || SnapshotSize != sizeof(FMainMovementSnapshot)))
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Ar.Serialize(this, sizeof(FMainMovementSnapshot));
+}
+
+void FMainMovementSnapshot::SaveToBytes(TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+	Serialize(Writer);
+}
+
+bool FMainMovementSnapshot::LoadFromBytes(const TArray<uint8>& Bytes)
+{
+	FMemoryReader Reader(Bytes);
+	Serialize(Reader);
+
+	return !Reader.IsError();
+}
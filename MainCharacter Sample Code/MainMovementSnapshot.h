@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed layout binary snapshot of AMain's movement runtime state : character movement, the climbing and
+ * gliding state machine with its probe results and timers, and stamina.
+ * Restoring doesn't trace, the probe flags and wall normals are put back as they were captured.
+ * Serialized as one block after a small header, so saving or loading is a copy of a few hundred bytes.
+ * Same build and same endianness only, a layout change bumps Version and old snapshots are refused.
+ *
+ * Locations are absolute (world origin added), climb clock times are stored as the time since then.
+ * The movement base and playing montages aren't kept : climbing restores onto the wall as a static one,
+ * montage driven states (climb up, front flip, dash and corner turns) restore as the state they end in.
+ * Rollback frames keep those beside the snapshot in an FClimbRollbackState and carry them on instead.
+ */
+struct SECOND_API FMainMovementSnapshot
+{
+	FMainMovementSnapshot();
+
+	static const uint32 Magic;
+	static const uint32 Version;
+
+	/* Character */
+	FVector Location;
+	FRotator Rotation;
+	FRotator ControlRotation;
+	FVector Velocity;
+
+	/* Character Movement */
+	float AirControl;
+	float RotationRateYaw;
+	float BrakingDecelerationFalling;
+	float MaxWalkSpeed;
+	float MaxFlySpeed;
+	float GravityScale;
+	float GlideBankAngle;
+	float GlideBankStepTime;
+
+	/* Climbing */
+	FVector NormalVectorBodyWallFacing;
+	FVector NormalVectorGrabWallFromTop;
+	FVector BodyWallContactPoint;
+	FVector FootWallContactPoint;
+	FVector PredictedClimbVelocity;
+
+	float ClimbStartTerm;
+	float GlidingCoolTime;
+	float SprintJumpStaminaConsumDuration;
+	float ClimbUpGroundZ;
+	float ClimbDownTargetZ;
+	float ClimbPredictionRetraceTerm;
+	float PredictedClimbContactTime;
+	float ClimbSpeedMultiplier;
+	float ClimbStaminaMultiplier;
+	float ClimbSurfaceWetness;
+	float WetSlipTimer;
+
+	/** Time a reduced climb LOD accumulated for its next probes */
+	float ClimbProbeDeltaTime;
+
+	/** Seconds since the last wet slip or climb stop, negative when there was none */
+	float WetSlipAge;
+	float ClimbStopAge;
+
+	/* Stamina */
+	float CurrentStamina;
+	float StaminaRecoverTerm;
+	float StaminaDrainRate;
+	float StaminaDrainMultiplier;
+
+	/* Stamina Bar */
+	float StaminaConsumption;
+	float FadedStamina;
+	float FadedStaminaDiminishTerm;
+
+	/* Flags */
+	uint32 bOrientRotationToMovement : 1;
+	uint32 bIsGliding : 1;
+	uint32 bIsJumping : 1;
+	uint32 bWantsToSprint : 1;
+	uint32 bIsBracing : 1;
+	uint32 bTooFarFromWall : 1;
+	uint32 bIsRightEdge : 1;
+	uint32 bIsLeftEdge : 1;
+	uint32 bIsBottomEdge : 1;
+	uint32 bIsFoothold : 1;
+	uint32 bIsGround : 1;
+	uint32 bIsTopEdge : 1;
+	uint32 bIsCanGrabWall : 1;
+	uint32 bIsBodyWallFacing : 1;
+	uint32 bHasPredictedClimbContact : 1;
+	uint32 bIsClimbContactImminent : 1;
+	uint32 bIsTurnCornerRightEdge : 1;
+	uint32 bIsTurnCornerLeftEdge : 1;
+	uint32 bCanRightTurnInsideCorner : 1;
+	uint32 bCanLeftTurnInsideCorner : 1;
+	uint32 bCanRightTurnOutsideCorner : 1;
+	uint32 bCanLeftTurnOutsideCorner : 1;
+	uint32 bIsLeftDashing : 1;
+	uint32 bIsRightDashing : 1;
+	uint32 bClimbUpEnoughSpace : 1;
+	uint32 bClimbUpTraceGround : 1;
+	uint32 bCanGrabWallFromTop : 1;
+	uint32 bIsStaminaConsumSprinting : 1;
+	uint32 bIsLowerRightEdge : 1;
+	uint32 bIsLowerLeftEdge : 1;
+	uint32 bIsStaminaFilledFull : 1;
+
+	/* Status (enum values) */
+	uint8 MovementMode;
+	uint8 CustomMovementMode;
+	uint8 MovementStatus;
+	uint8 ClimbStatus;
+	uint8 StaminaStatus;
+	uint8 Padding[3];
+
+	/** Header, then the whole struct in one block */
+	void Serialize(FArchive& Ar);
+	void SaveToBytes(TArray<uint8>& OutBytes);
+	bool LoadFromBytes(const TArray<uint8>& Bytes);
+};
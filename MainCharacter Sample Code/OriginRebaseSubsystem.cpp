@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OriginRebaseSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/WorldSettings.h"
+
+UOriginRebaseSubsystem::UOriginRebaseSubsystem()
+{
+	// A float keeps 1/64 cm steps out to here
+	RebaseDistance = 200000.f;
+}
+
+void UOriginRebaseSubsystem::Tick(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	const APlayerController* PlayerController = World->GetFirstPlayerController();
+	const APawn* Pawn = PlayerController != nullptr ? PlayerController->GetPawn() : nullptr;
+	if (Pawn == nullptr)
+	{
+		return;
+	}
+
+	const FVector Location = Pawn->GetActorLocation();
+	if (Location.SizeSquared() < FMath::Square(RebaseDistance))
+	{
+		return;
+	}
+
+	// Every actor and component is shifted in ApplyWorldOffset before this returns
+	World->SetNewWorldOrigin(World->OriginLocation + FIntVector(Location));
+}
+
+bool UOriginRebaseSubsystem::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return !IsTemplate() && World != nullptr && World->IsGameWorld() && World->WorldComposition == nullptr
+		&& World->GetWorldSettings() != nullptr && World->GetWorldSettings()->bEnableWorldOriginRebasing;
+}
+
+TStatId UOriginRebaseSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOriginRebaseSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "OriginRebaseSubsystem.generated.h"
+
+/**
+ * Moves the world origin under the player once they get RebaseDistance away from it, so locations
+ * near the player (and the climb probes built from them) keep their float precision on a large map.
+ * Runs when Enable World Origin Rebasing is set in the world settings and the level isn't a world
+ * composition, which rebases by itself. Level data baked in absolute coordinates (climb graph,
+ * wind and wetness grids) converts with the world's OriginLocation.
+ */
+UCLASS()
+class SECOND_API UOriginRebaseSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UOriginRebaseSubsystem();
+
+	/** How far the player may get from the world origin before it follows (cm) */
+	float RebaseDistance;
+
+	/* FTickableGameObject */
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+};
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StaminaComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "MainMovementSnapshot.h"
+
+UStaminaComponent::UStaminaComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+
+	StaminaStatus = EStaminaStatus::ESS_Normal;
+
+	MaxStamina = 150.f;
+	CurrentStamina = 150.f;
+
+	InitStaminaRecoverTerm = 0.5f;
+	StaminaRecoverTerm = 0.5f;
+	StaminaRecoverRate = 40.f;
+
+	StaminaDrainRate = 0.f;
+	StaminaDrainMultiplier = 1.f;
+}
+
+void UStaminaComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	CurrentStaminaManager(DeltaTime);
+}
+
+void UStaminaComponent::CurrentStaminaManager(float DeltaTime)
+{
+	// Managing Current Stamina by referring to Stamina Status and the drain rate of the movement
+	const ACharacter* Character = Cast<ACharacter>(GetOwner());
+	const bool bIsFalling = Character != nullptr && Character->GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Falling;
+
+	if (GetStaminaStatus() == EStaminaStatus::ESS_Normal || (GetStaminaStatus() == EStaminaStatus::ESS_Exhausted && !bIsFalling))
+	{
+		StaminaRecoverTerm -= DeltaTime;
+		if (CurrentStamina < MaxStamina && StaminaRecoverTerm <= 0.f)
+		{
+			StaminaRecoverTerm = 0.f;
+			CurrentStamina += DeltaTime * StaminaRecoverRate;
+			if (CurrentStamina >= MaxStamina)
+			{
+				CurrentStamina = MaxStamina;
+			}
+		}
+	}
+	else if (GetStaminaStatus() != EStaminaStatus::ESS_Exhausted)
+	{
+		// Sprinting, climbing, gliding and pause hold the recovery back
+		StaminaRecoverTerm = InitStaminaRecoverTerm;
+		CurrentStamina = FMath::Clamp(CurrentStamina - DeltaTime * StaminaDrainRate * StaminaDrainMultiplier, 0.f, MaxStamina);
+	}
+}
+
+void UStaminaComponent::ConsumeStamina(float Amount)
+{
+	const float Consumed = FMath::Min(Amount, CurrentStamina);
+	CurrentStamina = FMath::Clamp(CurrentStamina - Consumed, 0.f, MaxStamina);
+	OnStaminaConsumed.Broadcast(Consumed);
+}
+
+EStaminaStatus UStaminaComponent::GetStaminaStatus() const
+{
+	return StaminaStatus;
+}
+
+void UStaminaComponent::SetStaminaStatus(EStaminaStatus Status)
+{
+	StaminaStatus = Status;
+}
+
+void UStaminaComponent::CaptureSnapshot(FMainMovementSnapshot& OutSnapshot) const
+{
+	OutSnapshot.StaminaStatus = (uint8)StaminaStatus;
+	OutSnapshot.CurrentStamina = CurrentStamina;
+	OutSnapshot.StaminaRecoverTerm = StaminaRecoverTerm;
+	OutSnapshot.StaminaDrainRate = StaminaDrainRate;
+	OutSnapshot.StaminaDrainMultiplier = StaminaDrainMultiplier;
+}
+
+void UStaminaComponent::RestoreSnapshot(const FMainMovementSnapshot& Snapshot)
+{
+	StaminaStatus = (EStaminaStatus)Snapshot.StaminaStatus;
+	CurrentStamina = FMath::Clamp(Snapshot.CurrentStamina, 0.f, MaxStamina);
+	StaminaRecoverTerm = Snapshot.StaminaRecoverTerm;
+	StaminaDrainRate = Snapshot.StaminaDrainRate;
+	StaminaDrainMultiplier = Snapshot.StaminaDrainMultiplier;
+}
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "StaminaComponent.generated.h"
+
+UENUM(BlueprintType)
+enum class EStaminaStatus : uint8
+{
+	ESS_Normal UMETA(DisplayName = "Normal"),
+	ESS_Exhausted UMETA(DispayName = "Exhausted"),
+	ESS_Sprinting UMETA(DispayName = "Sprinting"),
+	ESS_Climbing UMETA(DispayName = "Climbing"),
+	ESS_Gliding UMETA(DispayName = "Gliding"),
+	ESS_Pause UMETA(DispayName = "Pause"),
+	ESS_MAX UMETA(DisplayName = "DefaultMax")
+};
+
+/** Amount taken by a one-off action, for the faded segment of the stamina bar */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnStaminaConsumed, float);
+
+/**
+ * Stamina pool of a character. Whoever owns the movement state (UClimbingComponent) sets the
+ * stamina status and the drain rate, this component drains and recovers the pool with them.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class SECOND_API UStaminaComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+private:
+	EStaminaStatus StaminaStatus;
+
+public:
+	UStaminaComponent();
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stamina")
+	float MaxStamina;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stamina")
+	float CurrentStamina;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stamina")
+	float InitStaminaRecoverTerm;
+	float StaminaRecoverTerm;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stamina")
+	float StaminaRecoverRate;
+
+	/** Stamina per second drained by the current movement */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stamina")
+	float StaminaDrainRate;
+
+	/** Scale of the drain rate from the surface under the movement (the climbed wall's material) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stamina")
+	float StaminaDrainMultiplier;
+
+	FOnStaminaConsumed OnStaminaConsumed;
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	void CurrentStaminaManager(float DeltaTime);
+
+	/** Takes a one-off action's cost, down to zero at most */
+	void ConsumeStamina(float Amount);
+
+	UFUNCTION(BlueprintCallable)
+	EStaminaStatus GetStaminaStatus() const;
+
+	UFUNCTION(BlueprintCallable)
+	void SetStaminaStatus(EStaminaStatus Status);
+
+	/* Snapshot (AMain::SaveMovementSnapshot) */
+	void CaptureSnapshot(struct FMainMovementSnapshot& OutSnapshot) const;
+	void RestoreSnapshot(const struct FMainMovementSnapshot& Snapshot);
+
+	FORCEINLINE bool IsExhausted() const { return StaminaStatus == EStaminaStatus::ESS_Exhausted; }
+	FORCEINLINE bool IsStaminaFilledFull() const { return CurrentStamina >= MaxStamina; }
+};
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbAnimInstance.h"
+#include "ClimbBenchmarkWorld.h"
+#include "Main.h"
+#include "Misc/AutomationTest.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "HAL/IConsoleManager.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbAnimInstanceTests
+{
+	static const int32 CrowdSize = 10;
+	static const float CrowdSpacing = 600.f;
+
+	/**
+	 * CrowdSize x CrowdSize characters walking into a wall block each and climbing it, with their pose
+	 * updated every frame. Returns the game thread frame times after a warm up
+	 */
+	static void RunCrowd(bool bParallelAnimUpdate, int32 NumFrames, TArray<double>& OutFrameTimes, int32& OutNumClimbAnimInstances)
+	{
+		IConsoleVariable* ParallelAnimUpdate = IConsoleManager::Get().FindConsoleVariable(TEXT("a.ParallelAnimUpdate"));
+		const int32 PreviousParallelAnimUpdate = ParallelAnimUpdate ? ParallelAnimUpdate->GetInt() : 1;
+		if (ParallelAnimUpdate)
+		{
+			ParallelAnimUpdate->Set(bParallelAnimUpdate ? 1 : 0, ECVF_SetByCode);
+		}
+
+		FClimbBenchmarkWorld BenchmarkWorld;
+
+		const float CrowdExtent = CrowdSize * CrowdSpacing;
+		BenchmarkWorld.AddCube(FVector(CrowdExtent * 0.5f, CrowdExtent * 0.5f, -50.f), FVector(CrowdExtent + 2000.f, CrowdExtent + 2000.f, 100.f));
+
+		OutNumClimbAnimInstances = 0;
+		TArray<AMain*> Crowd;
+		for (int32 X = 0; X < CrowdSize; ++X)
+		{
+			for (int32 Y = 0; Y < CrowdSize; ++Y)
+			{
+				const FVector Location(X * CrowdSpacing, Y * CrowdSpacing, 100.f);
+				BenchmarkWorld.AddCube(Location + FVector(200.f, 0.f, 400.f), FVector(100.f, 300.f, 1000.f));
+				if (AMain* Main = Cast<AMain>(BenchmarkWorld.SpawnCharacter(Location, FRotator::ZeroRotator)))
+				{
+					// Nothing is rendered in a test, the pose still updates as if on screen
+					Main->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+					OutNumClimbAnimInstances += Cast<UClimbAnimInstance>(Main->GetMesh()->GetAnimInstance()) ? 1 : 0;
+					Crowd.Add(Main);
+				}
+			}
+		}
+
+		auto BeforeTick = [&Crowd]()
+		{
+			for (AMain* Main : Crowd)
+			{
+				Main->MoveForward(1.f);
+			}
+		};
+
+		TArray<double> WarmUpFrameTimes;
+		BenchmarkWorld.Tick(30, 1.f / 60.f, WarmUpFrameTimes, BeforeTick);
+		BenchmarkWorld.Tick(NumFrames, 1.f / 60.f, OutFrameTimes, BeforeTick);
+
+		if (ParallelAnimUpdate)
+		{
+			ParallelAnimUpdate->Set(PreviousParallelAnimUpdate, ECVF_SetByCode);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbAnimInstanceCrowdBenchmark, "Second.Climbing.AnimInstance.CrowdBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FClimbAnimInstanceCrowdBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace ClimbAnimInstanceTests;
+
+	const int32 NumFrames = 600;
+	int32 NumClimbAnimInstances = 0;
+
+	// Before : the whole anim update on the game thread, as the Blueprint event graph ran it
+	TArray<double> GameThreadFrameTimes;
+	RunCrowd(false, NumFrames, GameThreadFrameTimes, NumClimbAnimInstances);
+	AddInfo(FString::Printf(TEXT("%d characters, game thread anim update : %s"), CrowdSize * CrowdSize, *FClimbBenchmarkWorld::FormatFrameTimes(GameThreadFrameTimes)));
+
+	// After : UClimbAnimInstance's proxy updates on the animation worker threads
+	TArray<double> ParallelFrameTimes;
+	RunCrowd(true, NumFrames, ParallelFrameTimes, NumClimbAnimInstances);
+	AddInfo(FString::Printf(TEXT("%d characters, parallel anim update : %s"), CrowdSize * CrowdSize, *FClimbBenchmarkWorld::FormatFrameTimes(ParallelFrameTimes)));
+
+	if (NumClimbAnimInstances < CrowdSize * CrowdSize)
+	{
+		AddWarning(FString::Printf(TEXT("Only %d of %d characters run a UClimbAnimInstance, pass -ClimbBenchmarkCharacter=<character blueprint> with the reparented anim blueprint"),
+			NumClimbAnimInstances, CrowdSize * CrowdSize));
+	}
+
+	const double GameThreadP50 = FClimbBenchmarkWorld::GetPercentile(GameThreadFrameTimes, 0.5f);
+	const double ParallelP50 = FClimbBenchmarkWorld::GetPercentile(ParallelFrameTimes, 0.5f);
+	AddInfo(FString::Printf(TEXT("p50 frame time %.2f ms -> %.2f ms (%+.1f%%)"), GameThreadP50, ParallelP50, GameThreadP50 > 0.0 ? (ParallelP50 / GameThreadP50 - 1.0) * 100.0 : 0.0));
+
+	return true;
+}
+
+#endif
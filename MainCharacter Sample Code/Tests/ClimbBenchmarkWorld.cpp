@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbBenchmarkWorld.h"
+#include "Main.h"
+#include "ClimbProbeSchedulerSubsystem.h"
+#include "ClimbSignificanceSubsystem.h"
+#include "ClimbWetnessSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+FClimbBenchmarkWorld::FClimbBenchmarkWorld()
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	// Spawned actors begin play and tick as in a level
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	CharacterClass = AMain::StaticClass();
+
+	FString CharacterClassPath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("ClimbBenchmarkCharacter="), CharacterClassPath))
+	{
+		if (UClass* LoadedClass = LoadClass<ACharacter>(nullptr, *CharacterClassPath))
+		{
+			CharacterClass = LoadedClass;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("Climb benchmark character %s not found, using AMain"), *CharacterClassPath);
+		}
+	}
+}
+
+FClimbBenchmarkWorld::~FClimbBenchmarkWorld()
+{
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+}
+
+AActor* FClimbBenchmarkWorld::AddCube(const FVector& Location, const FVector& Size, const FRotator& Rotation)
+{
+	// The engine cube is 100 cm, its mesh is set before the component registers as static
+	const FTransform Transform(Rotation, Location, Size / 100.f);
+	AStaticMeshActor* Block = World->SpawnActorDeferred<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform);
+	Block->GetStaticMeshComponent()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+	Block->FinishSpawning(Transform);
+	return Block;
+}
+
+AActor* FClimbBenchmarkWorld::AddSphere(const FVector& Location, float Radius)
+{
+	// The engine sphere is 100 cm across, with simple sphere collision
+	const FTransform Transform(FRotator::ZeroRotator, Location, FVector(Radius / 50.f));
+	AStaticMeshActor* Ball = World->SpawnActorDeferred<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform);
+	Ball->GetStaticMeshComponent()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Sphere.Sphere")));
+	Ball->FinishSpawning(Transform);
+	return Ball;
+}
+
+ACharacter* FClimbBenchmarkWorld::SpawnCharacter(const FVector& Location, const FRotator& Rotation)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ACharacter* Character = World->SpawnActor<ACharacter>(CharacterClass, Location, Rotation, SpawnParameters);
+	if (Character != nullptr)
+	{
+		// Moves like a remote AI climber, not locally controlled
+		Character->SpawnDefaultController();
+	}
+	return Character;
+}
+
+void FClimbBenchmarkWorld::Tick(int32 NumFrames, float DeltaTime, TArray<double>& OutFrameTimes, TFunctionRef<void()> BeforeTick)
+{
+	UClimbProbeSchedulerSubsystem* ProbeScheduler = World->GetSubsystem<UClimbProbeSchedulerSubsystem>();
+	UClimbSignificanceSubsystem* Significance = World->GetSubsystem<UClimbSignificanceSubsystem>();
+	UClimbWetnessSubsystem* Wetness = World->GetSubsystem<UClimbWetnessSubsystem>();
+
+	OutFrameTimes.Reserve(OutFrameTimes.Num() + NumFrames);
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		BeforeTick();
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		World->Tick(LEVELTICK_All, DeltaTime);
+
+		// The engine loop ticks the climbing subsystems between frames, it doesn't run inside a test
+		if (ProbeScheduler != nullptr)
+		{
+			ProbeScheduler->Tick(DeltaTime);
+		}
+		if (Significance != nullptr)
+		{
+			Significance->Tick(DeltaTime);
+		}
+		if (Wetness != nullptr)
+		{
+			Wetness->Tick(DeltaTime);
+		}
+
+		OutFrameTimes.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}
+}
+
+double FClimbBenchmarkWorld::GetPercentile(const TArray<double>& FrameTimes, float Percentile)
+{
+	if (FrameTimes.Num() == 0)
+	{
+		return 0.0;
+	}
+
+	TArray<double> SortedFrameTimes = FrameTimes;
+	SortedFrameTimes.Sort();
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedFrameTimes.Num()) - 1, 0, SortedFrameTimes.Num() - 1);
+	return SortedFrameTimes[Index];
+}
+
+FString FClimbBenchmarkWorld::FormatFrameTimes(const TArray<double>& FrameTimes)
+{
+	return FString::Printf(TEXT("p50 %.2f ms, p99 %.2f ms, worst %.2f ms over %d frames"),
+		GetPercentile(FrameTimes, 0.5f), GetPercentile(FrameTimes, 0.99f), GetPercentile(FrameTimes, 1.f), FrameTimes.Num());
+}
+
+#endif
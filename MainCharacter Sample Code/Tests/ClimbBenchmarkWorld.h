@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+class UWorld;
+class AActor;
+class ACharacter;
+
+/**
+ * A game world for the climbing benchmarks : blocks of the engine's basic shapes to climb on, characters
+ * possessed by their AI controller, and fixed step frames timed on the game thread.
+ * The characters are AMain, or the class given by -ClimbBenchmarkCharacter=<class path> on the command line
+ * so the game's character blueprint runs with its meshes, montages and anim blueprint.
+ */
+class FClimbBenchmarkWorld
+{
+public:
+	FClimbBenchmarkWorld();
+	~FClimbBenchmarkWorld();
+
+	FORCEINLINE UWorld* GetWorld() const { return World; }
+
+	/** Static block of the engine cube, Size in cm */
+	AActor* AddCube(const FVector& Location, const FVector& Size, const FRotator& Rotation = FRotator::ZeroRotator);
+
+	/** Static ball of the engine sphere, a curved rock with an overhang below its equator */
+	AActor* AddSphere(const FVector& Location, float Radius);
+
+	ACharacter* SpawnCharacter(const FVector& Location, const FRotator& Rotation);
+
+	/**
+	 * Ticks NumFrames frames of DeltaTime, the world and its climbing subsystems, and adds each frame's
+	 * game thread time in ms to OutFrameTimes. BeforeTick runs before each frame, outside the timing
+	 */
+	void Tick(int32 NumFrames, float DeltaTime, TArray<double>& OutFrameTimes, TFunctionRef<void()> BeforeTick);
+
+	/** Percentile between 0 and 1 of the frame times */
+	static double GetPercentile(const TArray<double>& FrameTimes, float Percentile);
+
+	/** p50, p99 and the worst frame */
+	static FString FormatFrameTimes(const TArray<double>& FrameTimes);
+
+private:
+	UWorld* World;
+	UClass* CharacterClass;
+};
+
+#endif
@@ -0,0 +1,172 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbDirection.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbDirectionTests
+{
+	/** Octant by the input angle, 0 degrees is Up and 90 degrees Right, the order of EClimbDirection */
+	static EClimbDirection ReferenceClassify(float Forward, float Right, float& OutBoundaryDistance)
+	{
+		const float Angle = FMath::RadiansToDegrees(FMath::Atan2(Right, Forward));
+		const float Sector = (Angle < 0.f ? Angle + 360.f : Angle) / 45.f;
+		OutBoundaryDistance = FMath::Abs(FMath::Frac(Sector) - 0.5f) * 45.f;
+
+		return (EClimbDirection)(FMath::RoundToInt(Sector) % 8);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbDirectionClassifyTest, "Second.Climbing.Direction.Classify",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FClimbDirectionClassifyTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbDirectionTests;
+
+	TestEqual(TEXT("No input is U"), (int32)ClimbDirection::Classify(0.f, 0.f), (int32)EClimbDirection::U);
+	TestEqual(TEXT("Forward is U"), (int32)ClimbDirection::Classify(1.f, 0.f), (int32)EClimbDirection::U);
+	TestEqual(TEXT("Forward right is UR"), (int32)ClimbDirection::Classify(1.f, 1.f), (int32)EClimbDirection::UR);
+	TestEqual(TEXT("Right is R"), (int32)ClimbDirection::Classify(0.f, 1.f), (int32)EClimbDirection::R);
+	TestEqual(TEXT("Back right is DR"), (int32)ClimbDirection::Classify(-1.f, 1.f), (int32)EClimbDirection::DR);
+	TestEqual(TEXT("Back is D"), (int32)ClimbDirection::Classify(-1.f, 0.f), (int32)EClimbDirection::D);
+	TestEqual(TEXT("Back left is DL"), (int32)ClimbDirection::Classify(-1.f, -1.f), (int32)EClimbDirection::DL);
+	TestEqual(TEXT("Left is L"), (int32)ClimbDirection::Classify(0.f, -1.f), (int32)EClimbDirection::L);
+	TestEqual(TEXT("Forward left is UL"), (int32)ClimbDirection::Classify(1.f, -1.f), (int32)EClimbDirection::UL);
+
+	// Every analog stick value on a 0.01 grid, except the ones too close to a sector boundary for float rounding
+	int32 NumMismatches = 0;
+	for (int32 ForwardStep = -100; ForwardStep <= 100; ++ForwardStep)
+	{
+		for (int32 RightStep = -100; RightStep <= 100; ++RightStep)
+		{
+			if (ForwardStep == 0 && RightStep == 0)
+			{
+				continue;
+			}
+
+			const float Forward = ForwardStep * 0.01f;
+			const float Right = RightStep * 0.01f;
+			float BoundaryDistance;
+			const EClimbDirection Expected = ReferenceClassify(Forward, Right, BoundaryDistance);
+			if (BoundaryDistance < 0.01f)
+			{
+				continue;
+			}
+
+			const EClimbDirection Direction = ClimbDirection::Classify(Forward, Right);
+			if (Direction != Expected && ++NumMismatches <= 10)
+			{
+				AddError(FString::Printf(TEXT("Classify(%.2f, %.2f) is %d, expected %d"), Forward, Right, (int32)Direction, (int32)Expected));
+			}
+		}
+	}
+	TestEqual(TEXT("Grid mismatches"), NumMismatches, 0);
+
+	// Half a degree either side of every boundary
+	for (int32 Boundary = 0; Boundary < 8; ++Boundary)
+	{
+		const float BoundaryAngle = 22.5f + Boundary * 45.f;
+		const float Angles[] = { BoundaryAngle - 0.5f, BoundaryAngle + 0.5f };
+		for (const float Angle : Angles)
+		{
+			const float Forward = FMath::Cos(FMath::DegreesToRadians(Angle));
+			const float Right = FMath::Sin(FMath::DegreesToRadians(Angle));
+			float BoundaryDistance;
+			const EClimbDirection Expected = ReferenceClassify(Forward, Right, BoundaryDistance);
+			TestEqual(FString::Printf(TEXT("Classify at %.1f degrees"), Angle), (int32)ClimbDirection::Classify(Forward, Right), (int32)Expected);
+		}
+	}
+
+	TestTrue(TEXT("UR is right"), ClimbDirection::IsRight(EClimbDirection::UR));
+	TestTrue(TEXT("DR is right"), ClimbDirection::IsRight(EClimbDirection::DR));
+	TestFalse(TEXT("U isn't right"), ClimbDirection::IsRight(EClimbDirection::U));
+	TestTrue(TEXT("UL is left"), ClimbDirection::IsLeft(EClimbDirection::UL));
+	TestTrue(TEXT("DL is left"), ClimbDirection::IsLeft(EClimbDirection::DL));
+	TestFalse(TEXT("D isn't left"), ClimbDirection::IsLeft(EClimbDirection::D));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbDirectionConeTest, "Second.Climbing.Direction.IsWithinCone",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FClimbDirectionConeTest::RunTest(const FString& Parameters)
+{
+	// Against acos of the normalized dot product, with lengths that aren't 1
+	const FVector A = FVector(3.f, 0.f, 0.f);
+	const float Thresholds[] = { ClimbDirection::CosThirty, ClimbDirection::CosFortyFive };
+	for (const float CosThreshold : Thresholds)
+	{
+		const float ThresholdAngle = FMath::RadiansToDegrees(FMath::Acos(CosThreshold));
+		for (int32 Angle = 0; Angle <= 180; ++Angle)
+		{
+			if (FMath::Abs(Angle - ThresholdAngle) < 0.01f)
+			{
+				continue;
+			}
+
+			const FVector B = FVector(FMath::Cos(FMath::DegreesToRadians((float)Angle)), 0.f, FMath::Sin(FMath::DegreesToRadians((float)Angle))) * 0.25f;
+			const bool bExpected = FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(A.GetSafeNormal(), B.GetSafeNormal()))) <= ThresholdAngle;
+			TestTrue(FString::Printf(TEXT("%d degrees within %.0f degrees"), Angle, ThresholdAngle), ClimbDirection::IsWithinCone(A, B, CosThreshold) == bExpected);
+		}
+	}
+
+	TestFalse(TEXT("Zero vector is within no cone"), ClimbDirection::IsWithinCone(A, FVector::ZeroVector, ClimbDirection::CosThirty));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbDirectionBenchmark, "Second.Climbing.Direction.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FClimbDirectionBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace ClimbDirectionTests;
+
+	// Inputs in an array so the loop doesn't fold, the sum keeps the results alive
+	TArray<FVector2D> Inputs;
+	Inputs.Reserve(201 * 201);
+	for (int32 ForwardStep = -100; ForwardStep <= 100; ++ForwardStep)
+	{
+		for (int32 RightStep = -100; RightStep <= 100; ++RightStep)
+		{
+			Inputs.Add(FVector2D(ForwardStep * 0.01f, RightStep * 0.01f));
+		}
+	}
+
+	const int32 NumRounds = 100;
+	const int32 NumCalls = NumRounds * Inputs.Num();
+
+	int32 Sum = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Round = 0; Round < NumRounds; ++Round)
+	{
+		for (const FVector2D& Input : Inputs)
+		{
+			Sum += (int32)ClimbDirection::Classify(Input.X, Input.Y);
+		}
+	}
+	const double ClassifyTime = FPlatformTime::Seconds() - StartTime;
+
+	int32 ReferenceSum = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Round = 0; Round < NumRounds; ++Round)
+	{
+		for (const FVector2D& Input : Inputs)
+		{
+			float BoundaryDistance;
+			ReferenceSum += (int32)ReferenceClassify(Input.X, Input.Y, BoundaryDistance);
+		}
+	}
+	const double ReferenceTime = FPlatformTime::Seconds() - StartTime;
+
+	AddInfo(FString::Printf(TEXT("Classify : %.2f ns per call, atan2 reference : %.2f ns per call (sums %d, %d)"),
+		ClassifyTime * 1e9 / NumCalls, ReferenceTime * 1e9 / NumCalls, Sum, ReferenceSum));
+
+	return true;
+}
+
+#endif
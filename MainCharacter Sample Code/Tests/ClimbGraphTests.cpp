@@ -0,0 +1,462 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbGraph.h"
+#include "ClimbGraphBuilder.h"
+#include "ClimbPathPlanner.h"
+#include "ClimbBenchmarkWorld.h"
+#include "ClimbNavigationSubsystem.h"
+#include "Main.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Math/RandomStream.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbGraphTests
+{
+	struct FTestEdge
+	{
+		int32 SourceNode;
+		int32 TargetNode;
+		float StaminaCost;
+		EClimbGraphEdgeType Type;
+	};
+
+	/**
+	 *  0 --(40)-- 1 --(40)-- 2      Climbing straight up 0 -> 1 -> 2 costs 80 stamina,
+	 *   \                   /       going around by 3 costs 20 over a longer way.
+	 *    (10)-- 3 --(10)---         4 is a ledge nothing leads to.
+	 */
+	static void BuildTestGraph(FClimbGraph& Graph)
+	{
+		const FVector Locations[] =
+		{
+			FVector(0.f, 0.f, 0.f),
+			FVector(0.f, 0.f, 300.f),
+			FVector(0.f, 0.f, 600.f),
+			FVector(0.f, 500.f, 300.f),
+			FVector(2000.f, 0.f, 0.f)
+		};
+		for (const FVector& Location : Locations)
+		{
+			const int32 NodeIndex = Graph.Nodes.Num();
+			FClimbGraphNode Node;
+			Node.Location = Location;
+			Node.FacingYaw = 0;
+			Node.Type = NodeIndex == 4 ? EClimbGraphNodeType::Ledge : EClimbGraphNodeType::Wall;
+			Node.Flags = NodeIndex == 0 ? ClimbGraphNodeFlag_Ground : 0;
+			Graph.Nodes.Add(Node);
+		}
+
+		// Sorted by source node, as the builder writes them
+		const FTestEdge TestEdges[] =
+		{
+			{ 0, 1, 40.f, EClimbGraphEdgeType::Climb },
+			{ 0, 3, 10.f, EClimbGraphEdgeType::Climb },
+			{ 1, 2, 40.f, EClimbGraphEdgeType::Climb },
+			{ 3, 2, 10.f, EClimbGraphEdgeType::ClimbDash }
+		};
+
+		Graph.EdgeOffsets.SetNumZeroed(Graph.Nodes.Num() + 1);
+		for (const FTestEdge& TestEdge : TestEdges)
+		{
+			FClimbGraphEdge Edge;
+			Edge.TargetNode = TestEdge.TargetNode;
+			Edge.StaminaCost = TestEdge.StaminaCost;
+			Edge.Length = FVector::Dist(Locations[TestEdge.SourceNode], Locations[TestEdge.TargetNode]);
+			Edge.Type = TestEdge.Type;
+			Graph.Edges.Add(Edge);
+			++Graph.EdgeOffsets[TestEdge.SourceNode + 1];
+		}
+		for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
+		{
+			Graph.EdgeOffsets[NodeIndex + 1] += Graph.EdgeOffsets[NodeIndex];
+		}
+
+		Graph.BuildLookups();
+	}
+
+	/**
+	 * Size x Size cm of ground nodes Spacing apart, walked between for no stamina. Every CliffEvery nodes along X
+	 * the ground steps up a 6 m cliff, climbing it drains ClimbCost and climbing down a quarter of it.
+	 */
+	static void BuildTerrainGraph(FClimbGraph& Graph, float Size, float Spacing, int32 CliffEvery, float ClimbCost)
+	{
+		const int32 NumSide = FMath::FloorToInt(Size / Spacing) + 1;
+		Graph.Nodes.Reserve(NumSide * NumSide);
+		Graph.Edges.Reserve(NumSide * NumSide * 4);
+		Graph.EdgeOffsets.Reserve(NumSide * NumSide + 1);
+
+		for (int32 X = 0; X < NumSide; ++X)
+		{
+			for (int32 Y = 0; Y < NumSide; ++Y)
+			{
+				FClimbGraphNode Node;
+				Node.Location = FVector(X * Spacing, Y * Spacing, (X / CliffEvery) * 600.f);
+				Node.FacingYaw = 0;
+				Node.Type = EClimbGraphNodeType::Wall;
+				Node.Flags = ClimbGraphNodeFlag_Ground;
+				Graph.Nodes.Add(Node);
+				Graph.EdgeOffsets.Add(Graph.Edges.Num());
+
+				const FIntPoint Neighbours[] = { FIntPoint(X - 1, Y), FIntPoint(X + 1, Y), FIntPoint(X, Y - 1), FIntPoint(X, Y + 1) };
+				for (const FIntPoint& Neighbour : Neighbours)
+				{
+					if (Neighbour.X < 0 || Neighbour.X >= NumSide || Neighbour.Y < 0 || Neighbour.Y >= NumSide)
+					{
+						continue;
+					}
+
+					const int32 Step = Neighbour.X / CliffEvery - X / CliffEvery;
+					FClimbGraphEdge Edge;
+					Edge.TargetNode = Neighbour.X * NumSide + Neighbour.Y;
+					Edge.StaminaCost = Step > 0 ? ClimbCost : (Step < 0 ? ClimbCost * 0.25f : 0.f);
+					Edge.Length = Spacing;
+					Edge.Type = Step > 0 ? EClimbGraphEdgeType::ClimbUp : (Step < 0 ? EClimbGraphEdgeType::ClimbDown : EClimbGraphEdgeType::Walk);
+					Graph.Edges.Add(Edge);
+				}
+			}
+		}
+		Graph.EdgeOffsets.Add(Graph.Edges.Num());
+
+		Graph.BuildLookups();
+	}
+
+	/** Random start and goal nodes of the terrain graph, at most MaxNodeDistance nodes apart on each axis */
+	static void MakeTerrainQueries(int32 NumSide, int32 MaxNodeDistance, int32 NumQueries, FRandomStream& Random, TArray<FIntPoint>& OutQueries)
+	{
+		OutQueries.Reset(NumQueries);
+		for (int32 Query = 0; Query < NumQueries; ++Query)
+		{
+			const int32 StartX = Random.RandRange(0, NumSide - 1);
+			const int32 StartY = Random.RandRange(0, NumSide - 1);
+			const int32 GoalX = FMath::Clamp(StartX + Random.RandRange(-MaxNodeDistance, MaxNodeDistance), 0, NumSide - 1);
+			const int32 GoalY = FMath::Clamp(StartY + Random.RandRange(-MaxNodeDistance, MaxNodeDistance), 0, NumSide - 1);
+			OutQueries.Add(FIntPoint(StartX * NumSide + StartY, GoalX * NumSide + GoalY));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbGraphSearchTest, "Second.Climbing.Graph.Search",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FClimbGraphSearchTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbGraphTests;
+
+	FClimbGraph Graph;
+	BuildTestGraph(Graph);
+	FClimbPathPlanner Planner(Graph);
+	FClimbPath Path;
+
+	// Least stamina wins over the shorter way
+	if (TestTrue(TEXT("Path 0 to 2 found"), Planner.FindPath(0, 2, Path)))
+	{
+		TestTrue(TEXT("Path goes around by 3"), Path.Nodes == TArray<int32>({ 0, 3, 2 }));
+		TestEqual(TEXT("Path stamina cost"), Path.StaminaCost, 20.f);
+		TestEqual(TEXT("Path edge count"), Path.EdgeTypes.Num(), 2);
+	}
+
+	TestTrue(TEXT("Path to the start node"), Planner.FindPath(1, 1, Path) && Path.Nodes.Num() == 1 && Path.StaminaCost == 0.f);
+	TestFalse(TEXT("Edges are one way"), Planner.FindPath(2, 0, Path));
+	TestFalse(TEXT("Unreachable node"), Planner.FindPath(0, 4, Path));
+	TestEqual(TEXT("Failed search leaves an empty path"), Path.Nodes.Num(), 0);
+	TestFalse(TEXT("Invalid node"), Planner.FindPath(0, 7, Path));
+
+	// The planner reuses its per node arrays, a second query must not see the first one's costs
+	TestTrue(TEXT("Repeated query"), Planner.FindPath(0, 2, Path) && Path.StaminaCost == 20.f);
+
+	// Snapping the world locations to nodes
+	TestEqual(TEXT("Nearest node"), Graph.FindNearestNode(FVector(20.f, 480.f, 320.f), 100.f), 3);
+	TestEqual(TEXT("Nearest node across cells"), Graph.FindNearestNode(FVector(0.f, 0.f, 390.f), 200.f), 1);
+	TestEqual(TEXT("No node within the distance"), Graph.FindNearestNode(FVector(1000.f, 0.f, 0.f), 100.f), (int32)INDEX_NONE);
+	TestTrue(TEXT("Path between world locations"), Planner.FindPath(FVector(0.f, 10.f, -10.f), FVector(0.f, 0.f, 610.f), 50.f, Path) && Path.Nodes.Num() == 3);
+
+	// Reverse edges, the incoming edges of 2 come from 1 and 3
+	TArray<int32> SourceNodes;
+	for (int32 EdgeIndex = Graph.GetFirstReverseEdge(2); EdgeIndex < Graph.GetLastReverseEdge(2); ++EdgeIndex)
+	{
+		SourceNodes.Add(Graph.ReverseEdges[EdgeIndex].TargetNode);
+	}
+	SourceNodes.Sort();
+	TestTrue(TEXT("Reverse edges of 2"), SourceNodes == TArray<int32>({ 1, 3 }));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbGraphSerializeTest, "Second.Climbing.Graph.Serialize",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FClimbGraphSerializeTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbGraphTests;
+
+	FClimbGraph Graph;
+	BuildTestGraph(Graph);
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Graph.Serialize(Writer);
+
+	FClimbGraph LoadedGraph;
+	FMemoryReader Reader(Bytes);
+	LoadedGraph.Serialize(Reader);
+	TestFalse(TEXT("Graph loads"), Reader.IsError());
+
+	TArray<uint8> LoadedBytes;
+	FMemoryWriter LoadedWriter(LoadedBytes);
+	LoadedGraph.Serialize(LoadedWriter);
+	TestTrue(TEXT("Loaded graph saves the same bytes"), Bytes == LoadedBytes);
+
+	// The lookups aren't saved, searching the loaded graph gives the same path
+	LoadedGraph.BuildLookups();
+	FClimbPathPlanner Planner(LoadedGraph);
+	FClimbPath Path;
+	TestTrue(TEXT("Loaded graph search"), Planner.FindPath(0, 2, Path) && Path.Nodes == TArray<int32>({ 0, 3, 2 }));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbGraphPathQueryBenchmark, "Second.Climbing.Graph.PathQueryBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FClimbGraphPathQueryBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace ClimbGraphTests;
+
+	// 4 km square, a node every 10 m and a cliff every 100 m : 160801 nodes
+	const float MapSize = 400000.f;
+	const float Spacing = 1000.f;
+	const int32 NumSide = FMath::FloorToInt(MapSize / Spacing) + 1;
+	TSharedRef<FClimbGraph, ESPMode::ThreadSafe> SharedGraph = MakeShared<FClimbGraph, ESPMode::ThreadSafe>();
+	BuildTerrainGraph(*SharedGraph, MapSize, Spacing, 10, 20.f);
+	const FClimbGraph& Graph = *SharedGraph;
+
+	// AI routes to a goal within 100 m, and routes anywhere on the map
+	FRandomStream Random(38);
+	TArray<FIntPoint> LocalQueries;
+	TArray<FIntPoint> MapQueries;
+	MakeTerrainQueries(NumSide, 10, 10000, Random, LocalQueries);
+	MakeTerrainQueries(NumSide, NumSide, 200, Random, MapQueries);
+
+	FClimbPathPlanner Planner(Graph);
+	FClimbPath Path;
+	const TPair<const TCHAR*, const TArray<FIntPoint>*> QuerySets[] = { { TEXT("within 100 m"), &LocalQueries }, { TEXT("across 4 km"), &MapQueries } };
+	for (const TPair<const TCHAR*, const TArray<FIntPoint>*>& QuerySet : QuerySets)
+	{
+		int32 NumFound = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (const FIntPoint& Query : *QuerySet.Value)
+		{
+			NumFound += Planner.FindPath(Query.X, Query.Y, Path) ? 1 : 0;
+		}
+		const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+		// Map wide routes may run past the planner's MaxExpandedNodes, those count as not found
+		if (QuerySet.Value == &LocalQueries)
+		{
+			TestTrue(TEXT("Local routes found"), NumFound > 0);
+		}
+		AddInfo(FString::Printf(TEXT("FindPath %s, %d nodes : %d of %d found, %.1f us per query, %.0f queries per second"),
+			QuerySet.Key, Graph.GetNumNodes(), NumFound, QuerySet.Value->Num(), ElapsedTime * 1e6 / QuerySet.Value->Num(), QuerySet.Value->Num() / ElapsedTime));
+	}
+
+	// Through the worker thread by world location, as UClimbNavigationSubsystem::RequestPath plans them
+	FClimbPathWorker Worker(SharedGraph);
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < LocalQueries.Num(); ++Index)
+	{
+		FClimbPathRequest Request;
+		Request.RequestId = Index;
+		Request.Start = Graph.Nodes[LocalQueries[Index].X].Location;
+		Request.Goal = Graph.Nodes[LocalQueries[Index].Y].Location;
+		Request.MaxSnapDistance = 100.f;
+		Worker.AddRequest(Request);
+	}
+
+	int32 NumResults = 0;
+	FClimbPathResult Result;
+	while (NumResults < LocalQueries.Num() && FPlatformTime::Seconds() - StartTime < 60.0)
+	{
+		if (Worker.GetResult(Result))
+		{
+			++NumResults;
+		}
+		else
+		{
+			FPlatformProcess::Sleep(0.f);
+		}
+	}
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("Every worker request answered"), NumResults, LocalQueries.Num());
+	AddInfo(FString::Printf(TEXT("Worker thread, within 100 m : %.0f queries per second"), NumResults / ElapsedTime));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbGraphBuildBenchmark, "Second.Climbing.Graph.BuildBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FClimbGraphBuildBenchmark::RunTest(const FString& Parameters)
+{
+	// 4 km square (16 km2) of ground with a 20 m block of 6 m cliffs every 100 m : 1600 blocks
+	const float MapSize = 400000.f;
+	const float BlockSpacing = 10000.f;
+	const int32 NumBlocks = FMath::FloorToInt(MapSize / BlockSpacing);
+
+	FClimbBenchmarkWorld BenchmarkWorld;
+	BenchmarkWorld.AddCube(FVector(MapSize * 0.5f, MapSize * 0.5f, -50.f), FVector(MapSize, MapSize, 100.f));
+	for (int32 X = 0; X < NumBlocks; ++X)
+	{
+		for (int32 Y = 0; Y < NumBlocks; ++Y)
+		{
+			BenchmarkWorld.AddCube(FVector((X + 0.5f) * BlockSpacing, (Y + 0.5f) * BlockSpacing, 300.f), FVector(2000.f, 2000.f, 600.f));
+		}
+	}
+
+	FClimbGraphBuildSettings Settings;
+	Settings.InitFromClimber(AMain::StaticClass());
+	FClimbGraphBuilder Builder(BenchmarkWorld.GetWorld(), Settings);
+
+	// Rows start above the ground so they don't run along its surface
+	TArray<FBox> BoundsList;
+	BoundsList.Add(FBox(FVector(0.f, 0.f, 50.f), FVector(MapSize, MapSize, 800.f)));
+
+	FClimbGraph Graph;
+	const double StartTime = FPlatformTime::Seconds();
+	Builder.Build(BoundsList, Graph);
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Graph.Serialize(Writer);
+
+	TestTrue(TEXT("Walls found"), Graph.GetNumNodes() > 0);
+	AddInfo(FString::Printf(TEXT("Build, 16 km2 with %d blocks : %d nodes, %d edges, %d KB, %.1f s"),
+		NumBlocks * NumBlocks, Graph.GetNumNodes(), Graph.Edges.Num(), Bytes.Num() / 1024, ElapsedTime));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbGraphStaminaFieldTest, "Second.Climbing.Graph.StaminaField",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FClimbGraphStaminaFieldTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbGraphTests;
+
+	FClimbGraph Graph;
+	BuildTestGraph(Graph);
+	FClimbPathPlanner Planner(Graph);
+
+	FClimbStaminaField Field;
+	Planner.BuildStaminaField(TArray<int32>({ 2 }), Graph.Nodes[2].Location, 100.f, 5000.f, Field);
+	TestEqual(TEXT("Target needs nothing"), Field.GetRequiredStamina(2), 0.f);
+	TestEqual(TEXT("1 needs its last stretch"), Field.GetRequiredStamina(1), 40.f);
+	TestEqual(TEXT("3 needs its last stretch"), Field.GetRequiredStamina(3), 10.f);
+	TestEqual(TEXT("Ground node 0 needs the cheaper way"), Field.GetRequiredStamina(0), 20.f);
+	TestTrue(TEXT("Unconnected node can't reach"), Field.GetRequiredStamina(4) < 0.f);
+
+	// A bar too small for the direct stretch leaves only the way around
+	Planner.BuildStaminaField(TArray<int32>({ 2 }), Graph.Nodes[2].Location, 30.f, 5000.f, Field);
+	TestTrue(TEXT("1 can't reach with 30 stamina"), Field.GetRequiredStamina(1) < 0.f);
+	TestEqual(TEXT("0 still reaches by 3"), Field.GetRequiredStamina(0), 20.f);
+
+	// Fields are cached by region, target type and stamina bar, any of them differing is another field
+	const FClimbStaminaFieldKey Key(FIntVector(1, 2, 3), EClimbGraphNodeType::Ledge, 20);
+	TSet<FClimbStaminaFieldKey> Keys;
+	Keys.Add(Key);
+	Keys.Add(FClimbStaminaFieldKey(FIntVector(1, 2, 4), EClimbGraphNodeType::Ledge, 20));
+	Keys.Add(FClimbStaminaFieldKey(FIntVector(1, 2, 3), EClimbGraphNodeType::Wall, 20));
+	Keys.Add(FClimbStaminaFieldKey(FIntVector(1, 2, 3), EClimbGraphNodeType::Ledge, 21));
+	Keys.Add(FClimbStaminaFieldKey(FIntVector(1, 2, 3), EClimbGraphNodeType::Ledge, 20));
+	TestEqual(TEXT("Distinct field keys"), Keys.Num(), 4);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbGraphStaminaQueryBenchmark, "Second.Climbing.Graph.StaminaQueryBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FClimbGraphStaminaQueryBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace ClimbGraphTests;
+
+	// 100 m square, a node every metre and a cliff every 10 m : 10201 nodes
+	FClimbGraph Graph;
+	BuildTerrainGraph(Graph, 10000.f, 100.f, 10, 20.f);
+	FClimbPathPlanner Planner(Graph);
+
+	const UClimbNavigationSubsystem* Settings = GetDefault<UClimbNavigationSubsystem>();
+	const float MaxStamina = 100.f;
+	FRandomStream Random(39);
+
+	// A field per target region, built once on the worker by UClimbNavigationSubsystem
+	const int32 NumFields = 20;
+	TMap<FClimbStaminaFieldKey, TSharedPtr<FClimbStaminaField, ESPMode::ThreadSafe>> StaminaFields;
+	TArray<FVector> TargetLocations;
+	double BuildTime = 0.0;
+	for (int32 Index = 0; Index < NumFields; ++Index)
+	{
+		const FVector TargetLocation = Graph.Nodes[Random.RandRange(0, Graph.GetNumNodes() - 1)].Location;
+		const FIntVector Region(
+			FMath::FloorToInt(TargetLocation.X / Settings->StaminaRegionSize),
+			FMath::FloorToInt(TargetLocation.Y / Settings->StaminaRegionSize),
+			FMath::FloorToInt(TargetLocation.Z / Settings->StaminaRegionSize));
+		const FClimbStaminaFieldKey Key(Region, EClimbGraphNodeType::Wall, FMath::FloorToInt(MaxStamina / Settings->StaminaBucketSize));
+
+		const FBox RegionBox(FVector(Region) * Settings->StaminaRegionSize, FVector(Region + FIntVector(1, 1, 1)) * Settings->StaminaRegionSize);
+		TArray<int32> TargetNodes;
+		Graph.FindNodesInBox(RegionBox, EClimbGraphNodeType::Wall, TargetNodes);
+
+		TSharedPtr<FClimbStaminaField, ESPMode::ThreadSafe> Field = MakeShared<FClimbStaminaField, ESPMode::ThreadSafe>();
+		const double StartTime = FPlatformTime::Seconds();
+		Planner.BuildStaminaField(TargetNodes, RegionBox.GetCenter(), MaxStamina, Settings->StaminaFieldRadius, *Field);
+		BuildTime += FPlatformTime::Seconds() - StartTime;
+
+		Field->Key = Key;
+		StaminaFields.Add(Key, Field);
+		TargetLocations.Add(TargetLocation);
+	}
+	AddInfo(FString::Printf(TEXT("BuildStaminaField, %.0f m radius : %.1f us per field"), Settings->StaminaFieldRadius / 100.f, BuildTime * 1e6 / NumFields));
+
+	// A cached query as QueryRequiredStamina answers it, two node lookups and two map finds
+	const int32 NumQueries = 100000;
+	int32 NumReachable = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Query = 0; Query < NumQueries; ++Query)
+	{
+		const FVector& TargetLocation = TargetLocations[Query % NumFields];
+		const FVector Start = Graph.Nodes[Random.RandRange(0, Graph.GetNumNodes() - 1)].Location;
+
+		const int32 TargetNode = Graph.FindNearestNode(TargetLocation, Settings->MaxSnapDistance);
+		const int32 StartNode = Graph.FindNearestNode(Start, Settings->MaxSnapDistance);
+		if (TargetNode == INDEX_NONE || StartNode == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FVector TargetNodeLocation = Graph.Nodes[TargetNode].Location;
+		const FIntVector Region(
+			FMath::FloorToInt(TargetNodeLocation.X / Settings->StaminaRegionSize),
+			FMath::FloorToInt(TargetNodeLocation.Y / Settings->StaminaRegionSize),
+			FMath::FloorToInt(TargetNodeLocation.Z / Settings->StaminaRegionSize));
+		const FClimbStaminaFieldKey Key(Region, Graph.Nodes[TargetNode].Type, FMath::FloorToInt(MaxStamina / Settings->StaminaBucketSize));
+		if (const TSharedPtr<FClimbStaminaField, ESPMode::ThreadSafe>* Field = StaminaFields.Find(Key))
+		{
+			NumReachable += (*Field)->GetRequiredStamina(StartNode) >= 0.f ? 1 : 0;
+		}
+	}
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	TestTrue(TEXT("Cached queries reach their targets"), NumReachable > 0);
+	AddInfo(FString::Printf(TEXT("Cached stamina query : %.3f us per query, %d of %d reachable"), ElapsedTime * 1e6 / NumQueries, NumReachable, NumQueries));
+
+	return true;
+}
+
+#endif
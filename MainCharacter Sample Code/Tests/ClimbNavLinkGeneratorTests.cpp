@@ -0,0 +1,190 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbNavLinkGenerator.h"
+#include "ClimbGraph.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Async/ParallelFor.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbNavLinkGeneratorTests
+{
+	static void AddNode(FClimbGraph& Graph, const FVector& Location, EClimbGraphNodeType Type, uint8 Flags)
+	{
+		FClimbGraphNode Node;
+		Node.Location = Location;
+		Node.FacingYaw = 0;
+		Node.Type = Type;
+		Node.Flags = Flags;
+		Graph.Nodes.Add(Node);
+	}
+
+	static void AddEdge(FClimbGraph& Graph, int32 TargetNode, float StaminaCost, EClimbGraphEdgeType Type)
+	{
+		FClimbGraphEdge Edge;
+		Edge.TargetNode = TargetNode;
+		Edge.StaminaCost = StaminaCost;
+		Edge.Length = 100.f;
+		Edge.Type = Type;
+		Graph.Edges.Add(Edge);
+	}
+
+	/**
+	 * NumCliffs cliffs of Height, CliffSpacing apart along Y, each with NumLedges ledges LedgeSpacing apart along X.
+	 * A ledge climbs down to a wall of three patches, the lowest one with ground below.
+	 */
+	static void BuildCliffGraph(FClimbGraph& Graph, int32 NumCliffs, int32 NumLedges, float CliffSpacing, float LedgeSpacing, float Height)
+	{
+		Graph.Nodes.Reserve(NumCliffs * NumLedges * 4);
+		Graph.Edges.Reserve(NumCliffs * NumLedges * 3);
+		Graph.EdgeOffsets.Reserve(NumCliffs * NumLedges * 4 + 1);
+
+		for (int32 Cliff = 0; Cliff < NumCliffs; ++Cliff)
+		{
+			for (int32 Ledge = 0; Ledge < NumLedges; ++Ledge)
+			{
+				const int32 LedgeNode = Graph.Nodes.Num();
+				const FVector LedgeLocation(Ledge * LedgeSpacing, Cliff * CliffSpacing, Height);
+
+				AddNode(Graph, LedgeLocation, EClimbGraphNodeType::Ledge, 0);
+				Graph.EdgeOffsets.Add(Graph.Edges.Num());
+				AddEdge(Graph, LedgeNode + 1, 5.f, EClimbGraphEdgeType::ClimbDown);
+
+				for (int32 Patch = 1; Patch <= 3; ++Patch)
+				{
+					AddNode(Graph, LedgeLocation - FVector(0.f, 50.f, Height * Patch / 3.f), EClimbGraphNodeType::Wall, Patch == 3 ? ClimbGraphNodeFlag_Ground : 0);
+					Graph.EdgeOffsets.Add(Graph.Edges.Num());
+					if (Patch < 3)
+					{
+						AddEdge(Graph, LedgeNode + Patch + 1, 10.f, EClimbGraphEdgeType::Climb);
+					}
+				}
+			}
+		}
+		Graph.EdgeOffsets.Add(Graph.Edges.Num());
+	}
+
+	static FClimbNavLinkSettings MakeSettings()
+	{
+		FClimbNavLinkSettings Settings;
+		Settings.LinkSpacing = 200.f;
+		Settings.SnapHeight = 150.f;
+		Settings.MaxClimbStamina = 100.f;
+		Settings.MaxClimbNodes = 256;
+		return Settings;
+	}
+
+	static double GenerateTiles(const FClimbGraph& Graph, float TileSize, const TSet<FIntPoint>& Tiles, int32& OutNumTiles, int32& OutNumLinks)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		TMap<FIntPoint, TArray<int32>> TileLedges;
+		AClimbNavLinkGenerator::BucketLedgesByTile(Graph, TileSize, Tiles, TileLedges);
+
+		TArray<FIntPoint> TileCoords;
+		TileLedges.GenerateKeyArray(TileCoords);
+
+		const FClimbNavLinkSettings Settings = MakeSettings();
+		TArray<FClimbNavLinkTileResult> Results;
+		Results.SetNum(TileCoords.Num());
+		ParallelFor(TileCoords.Num(), [&](int32 Index)
+			{
+				Results[Index].TileCoord = TileCoords[Index];
+				AClimbNavLinkGenerator::GenerateTileLinks(Graph, TileLedges[TileCoords[Index]], Settings, Results[Index]);
+			});
+
+		const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+		OutNumTiles = Results.Num();
+		OutNumLinks = 0;
+		for (const FClimbNavLinkTileResult& Result : Results)
+		{
+			OutNumLinks += Result.Links.Num();
+		}
+
+		return ElapsedTime;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbNavLinkTileTest, "Second.Climbing.NavLinks.TileLinks",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FClimbNavLinkTileTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbNavLinkGeneratorTests;
+
+	// 5 ledges 100 apart along one cliff : within a 200 spacing cell only one ledge links
+	FClimbGraph Graph;
+	BuildCliffGraph(Graph, 1, 5, 2000.f, 100.f, 600.f);
+	Graph.BuildLookups();
+
+	TMap<FIntPoint, TArray<int32>> TileLedges;
+	AClimbNavLinkGenerator::BucketLedgesByTile(Graph, 1000.f, TSet<FIntPoint>(), TileLedges);
+	TestEqual(TEXT("Tiles with ledges"), TileLedges.Num(), 1);
+
+	FClimbNavLinkTileResult Result;
+	AClimbNavLinkGenerator::GenerateTileLinks(Graph, TileLedges.FindChecked(FIntPoint(0, 0)), MakeSettings(), Result);
+	TestEqual(TEXT("A climb up and a climb down link per spacing cell"), Result.Links.Num(), 6);
+	TestEqual(TEXT("Link types per link"), Result.LinkTypes.Num(), Result.Links.Num());
+	if (Result.LinkTypes.Num() >= 2)
+	{
+		TestTrue(TEXT("Climb up then climb down"), Result.LinkTypes[0] == EClimbNavLinkType::ClimbUp && Result.LinkTypes[1] == EClimbNavLinkType::ClimbDown);
+		TestTrue(TEXT("Climb up ends on the ledge"), Result.Links[0].Right.Equals(Graph.Nodes[0].Location));
+	}
+
+	// Same ledges, same links
+	FClimbNavLinkTileResult SameResult;
+	AClimbNavLinkGenerator::GenerateTileLinks(Graph, TileLedges.FindChecked(FIntPoint(0, 0)), MakeSettings(), SameResult);
+	TestTrue(TEXT("Links hash is stable"), SameResult.LinksHash == Result.LinksHash);
+
+	// A climb draining more than the stamina bar isn't linked
+	FClimbNavLinkSettings LowStaminaSettings = MakeSettings();
+	LowStaminaSettings.MaxClimbStamina = 10.f;
+	AClimbNavLinkGenerator::GenerateTileLinks(Graph, TileLedges.FindChecked(FIntPoint(0, 0)), LowStaminaSettings, Result);
+	TestEqual(TEXT("No links beyond the stamina bar"), Result.Links.Num(), 0);
+
+	// Only the dirty tiles are bucketed
+	TSet<FIntPoint> DirtyTiles;
+	DirtyTiles.Add(FIntPoint(0, 3));
+	AClimbNavLinkGenerator::BucketLedgesByTile(Graph, 1000.f, DirtyTiles, TileLedges);
+	TestEqual(TEXT("Dirty tile without ledges"), TileLedges.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbNavLinkBenchmark, "Second.Climbing.NavLinks.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FClimbNavLinkBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace ClimbNavLinkGeneratorTests;
+
+	// 4 km square, a cliff every 20 m with a ledge every 4 m : 200000 ledges, 800000 nodes
+	const float TileSize = 1000.f;
+	FClimbGraph Graph;
+	BuildCliffGraph(Graph, 200, 1000, 2000.f, 400.f, 600.f);
+	Graph.BuildLookups();
+
+	int32 NumTiles = 0;
+	int32 NumLinks = 0;
+	const double FullTime = GenerateTiles(Graph, TileSize, TSet<FIntPoint>(), NumTiles, NumLinks);
+	TestTrue(TEXT("Every ledge is linked"), NumLinks == 2 * 200000);
+	AddInfo(FString::Printf(TEXT("Full generation, 4 km : %d links in %d tiles, %.1f ms"), NumLinks, NumTiles, FullTime * 1000.0));
+
+	// What a dirty area of one tile regenerates, the tile and its neighbours
+	TSet<FIntPoint> DirtyTiles;
+	for (int32 X = 199; X <= 201; ++X)
+	{
+		for (int32 Y = 199; Y <= 201; ++Y)
+		{
+			DirtyTiles.Add(FIntPoint(X, Y));
+		}
+	}
+	const double DirtyTime = GenerateTiles(Graph, TileSize, DirtyTiles, NumTiles, NumLinks);
+	AddInfo(FString::Printf(TEXT("Dirty tile regeneration, 4 km : %d links in %d tiles, %.2f ms"), NumLinks, NumTiles, DirtyTime * 1000.0));
+
+	return true;
+}
+
+#endif
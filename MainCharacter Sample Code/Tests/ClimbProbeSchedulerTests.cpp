@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbProbeSchedulerSubsystem.h"
+#include "ClimbBenchmarkWorld.h"
+#include "Main.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbProbeSchedulerTests
+{
+	static const int32 CrowdSize = 10;
+	static const float CrowdSpacing = 600.f;
+
+	/**
+	 * CrowdSize x CrowdSize characters walking into a 6 m wall block each, all at once, so they start climbing,
+	 * reach the top edge and climb up in the same frames. Returns the game thread frame times after a warm up
+	 */
+	static void RunCrowd(int32 TraceBudgetPerFrame, int32 NumFrames, TArray<double>& OutFrameTimes)
+	{
+		FClimbBenchmarkWorld BenchmarkWorld;
+		BenchmarkWorld.GetWorld()->GetSubsystem<UClimbProbeSchedulerSubsystem>()->TraceBudgetPerFrame = TraceBudgetPerFrame;
+
+		const float CrowdExtent = CrowdSize * CrowdSpacing;
+		BenchmarkWorld.AddCube(FVector(CrowdExtent * 0.5f, CrowdExtent * 0.5f, -50.f), FVector(CrowdExtent + 2000.f, CrowdExtent + 2000.f, 100.f));
+
+		TArray<AMain*> Crowd;
+		for (int32 X = 0; X < CrowdSize; ++X)
+		{
+			for (int32 Y = 0; Y < CrowdSize; ++Y)
+			{
+				const FVector Location(X * CrowdSpacing, Y * CrowdSpacing, 100.f);
+				BenchmarkWorld.AddCube(Location + FVector(200.f, 0.f, 200.f), FVector(100.f, 300.f, 600.f));
+				if (AMain* Main = Cast<AMain>(BenchmarkWorld.SpawnCharacter(Location, FRotator::ZeroRotator)))
+				{
+					Crowd.Add(Main);
+				}
+			}
+		}
+
+		// Full probes for everyone, only the scheduler's budget limits them. Up the wall, over the top
+		auto BeforeTick = [&Crowd]()
+		{
+			for (AMain* Main : Crowd)
+			{
+				Main->GetClimbingComponent()->SetClimbLOD(EClimbLOD::ECL_Full);
+				Main->MoveForward(1.f);
+			}
+		};
+
+		TArray<double> WarmUpFrameTimes;
+		BenchmarkWorld.Tick(30, 1.f / 60.f, WarmUpFrameTimes, BeforeTick);
+		BenchmarkWorld.Tick(NumFrames, 1.f / 60.f, OutFrameTimes, BeforeTick);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbProbeSchedulerDeferTest, "Second.Climbing.ProbeScheduler.Defer",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FClimbProbeSchedulerDeferTest::RunTest(const FString& Parameters)
+{
+	FClimbBenchmarkWorld BenchmarkWorld;
+	UClimbProbeSchedulerSubsystem* ProbeScheduler = BenchmarkWorld.GetWorld()->GetSubsystem<UClimbProbeSchedulerSubsystem>();
+	if (!TestNotNull(TEXT("Probe scheduler"), ProbeScheduler))
+	{
+		return false;
+	}
+
+	// Room for two ledge probes a frame
+	ProbeScheduler->TraceBudgetPerFrame = 2 * UClimbProbeSchedulerSubsystem::GetProbeTraceCost(EClimbProbeType::ECP_GrabFromTop);
+	ProbeScheduler->Tick(0.f);
+
+	UClimbingComponent* Climbings[3];
+	for (int32 Index = 0; Index < 3; ++Index)
+	{
+		AMain* Main = Cast<AMain>(BenchmarkWorld.SpawnCharacter(FVector(Index * 200.f, 0.f, 100.f), FRotator::ZeroRotator));
+		if (!TestNotNull(TEXT("Character spawned"), Main))
+		{
+			return false;
+		}
+		Climbings[Index] = Main->GetClimbingComponent();
+	}
+
+	TestTrue(TEXT("First ledge probe runs"), ProbeScheduler->RequestProbe(Climbings[0], EClimbProbeType::ECP_GrabFromTop));
+	TestTrue(TEXT("Second ledge probe runs"), ProbeScheduler->RequestProbe(Climbings[1], EClimbProbeType::ECP_GrabFromTop));
+	TestFalse(TEXT("Third ledge probe is deferred"), ProbeScheduler->RequestProbe(Climbings[2], EClimbProbeType::ECP_GrabFromTop));
+	TestTrue(TEXT("Deferred probe is stale"), Climbings[2]->IsClimbProbeStale(EClimbProbeType::ECP_GrabFromTop));
+	TestTrue(TEXT("Maintain probes run over the budget"), ProbeScheduler->RequestProbe(Climbings[2], EClimbProbeType::ECP_Maintain));
+
+	// The deferred probe is granted first next frame, before this frame's demand
+	ProbeScheduler->Tick(1.f / 60.f);
+	TestTrue(TEXT("Deferred probe granted next frame"), ProbeScheduler->RequestProbe(Climbings[2], EClimbProbeType::ECP_GrabFromTop));
+	TestFalse(TEXT("Granted probe is fresh"), Climbings[2]->IsClimbProbeStale(EClimbProbeType::ECP_GrabFromTop));
+
+	// Behind the budget the maintain probe used last frame, then granted without being asked for again
+	TestFalse(TEXT("Ledge probe deferred behind the maintain reserve"), ProbeScheduler->RequestProbe(Climbings[0], EClimbProbeType::ECP_GrabFromTop));
+	ProbeScheduler->Tick(1.f / 60.f);
+	TestTrue(TEXT("Deferred probe granted"), (Climbings[0]->ClimbProbeGrantMask & (1 << (uint8)EClimbProbeType::ECP_GrabFromTop)) != 0);
+	ProbeScheduler->Tick(1.f / 60.f);
+	TestTrue(TEXT("Unused grant dropped"), Climbings[0]->ClimbProbeGrantMask == 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbProbeSchedulerCrowdBenchmark, "Second.Climbing.ProbeScheduler.CrowdBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FClimbProbeSchedulerCrowdBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace ClimbProbeSchedulerTests;
+
+	// 10 seconds at 60 Hz, the crowd reaches the walls, climbs and tops out within it
+	const int32 NumFrames = 600;
+
+	// Before : every probe runs when asked, as without the scheduler
+	TArray<double> UnbudgetedFrameTimes;
+	RunCrowd(MAX_int32 / 2, NumFrames, UnbudgetedFrameTimes);
+	AddInfo(FString::Printf(TEXT("%d characters, no trace budget : %s"), CrowdSize * CrowdSize, *FClimbBenchmarkWorld::FormatFrameTimes(UnbudgetedFrameTimes)));
+
+	// After : the default budget spreads the probes that come due in the same frame
+	TArray<double> BudgetedFrameTimes;
+	const int32 TraceBudgetPerFrame = GetDefault<UClimbProbeSchedulerSubsystem>()->TraceBudgetPerFrame;
+	RunCrowd(TraceBudgetPerFrame, NumFrames, BudgetedFrameTimes);
+	AddInfo(FString::Printf(TEXT("%d characters, %d traces per frame : %s"), CrowdSize * CrowdSize, TraceBudgetPerFrame, *FClimbBenchmarkWorld::FormatFrameTimes(BudgetedFrameTimes)));
+
+	const double UnbudgetedP99 = FClimbBenchmarkWorld::GetPercentile(UnbudgetedFrameTimes, 0.99f);
+	const double BudgetedP99 = FClimbBenchmarkWorld::GetPercentile(BudgetedFrameTimes, 0.99f);
+	AddInfo(FString::Printf(TEXT("p99 frame time %.2f ms -> %.2f ms (%+.1f%%)"), UnbudgetedP99, BudgetedP99, UnbudgetedP99 > 0.0 ? (BudgetedP99 / UnbudgetedP99 - 1.0) * 100.0 : 0.0));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,183 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbingComponent.h"
+#include "ClimbBenchmarkWorld.h"
+#include "Main.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbSurfaceTests
+{
+	/** Distance of the character from the rock surface when it grabs on */
+	static const float GrabDistance = 40.f;
+
+	/** Direction from a sphere's center, Latitude -90 is the bottom of the rock and 0 its equator */
+	static FVector GetSphereDirection(float Latitude, float Longitude)
+	{
+		return FRotator(Latitude, Longitude, 0.f).Vector();
+	}
+
+	/**
+	 * Puts a character next to the rock at Direction from its center facing it, turned away by YawError,
+	 * and starts climbing there as StartClimbAtNormalStatusCondition does once the probes found the wall
+	 */
+	static AMain* StartClimbOnSphere(FClimbBenchmarkWorld& BenchmarkWorld, const FVector& Center, float Radius, const FVector& Direction, float YawError)
+	{
+		const FVector Facing = (-Direction).RotateAngleAxis(YawError, FVector::UpVector);
+		AMain* Main = Cast<AMain>(BenchmarkWorld.SpawnCharacter(Center + Direction * (Radius + GrabDistance), Facing.Rotation()));
+		if (Main == nullptr)
+		{
+			return nullptr;
+		}
+
+		UClimbingComponent* Climbing = Main->GetClimbingComponent();
+		Climbing->UpdateClimbFrame();
+		Climbing->SetIsBodyWallFacingAndNormalVector();
+		if (Climbing->bIsBodyWallFacing)
+		{
+			Climbing->StartClimb();
+		}
+		return Main;
+	}
+
+	/** Cosine of the angle between the character's facing and into the rock where it holds on */
+	static float GetSphereAlignment(AMain* Main, const FVector& Center)
+	{
+		const FVector TrueNormal = (Main->GetClimbingComponent()->BodyWallContactPoint - Center).GetSafeNormal();
+		return FVector::DotProduct(Main->GetActorForwardVector(), -TrueNormal);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbSurfaceCurvedRockAlignmentTest, "Second.Climbing.Surface.CurvedRockAlignment",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FClimbSurfaceCurvedRockAlignmentTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbSurfaceTests;
+
+	FClimbBenchmarkWorld BenchmarkWorld;
+	const FVector Center(0.f, 0.f, 2000.f);
+	const float Radius = 400.f;
+	BenchmarkWorld.AddSphere(Center, Radius);
+
+	// Slopes, the vertical equator, overhangs below it and the ceiling under the rock
+	const float Latitudes[] = { 60.f, 30.f, 0.f, -30.f, -60.f, -90.f };
+	const float Longitudes[] = { 0.f, 135.f, 250.f };
+	for (float Latitude : Latitudes)
+	{
+		for (float Longitude : Longitudes)
+		{
+			const FVector Direction = GetSphereDirection(Latitude, Longitude);
+			AMain* Main = StartClimbOnSphere(BenchmarkWorld, Center, Radius, Direction, 15.f);
+			if (!TestNotNull(TEXT("Character spawned"), Main))
+			{
+				return false;
+			}
+
+			const FString Where = FString::Printf(TEXT("latitude %.0f longitude %.0f"), Latitude, Longitude);
+			UClimbingComponent* Climbing = Main->GetClimbingComponent();
+			if (!TestTrue(FString::Printf(TEXT("Rock found at %s"), *Where), Climbing->bIsBodyWallFacing))
+			{
+				continue;
+			}
+
+			const FVector TrueNormal = (Climbing->BodyWallContactPoint - Center).GetSafeNormal();
+			TestTrue(FString::Printf(TEXT("Probed normal is the rock's at %s"), *Where), FVector::DotProduct(Climbing->NormalVectorBodyWallFacing, TrueNormal) > 0.999f);
+			TestTrue(FString::Printf(TEXT("Climbing at %s"), *Where), Climbing->GetMovementStatus() == EMovementStatus::EMS_Climbing);
+			TestTrue(FString::Printf(TEXT("Facing into the rock at %s"), *Where), GetSphereAlignment(Main, Center) > FMath::Cos(FMath::DegreesToRadians(5.f)));
+
+			// Up the rock where it has an up, the ceiling under it keeps the character's
+			if (Latitude > -90.f)
+			{
+				TestTrue(FString::Printf(TEXT("Head towards the top at %s"), *Where), Main->GetActorUpVector().Z > 0.f);
+			}
+
+			Main->Destroy();
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbSurfaceCurvedRockBenchmark, "Second.Climbing.Surface.CurvedRockBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FClimbSurfaceCurvedRockBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace ClimbSurfaceTests;
+
+	const int32 CrowdSize = 10;
+	const float Spacing = 1500.f;
+	const float Radius = 400.f;
+	const int32 NumFrames = 600;
+
+	// Flat vertical walls, then curved rocks the frame turns with on every step
+	for (int32 bCurvedRock = 0; bCurvedRock < 2; ++bCurvedRock)
+	{
+		FClimbBenchmarkWorld BenchmarkWorld;
+
+		TArray<AMain*> Crowd;
+		TArray<FVector> Centers;
+		for (int32 X = 0; X < CrowdSize; ++X)
+		{
+			for (int32 Y = 0; Y < CrowdSize; ++Y)
+			{
+				const FVector Center(X * Spacing, Y * Spacing, 2000.f);
+				if (bCurvedRock)
+				{
+					BenchmarkWorld.AddSphere(Center, Radius);
+				}
+				else
+				{
+					BenchmarkWorld.AddCube(Center, FVector(Radius * 2.f));
+				}
+
+				// Below the equator of the rock, on its overhang
+				const float Latitude = bCurvedRock ? -30.f : 0.f;
+				if (AMain* Main = StartClimbOnSphere(BenchmarkWorld, Center, Radius, GetSphereDirection(Latitude, 180.f), 0.f))
+				{
+					Crowd.Add(Main);
+					Centers.Add(Center);
+				}
+			}
+		}
+
+		// Around the rock and up it
+		auto BeforeTick = [&Crowd]()
+		{
+			for (AMain* Main : Crowd)
+			{
+				Main->GetClimbingComponent()->SetClimbLOD(EClimbLOD::ECL_Full);
+				Main->MoveForward(0.5f);
+				Main->MoveRight(1.f);
+			}
+		};
+
+		TArray<double> FrameTimes;
+		BenchmarkWorld.Tick(NumFrames, 1.f / 60.f, FrameTimes, BeforeTick);
+
+		int32 NumAligned = 0;
+		int32 NumClimbing = 0;
+		for (int32 Index = 0; Index < Crowd.Num(); ++Index)
+		{
+			UClimbingComponent* Climbing = Crowd[Index]->GetClimbingComponent();
+			if (Climbing->GetMovementStatus() == EMovementStatus::EMS_Climbing && Climbing->bIsBodyWallFacing)
+			{
+				++NumClimbing;
+				const float Alignment = bCurvedRock
+					? GetSphereAlignment(Crowd[Index], Centers[Index])
+					: FVector::DotProduct(Crowd[Index]->GetActorForwardVector(), -Climbing->NormalVectorBodyWallFacing);
+				NumAligned += Alignment > FMath::Cos(FMath::DegreesToRadians(10.f)) ? 1 : 0;
+			}
+		}
+
+		AddInfo(FString::Printf(TEXT("%d characters on %s : %s, %d still climbing, %d within 10 degrees of the surface"),
+			Crowd.Num(), bCurvedRock ? TEXT("curved rocks") : TEXT("flat walls"), *FClimbBenchmarkWorld::FormatFrameTimes(FrameTimes), NumClimbing, NumAligned));
+	}
+
+	return true;
+}
+
+#endif
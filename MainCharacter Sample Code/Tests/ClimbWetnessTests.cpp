@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbWetnessSubsystem.h"
+#include "ClimbBenchmarkWorld.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbWetnessTests
+{
+	/** 4 km square, 16 km2 */
+	static const float MapSize = 400000.f;
+
+	/**
+	 * Starts a map wide storm and times every wetness tick until the grid has taken it in,
+	 * with MaxCellUpdatesPerTick cells updated a tick. Returns the tick times in ms
+	 */
+	static void RunStorm(int32 MaxCellUpdatesPerTick, TArray<double>& OutTickTimes, int32& OutNumCells)
+	{
+		FClimbBenchmarkWorld BenchmarkWorld;
+		UClimbWetnessSubsystem* Wetness = BenchmarkWorld.GetWorld()->GetSubsystem<UClimbWetnessSubsystem>();
+		Wetness->MaxCellUpdatesPerTick = MaxCellUpdatesPerTick;
+
+		// One weather volume over the whole map and a heavier shower over each square km
+		const FBox MapBounds(FVector(0.f, 0.f, -10000.f), FVector(MapSize, MapSize, 100000.f));
+		const int32 StormVolume = Wetness->RegisterVolume(MapBounds, 1.f / 60.f, false);
+		for (int32 X = 0; X < 4; ++X)
+		{
+			for (int32 Y = 0; Y < 4; ++Y)
+			{
+				const FVector Min(X * 100000.f, Y * 100000.f, -10000.f);
+				Wetness->RegisterVolume(FBox(Min, Min + FVector(100000.f, 100000.f, 110000.f)), 1.f / 30.f, false);
+			}
+		}
+
+		const FIntPoint MinCell = Wetness->GetCellCoord(MapBounds.Min);
+		const FIntPoint MaxCell = Wetness->GetCellCoord(MapBounds.Max);
+		OutNumCells = (MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
+
+		Wetness->SetVolumeRaining(StormVolume, true);
+		const int32 NumTicks = FMath::DivideAndRoundUp(OutNumCells, MaxCellUpdatesPerTick);
+		OutTickTimes.Reserve(NumTicks);
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Wetness->Tick(1.f / 60.f);
+			OutTickTimes.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbWetnessGridBenchmark, "Second.Climbing.Wetness.GridBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FClimbWetnessGridBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace ClimbWetnessTests;
+
+	int32 NumCells = 0;
+
+	// Before : every cell of the storm updated in the frame it starts
+	TArray<double> SingleTickTimes;
+	RunStorm(MAX_int32, SingleTickTimes, NumCells);
+	AddInfo(FString::Printf(TEXT("16 km2, %d cells in one tick : %.2f ms"), NumCells, FClimbBenchmarkWorld::GetPercentile(SingleTickTimes, 1.f)));
+
+	// After : the default budget amortized over frames
+	TArray<double> AmortizedTickTimes;
+	const int32 MaxCellUpdatesPerTick = GetDefault<UClimbWetnessSubsystem>()->MaxCellUpdatesPerTick;
+	RunStorm(MaxCellUpdatesPerTick, AmortizedTickTimes, NumCells);
+	AddInfo(FString::Printf(TEXT("16 km2, %d cells a tick : %d ticks, %s"), MaxCellUpdatesPerTick, AmortizedTickTimes.Num(), *FClimbBenchmarkWorld::FormatFrameTimes(AmortizedTickTimes)));
+
+	// The climbing tick samples once per character
+	FClimbBenchmarkWorld BenchmarkWorld;
+	UClimbWetnessSubsystem* Wetness = BenchmarkWorld.GetWorld()->GetSubsystem<UClimbWetnessSubsystem>();
+	Wetness->MaxCellUpdatesPerTick = MAX_int32;
+	Wetness->RegisterVolume(FBox(FVector(0.f, 0.f, -10000.f), FVector(MapSize, MapSize, 100000.f)), 1.f / 60.f, true);
+	Wetness->Tick(1.f / 60.f);
+
+	const int32 NumSamples = 1000000;
+	FRandomStream Random(44);
+	float WetnessSum = 0.f;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+	{
+		WetnessSum += Wetness->SampleWetness(FVector(Random.FRandRange(0.f, MapSize), Random.FRandRange(0.f, MapSize), 0.f));
+	}
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	TestTrue(TEXT("Samples in range"), WetnessSum >= 0.f && WetnessSum <= NumSamples);
+	AddInfo(FString::Printf(TEXT("SampleWetness : %.1f ns per sample"), ElapsedTime * 1e9 / NumSamples));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GlideFlightModel.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GlideFlightModelTests
+{
+	static const float GravityZ = -980.f;
+	static const FVector StartVelocity(1000.f, 0.f, -100.f);
+	static const FVector AirVelocity(0.f, 100.f, 50.f);
+
+	/** Glides Duration seconds at FrameTime, banking toward TargetBankAngle for the first half */
+	static FVector SimulateGlide(const FGlideFlightModel& Model, float FrameTime, float Duration, float TargetBankAngle, FVector& OutLocation)
+	{
+		FVector Velocity = StartVelocity;
+		OutLocation = FVector(0.f, 0.f, 0.f);
+		float BankAngle = 0.f;
+		float BankStepTime = 0.f;
+
+		const int32 NumFrames = FMath::RoundToInt(Duration / FrameTime);
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const float Target = Frame < NumFrames / 2 ? TargetBankAngle : 0.f;
+			const FVector NewVelocity = Model.Integrate(Velocity, AirVelocity, BankAngle, BankStepTime, Target, GravityZ, FrameTime);
+			OutLocation += (Velocity + NewVelocity) * (0.5f * FrameTime);
+			Velocity = NewVelocity;
+		}
+
+		return Velocity;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGlideFlightModelFrameRateTest, "Second.Gliding.FlightModel.FrameRateIndependence",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGlideFlightModelFrameRateTest::RunTest(const FString& Parameters)
+{
+	using namespace GlideFlightModelTests;
+
+	const FGlideFlightModel Model;
+	FVector ReferenceLocation;
+	const FVector ReferenceVelocity = SimulateGlide(Model, 1.f / 240.f, 10.f, 30.f, ReferenceLocation);
+
+	// A banked turn and its roll out, at frame rates that cut the bank steps differently
+	const float FrameTimes[] = { 1.f / 30.f, 1.f / 60.f, 1.f / 144.f };
+	for (const float FrameTime : FrameTimes)
+	{
+		FVector Location;
+		const FVector Velocity = SimulateGlide(Model, FrameTime, 10.f, 30.f, Location);
+		TestTrue(FString::Printf(TEXT("Velocity at %.0f Hz matches 240 Hz"), 1.f / FrameTime), Velocity.Equals(ReferenceVelocity, 1.f));
+		TestTrue(FString::Printf(TEXT("Location at %.0f Hz matches 240 Hz"), 1.f / FrameTime), Location.Equals(ReferenceLocation, 10.f));
+	}
+
+	// Banking has to turn the flight path, not only roll the glider. One second of bank stays well below a half turn
+	FVector LevelLocation;
+	FVector TurnedLocation;
+	const FVector LevelVelocity = SimulateGlide(Model, 1.f / 60.f, 2.f, 0.f, LevelLocation);
+	const FVector TurnedVelocity = SimulateGlide(Model, 1.f / 60.f, 2.f, 30.f, TurnedLocation);
+	const float LevelHeading = FVector(LevelVelocity - AirVelocity).HeadingAngle();
+	const float TurnedHeading = FVector(TurnedVelocity - AirVelocity).HeadingAngle();
+	TestTrue(TEXT("Right bank turns right"), FMath::FindDeltaAngleRadians(LevelHeading, TurnedHeading) > 0.2f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGlideFlightModelClosedFormTest, "Second.Gliding.FlightModel.ClosedFormAccuracy",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGlideFlightModelClosedFormTest::RunTest(const FString& Parameters)
+{
+	using namespace GlideFlightModelTests;
+
+	const FGlideFlightModel Model;
+	const float BankAngles[] = { 0.f, 20.f, -35.f };
+	for (const float BankAngle : BankAngles)
+	{
+		// Explicit Euler on the model's differential equations in double, small enough steps to be the reference
+		const double SinkDrag = Model.GetSinkDragCoefficient(GravityZ);
+		const double EffectiveGravityZ = GravityZ * (1.0 - Model.LiftCoefficient * FMath::Cos(FMath::DegreesToRadians((double)BankAngle)));
+		const double TurnAcceleration = FMath::Abs(GravityZ) * FMath::Tan(FMath::DegreesToRadians((double)BankAngle));
+		double VX = StartVelocity.X - AirVelocity.X;
+		double VY = StartVelocity.Y - AirVelocity.Y;
+		double VZ = StartVelocity.Z;
+
+		const double StepTime = 1e-5;
+		for (int32 Step = 0; Step < 300000; ++Step)
+		{
+			const double Airspeed = FMath::Sqrt(VX * VX + VY * VY);
+			const double TurnRate = TurnAcceleration / Airspeed;
+			const double DX = -Model.DragCoefficient * VX - TurnRate * VY;
+			const double DY = -Model.DragCoefficient * VY + TurnRate * VX;
+			VZ += (EffectiveGravityZ - SinkDrag * (VZ - AirVelocity.Z)) * StepTime;
+			VX += DX * StepTime;
+			VY += DY * StepTime;
+		}
+
+		const FVector Expected(AirVelocity.X + VX, AirVelocity.Y + VY, VZ);
+		const FVector ClosedForm = Model.IntegrateClosedForm(StartVelocity, AirVelocity, BankAngle, GravityZ, 3.f);
+		TestTrue(FString::Printf(TEXT("Closed form at %.0f degrees bank matches the reference"), BankAngle), ClosedForm.Equals(Expected, 1.f));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGlideFlightModelBenchmark, "Second.Gliding.FlightModel.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FGlideFlightModelBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace GlideFlightModelTests;
+
+	const FGlideFlightModel Model;
+	const int32 NumCalls = 1000000;
+	const float FrameTime = 1.f / 60.f;
+
+	// Level flight takes the closed form fast path, banking steps the bank 2 times a frame at 60 Hz
+	const float TargetBankAngles[] = { 0.f, 30.f };
+	for (const float TargetBankAngle : TargetBankAngles)
+	{
+		FVector Velocity = StartVelocity;
+		float BankAngle = 0.f;
+		float BankStepTime = 0.f;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			// Alternate the turn so the bank keeps changing
+			const float Target = (Call / 120) % 2 == 0 ? TargetBankAngle : -TargetBankAngle;
+			Velocity = Model.Integrate(Velocity, AirVelocity, BankAngle, BankStepTime, Target, GravityZ, FrameTime);
+		}
+		const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+		TestFalse(TEXT("Velocity stays finite"), Velocity.ContainsNaN());
+		AddInfo(FString::Printf(TEXT("Integrate, %.0f degrees bank : %.1f ns per 60 Hz frame"), TargetBankAngle, ElapsedTime * 1e9 / NumCalls));
+	}
+
+	return true;
+}
+
+#endif
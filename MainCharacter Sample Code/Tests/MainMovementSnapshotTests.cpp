@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MainMovementSnapshot.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMainMovementSnapshotRoundTripTest, "Second.Movement.Snapshot.RoundTrip",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMainMovementSnapshotRoundTripTest::RunTest(const FString& Parameters)
+{
+	FMainMovementSnapshot Snapshot;
+	Snapshot.Location = FVector(1250000.f, -340.5f, 72.25f);
+	Snapshot.Rotation = FRotator(0.f, 91.5f, 0.f);
+	Snapshot.Velocity = FVector(0.f, 120.f, -980.f);
+	Snapshot.GlideBankAngle = -12.5f;
+	Snapshot.GlideBankStepTime = 0.004f;
+	Snapshot.NormalVectorBodyWallFacing = FVector(-1.f, 0.f, 0.f);
+	Snapshot.ClimbProbeDeltaTime = 0.033f;
+	Snapshot.WetSlipAge = 2.5f;
+	Snapshot.CurrentStamina = 61.f;
+	Snapshot.bIsGliding = false;
+	Snapshot.bIsBracing = true;
+	Snapshot.bIsRightEdge = true;
+	Snapshot.bIsStaminaFilledFull = true;
+	Snapshot.MovementMode = 6;
+	Snapshot.CustomMovementMode = 1;
+	Snapshot.ClimbStatus = 3;
+
+	TArray<uint8> Bytes;
+	Snapshot.SaveToBytes(Bytes);
+
+	FMainMovementSnapshot LoadedSnapshot;
+	TestTrue(TEXT("Snapshot loads"), LoadedSnapshot.LoadFromBytes(Bytes));
+	TestEqual(TEXT("Loaded snapshot is the same memory"), FMemory::Memcmp(&Snapshot, &LoadedSnapshot, sizeof(FMainMovementSnapshot)), 0);
+	TestTrue(TEXT("Location kept exactly"), LoadedSnapshot.Location == Snapshot.Location);
+	TestTrue(TEXT("Flag bits kept"), LoadedSnapshot.bIsBracing && LoadedSnapshot.bIsRightEdge && !LoadedSnapshot.bIsGliding);
+
+	// Same state, same bytes : rollback compares snapshots by their bytes
+	TArray<uint8> SavedAgainBytes;
+	LoadedSnapshot.SaveToBytes(SavedAgainBytes);
+	TestTrue(TEXT("Saving the loaded snapshot gives the same bytes"), Bytes == SavedAgainBytes);
+
+	TArray<uint8> DefaultBytes;
+	TArray<uint8> OtherDefaultBytes;
+	FMainMovementSnapshot().SaveToBytes(DefaultBytes);
+	FMainMovementSnapshot().SaveToBytes(OtherDefaultBytes);
+	TestTrue(TEXT("Default snapshots give the same bytes"), DefaultBytes == OtherDefaultBytes);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMainMovementSnapshotRefuseTest, "Second.Movement.Snapshot.RefuseMismatch",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMainMovementSnapshotRefuseTest::RunTest(const FString& Parameters)
+{
+	FMainMovementSnapshot Snapshot;
+	Snapshot.CurrentStamina = 42.f;
+
+	TArray<uint8> Bytes;
+	Snapshot.SaveToBytes(Bytes);
+
+	// Header is Magic, Version, then the struct size, each a uint32
+	const int32 HeaderOffsets[] = { 0, 4, 8 };
+	for (const int32 HeaderOffset : HeaderOffsets)
+	{
+		TArray<uint8> BadBytes = Bytes;
+		BadBytes[HeaderOffset] ^= 0xFF;
+
+		FMainMovementSnapshot LoadedSnapshot;
+		TestFalse(FString::Printf(TEXT("Header byte %d changed is refused"), HeaderOffset), LoadedSnapshot.LoadFromBytes(BadBytes));
+	}
+
+	TArray<uint8> TruncatedBytes = Bytes;
+	TruncatedBytes.SetNum(Bytes.Num() - 1);
+	FMainMovementSnapshot TruncatedSnapshot;
+	TestFalse(TEXT("Truncated snapshot is refused"), TruncatedSnapshot.LoadFromBytes(TruncatedBytes));
+
+	TestFalse(TEXT("Empty bytes are refused"), FMainMovementSnapshot().LoadFromBytes(TArray<uint8>()));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Main.h"
+#include "ClimbBenchmarkWorld.h"
+#include "MainMovementSnapshot.h"
+#include "Misc/AutomationTest.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MainRollbackTests
+{
+	static const float FrameDeltaTime = 1.f / 60.f;
+
+	/** Frames of BeforeTick input. The engine loop advances GFrameCounter, a rollback frame opens once per counter value */
+	static void TickFrames(FClimbBenchmarkWorld& BenchmarkWorld, int32 NumFrames, TFunctionRef<void()> BeforeTick)
+	{
+		TArray<double> FrameTimes;
+		BenchmarkWorld.Tick(NumFrames, FrameDeltaTime, FrameTimes, [&BeforeTick]()
+			{
+				++GFrameCounter;
+				BeforeTick();
+			});
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMainRollbackResimulateTest, "Second.Movement.Rollback.ResimulateUnchangedInput",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMainRollbackResimulateTest::RunTest(const FString& Parameters)
+{
+	using namespace MainRollbackTests;
+
+	FClimbBenchmarkWorld BenchmarkWorld;
+	BenchmarkWorld.AddCube(FVector(0.f, 0.f, -50.f), FVector(4000.f, 4000.f, 100.f));
+	BenchmarkWorld.AddCube(FVector(200.f, 0.f, 500.f), FVector(100.f, 600.f, 1000.f));
+
+	AMain* Main = Cast<AMain>(BenchmarkWorld.SpawnCharacter(FVector(0.f, 0.f, 100.f), FRotator::ZeroRotator));
+	if (!TestNotNull(TEXT("Character spawned"), Main))
+	{
+		return false;
+	}
+	UClimbingComponent* Climbing = Main->GetClimbingComponent();
+
+	// The ring reaches back past the wall jump below
+	Main->bRollbackEnabled = true;
+	Main->MaxRollbackFrames = 16;
+	Main->RollbackFrames.SetNum(Main->MaxRollbackFrames);
+
+	TickFrames(BenchmarkWorld, 60, [Main]() { Main->MoveForward(1.f); });
+	if (!TestEqual(TEXT("Climbing the wall"), (int32)Climbing->GetMovementStatus(), (int32)EMovementStatus::EMS_Climbing))
+	{
+		return false;
+	}
+
+	// Braced wall jump, rolled back while its low gravity deadline is still pending
+	TickFrames(BenchmarkWorld, 1, [Main]() { Main->QKeyPressed(); Main->SpaceBarPressed(); });
+	TickFrames(BenchmarkWorld, 1, [Main]() { Main->SpaceBarReleased(); });
+	TickFrames(BenchmarkWorld, 4, []() {});
+	TestEqual(TEXT("Wall jumping"), (int32)Climbing->GetMovementStatus(), (int32)EMovementStatus::EMS_WallJumping);
+	TestTrue(TEXT("Wall jump gravity deadline pending"), Climbing->WallJumpGravityEndTime > Climbing->GetClimbTime());
+
+	FMainMovementSnapshot PresentState;
+	FClimbRollbackState PresentClimbState;
+	Main->CaptureMovementSnapshot(PresentState);
+	Climbing->CaptureRollbackState(PresentClimbState);
+	const float PresentClimbTime = Climbing->GetClimbTime();
+
+	// Same input from the oldest frame on
+	const FMainRollbackFrame& OldestFrame = Main->GetRollbackFrame(0);
+	const TArray<FMainInputEvent> Events = OldestFrame.Events;
+	if (!TestTrue(TEXT("Rollback re-simulates"), Main->CorrectRollbackInput(OldestFrame.FrameIndex, Events)))
+	{
+		return false;
+	}
+
+	FMainMovementSnapshot ResimulatedState;
+	FClimbRollbackState ResimulatedClimbState;
+	Main->CaptureMovementSnapshot(ResimulatedState);
+	Climbing->CaptureRollbackState(ResimulatedClimbState);
+
+	TestEqual(TEXT("Climb clock"), Climbing->GetClimbTime(), PresentClimbTime);
+	TestEqual(TEXT("Movement status"), (int32)ResimulatedState.MovementStatus, (int32)PresentState.MovementStatus);
+	TestEqual(TEXT("Climb status"), (int32)ResimulatedState.ClimbStatus, (int32)PresentState.ClimbStatus);
+	TestEqual(TEXT("Movement mode"), (int32)ResimulatedState.MovementMode, (int32)PresentState.MovementMode);
+	TestTrue(TEXT("Location"), ResimulatedState.Location.Equals(PresentState.Location, 0.1f));
+	TestTrue(TEXT("Velocity"), ResimulatedState.Velocity.Equals(PresentState.Velocity, 0.1f));
+	TestEqual(TEXT("Gravity scale"), ResimulatedState.GravityScale, PresentState.GravityScale);
+	TestTrue(TEXT("Can grab wall"), ResimulatedState.bIsCanGrabWall == PresentState.bIsCanGrabWall);
+	TestTrue(TEXT("Dashing"), ResimulatedState.bIsLeftDashing == PresentState.bIsLeftDashing && ResimulatedState.bIsRightDashing == PresentState.bIsRightDashing);
+
+	TestEqual(TEXT("Wall jump gravity deadline"), ResimulatedClimbState.WallJumpGravityEndTime, PresentClimbState.WallJumpGravityEndTime);
+	TestEqual(TEXT("Climb down grab deadline"), ResimulatedClimbState.ClimbDownGrabTime, PresentClimbState.ClimbDownGrabTime);
+	TestEqual(TEXT("Front flip deadline"), ResimulatedClimbState.FrontFlipEndTime, PresentClimbState.FrontFlipEndTime);
+	TestTrue(TEXT("Montage"), ResimulatedClimbState.Montage == PresentClimbState.Montage);
+	TestEqual(TEXT("Montage position"), ResimulatedClimbState.MontagePosition, PresentClimbState.MontagePosition, KINDA_SMALL_NUMBER);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Main.h"
+#include "ClimbingComponent.h"
+#include "ClimbNavLinkGenerator.h"
+#include "ClimbNavLinkComponent.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOriginRebaseRoundTripTest, "Second.World.OriginRebase.RoundTrip",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOriginRebaseRoundTripTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	// Non scene components only move when their actor hands them the offset
+	const FVector StartLocation(100.f, 200.f, 300.f);
+	const FVector WallContact(150.f, 200.f, 320.f);
+	const float ClimbDownTargetZ = 250.f;
+	AMain* Main = World->SpawnActor<AMain>(StartLocation, FRotator::ZeroRotator);
+	UClimbingComponent* Climbing = Main->GetClimbingComponent();
+	Climbing->BodyWallContactPoint = WallContact;
+	Climbing->ClimbDownTargetZ = ClimbDownTargetZ;
+
+	const FVector LinkLeft(0.f, -100.f, 0.f);
+	const FVector LinkRight(0.f, 100.f, 600.f);
+	AClimbNavLinkGenerator* Generator = World->SpawnActor<AClimbNavLinkGenerator>();
+	UClimbNavLinkComponent* LinkComponent = NewObject<UClimbNavLinkComponent>(Generator);
+	Generator->AddInstanceComponent(LinkComponent);
+	LinkComponent->RegisterComponent();
+	TArray<FNavigationLink> Links;
+	Links.Add(FNavigationLink(LinkLeft, LinkRight));
+	LinkComponent->SetLinks(MoveTemp(Links), 1);
+
+	// Out to 20 km each way and back, a float keeps 1/8 cm there
+	const float Tolerance = 0.25f;
+	const FIntVector Origins[] = { FIntVector(2000000, 0, 0), FIntVector(-2000000, 0, 0), FIntVector(0, 2000000, 0), FIntVector(0, -2000000, 0), FIntVector(0, 0, -2000000), FIntVector(1414214, -1414214, 0) };
+	for (const FIntVector& Origin : Origins)
+	{
+		const FVector Shift(Origin);
+		const FString OriginText = Origin.ToString();
+
+		TestTrue(TEXT("Origin rebased"), World->SetNewWorldOrigin(Origin));
+		TestTrue(FString::Printf(TEXT("Character shifted, origin %s"), *OriginText), Main->GetActorLocation().Equals(StartLocation - Shift, Tolerance));
+		TestTrue(FString::Printf(TEXT("Wall contact shifted, origin %s"), *OriginText), Climbing->BodyWallContactPoint.Equals(WallContact - Shift, Tolerance));
+		TestTrue(FString::Printf(TEXT("Climb down target shifted, origin %s"), *OriginText), FMath::IsNearlyEqual(Climbing->ClimbDownTargetZ, ClimbDownTargetZ - Shift.Z, Tolerance));
+		TestTrue(FString::Printf(TEXT("Nav link shifted, origin %s"), *OriginText), LinkComponent->Links[0].Left.Equals(LinkLeft - Shift, Tolerance) && LinkComponent->Links[0].Right.Equals(LinkRight - Shift, Tolerance));
+
+		TestTrue(TEXT("Origin back"), World->SetNewWorldOrigin(FIntVector(0, 0, 0)));
+		TestTrue(FString::Printf(TEXT("Character back, origin %s"), *OriginText), Main->GetActorLocation().Equals(StartLocation, Tolerance));
+		TestTrue(FString::Printf(TEXT("Wall contact back, origin %s"), *OriginText), Climbing->BodyWallContactPoint.Equals(WallContact, Tolerance));
+		TestTrue(FString::Printf(TEXT("Climb down target back, origin %s"), *OriginText), FMath::IsNearlyEqual(Climbing->ClimbDownTargetZ, ClimbDownTargetZ, Tolerance));
+		TestTrue(FString::Printf(TEXT("Nav link back, origin %s"), *OriginText), LinkComponent->Links[0].Left.Equals(LinkLeft, Tolerance) && LinkComponent->Links[0].Right.Equals(LinkRight, Tolerance));
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WeatherVolume.h"
+#include "ClimbWetnessSubsystem.h"
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+
+AWeatherVolume::AWeatherVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RainBox = CreateDefaultSubobject<UBoxComponent>(TEXT("RainBox"));
+	RainBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	RainBox->SetMobility(EComponentMobility::Static);
+	SetRootComponent(RainBox);
+
+	WettingRate = 1.f / 60.f;
+	bIsRaining = false;
+	RegisteredVolumeIndex = INDEX_NONE;
+}
+
+void AWeatherVolume::SetRaining(bool bRaining)
+{
+	bIsRaining = bRaining;
+
+	if (UClimbWetnessSubsystem* WetnessSubsystem = GetWorld()->GetSubsystem<UClimbWetnessSubsystem>())
+	{
+		WetnessSubsystem->SetVolumeRaining(RegisteredVolumeIndex, bIsRaining);
+	}
+}
+
+void AWeatherVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UClimbWetnessSubsystem* WetnessSubsystem = GetWorld()->GetSubsystem<UClimbWetnessSubsystem>())
+	{
+		RegisteredVolumeIndex = WetnessSubsystem->RegisterVolume(RainBox->Bounds.GetBox(), WettingRate, bIsRaining);
+	}
+}
+
+void AWeatherVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UClimbWetnessSubsystem* WetnessSubsystem = GetWorld()->GetSubsystem<UClimbWetnessSubsystem>())
+	{
+		WetnessSubsystem->UnregisterVolume(RegisteredVolumeIndex);
+	}
+	RegisteredVolumeIndex = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
+}
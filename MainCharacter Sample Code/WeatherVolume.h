@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "WeatherVolume.generated.h"
+
+/**
+ * Rain area wetting the walls under its box footprint while it rains.
+ * Registered in the world's UClimbWetnessSubsystem grid, the weather system only toggles SetRaining.
+ */
+UCLASS()
+class SECOND_API AWeatherVolume : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AWeatherVolume();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weather")
+	class UBoxComponent* RainBox;
+
+	/** Wetness per second while it rains, 1 / seconds until the walls are soaked */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weather")
+	float WettingRate;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Weather")
+	bool bIsRaining;
+
+	UFUNCTION(BlueprintCallable)
+	void SetRaining(bool bRaining);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	int32 RegisteredVolumeIndex;
+};